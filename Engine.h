@@ -1,10 +1,14 @@
 #ifndef __ENGINE_H__
 #define __ENGINE_H__
 
+#include "Engine_ActionMap.h"
 #include "Engine_Animation.h"
 #include "Engine_Application.h"
+#include "Engine_AudioDevice.h"
 #include "Engine_BasicGameObject.h"
+#include "Engine_Collision.h"
 #include "Engine_Color.h"
+#include "Engine_Coroutine.h"
 #include "Engine_Define.h"
 #include "Engine_Enum.h"
 #include "Engine_Event.h"
@@ -14,12 +18,22 @@
 #include "Engine_Helper.h"
 #include "Engine_Imaging.h"
 #include "Engine_Input.h"
+#include "Engine_InputRecorder.h"
+#include "Engine_KeyframeAnimation.h"
 #include "Engine_Keycode.h"
 #include "Engine_Math.h"
+#include "Engine_MusicPlaylist.h"
+#include "Engine_ParticleSystem.h"
+#include "Engine_Pathfinding.h"
+#include "Engine_Physics.h"
 #include "Engine_Renderer.h"
 #include "Engine_Resource.h"
 #include "Engine_Sound.h"
+#include "Engine_SoundMixer.h"
 #include "Engine_Structure.h"
+#include "Engine_Tilemap.h"
+#include "Engine_Timer.h"
+#include "Engine_Tween.h"
 #include "Engine_UIGameObject.h"
 #include "Engine_Window.h"
 
@@ -43,8 +57,11 @@ namespace Engine {
             return false;
         if (Mix_Init(MIX_INIT_MP3 | MIX_INIT_OGG) != (MIX_INIT_MP3 | MIX_INIT_OGG))
             return false;
-        if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 4096) != 0)
+        if (!AudioDevice::Open())
             return false;
+        Sound::SetChannelCount(ENGINE_DEFAULT_SOUND_CHANNEL_COUNT);
+        // The Sound Mixer is optional, as it require a stereo audio device.
+        SoundMixer::Initialize();
         
         if (!Window::Initialize())
             return false;
@@ -60,13 +77,25 @@ namespace Engine {
     /// @brief Deinitialize the Engine. After calling this, you must reinitialize the Engine before using
     /// it again.
     void Deinitialize() {
+        //* Input
+        InputRecorder::Deinitialize();
+
         //* Animation
+        Tween::CancelAll();
         AnimationScript::DestroyAllCreatedScripts();
+        AnimationClip::DestroyAllCreatedClips();
 
         //* Game Object / Game Scene
+        Pathfinding::Deinitialize();
+        Physics::Deinitialize();
+        Collision::RemoveAllColliders();
         GameObject::DestoryAllCreatedGameObjects();
         GameScene::Deinitialize();
 
+        //* Timer
+        // Cancelled last, the stop actions of the scripts destroyed above may still schedule timers.
+        Timer::CancelAll();
+
         //* Font
         Font::DestroyAllCreatedFonts();
 
@@ -78,7 +107,14 @@ namespace Engine {
         Renderer::Deinitialize();
         Window::Deinitialize();
 
-        Mix_CloseAudio();
+        //* Sound / Music
+        Sound::DestroyAllCreatedSounds();
+        Music::DestroyAllCreatedMusics();
+        Sound::SetChannelCount(0);
+        MusicPlaylist::Deinitialize();
+        SoundMixer::Deinitialize();
+
+        AudioDevice::Close();
         SDL_Quit(); IMG_Quit(); TTF_Quit(); Mix_Quit();
     }
 }
@@ -100,40 +136,63 @@ void Engine::Application::Start() {
         
         Application::EarlyUpdateEvent.Call();
 
+        // Start or stop the recording and replaying requested in the last frame, before the events are pumped.
+        InputRecorder::BeginFrame();
         // Handle the Window event.
         Application::HandleWindowEvent();
+        // Capture the input state of this frame, after the event queue is pumped.
+        Input::Capture();
+        InputRecorder::ProcessSnapshot();
+        ActionMap::EvaluateAllCreatedActionMaps();
 
         // Check the availability of the Window again (in case the Window became not available after handle event).
         if (!Window::IsInitialized())
             break;
         
+        // Deliver the async path results before the Game Scene request new ones.
+        Pathfinding::Update();
+        // Call the expired timers (and start the delayed animations).
+        Timer::Update((double)Application::GetDeltaTime());
         Application::UpdateEvent.Call();
+        // Advance all tweens before updating the Game Scene.
+        Tween::UpdateAll((double)Application::GetDeltaTime());
+        // Step the physics at its fixed time step, before the Game Scene read the positions.
+        Physics::Update((double)Application::GetDeltaTime());
 
         if (GameScene::IsInitialized() && Application::RenderingScene) {
+            // The headless replay update the Game Scene without rendering.
+            bool is_headless = InputRecorder::IsHeadless();
             GameScene* curr_scene = GameScene::GetCurrentScene();
-            Renderer::SetDrawColor(curr_scene->BackgroundColor);
-            Renderer::Clear();
-            if (curr_scene->BackgroundTexture)
-                Renderer::FillTexture(curr_scene->BackgroundTexture);
+            if (!is_headless) {
+                Renderer::SetDrawColor(curr_scene->BackgroundColor);
+                Renderer::Clear();
+                if (curr_scene->BackgroundTexture)
+                    Renderer::FillTexture(curr_scene->BackgroundTexture);
+            }
 
-            curr_scene->ForEach([](GameObject* obj) {
+            curr_scene->ForEach([is_headless](GameObject* obj) {
                 if (!obj->Enabled) return;
 
                 obj->RaiseUpdateEvent(true);
+                if (is_headless) return;
 
                 RenderEventArgs render_args;
                 render_args.TargetArea = Rectangle(Point::Zero, Window::GetSize()).LocalToGlobal(obj->GetArea(), obj->Alignment);
                 obj->RaiseRenderEvent(&render_args, true);
             });
-            Renderer::Present();
+            if (!is_headless)
+                Renderer::Present();
         }
+        // Detect the collisions after the Game Scene moved.
+        Collision::Update();
 
         Application::LateUpdateEvent.Call();
 
-        if (Application::__update_wait_time >= ENGINE_MIN_WAIT_TIME_PER_UPDATE)
+        if (Application::__update_wait_time >= ENGINE_MIN_WAIT_TIME_PER_UPDATE && !InputRecorder::IsHeadless())
             SDL_Delay((int)(Application::__update_wait_time * 1000));
 
-        Application::__delta_time = 1E-9L * (std::chrono::steady_clock::now() - start).count();
+        // While replaying, the recorded delta time is used instead of the measured one.
+        Application::__delta_time = InputRecorder::EndFrame(1E-9L * (std::chrono::steady_clock::now() - start).count());
     }
     Application::__is_running = false;
     Application::__is_exiting = true;
@@ -147,7 +206,9 @@ void Engine::Application::Start() {
 size_t Engine::Application::HandleWindowEvent() {
     SDL_Event e;
     size_t count = 0;
-    while (SDL_PollEvent(&e) != 0) {
+    Input::SyncClock();
+    InputBuffer::BeginFrame();
+    while (InputRecorder::PollEvent(&e) != 0) {
         // Check the availability of the Window.
         if (!Window::IsInitialized())
             continue;
@@ -211,6 +272,9 @@ size_t Engine::Application::HandleWindowEvent() {
             }
             break;
         }
+        case SDL_KEYMAPCHANGED:
+            Input::RefreshKeyMap();
+            break;
         case SDL_KEYDOWN: {
             // Check if it's an event for the Window.
             if (!Application::HandleInput)
@@ -220,6 +284,7 @@ size_t Engine::Application::HandleWindowEvent() {
 
             count++;
             KeyEventArgs key_args = KeyEventArgs::FromSDLKeyboardEvent(e.key);
+            InputBuffer::Push(key_args);
             Window::KeyDownEvent.Call(&key_args);
 
             if (GameScene::IsInitialized()) {
@@ -241,6 +306,7 @@ size_t Engine::Application::HandleWindowEvent() {
 
             count++;
             KeyEventArgs key_args = KeyEventArgs::FromSDLKeyboardEvent(e.key);
+            InputBuffer::Push(key_args);
             Window::KeyUpEvent.Call(&key_args);
 
             if (GameScene::IsInitialized()) {
@@ -252,6 +318,46 @@ size_t Engine::Application::HandleWindowEvent() {
             }
             break;
         }
+        case SDL_TEXTINPUT: {
+            // Check if it's an event for the Window.
+            if (!Application::HandleInput)
+                break;
+            if (e.text.windowID != window_id)
+                break;
+
+            count++;
+            TextInputEventArgs text_args = TextInputEventArgs::FromSDLTextInputEvent(e.text);
+            Window::TextInputEvent.Call(&text_args);
+
+            if (GameScene::IsInitialized()) {
+                GameScene* curr_scene = GameScene::GetCurrentScene();
+                curr_scene->ForEach([&text_args](GameObject* obj) {
+                    if (!obj->Enabled || !obj->HandleInput) return;
+                    obj->RaiseTextInputEvent(&text_args, true);
+                });
+            }
+            break;
+        }
+        case SDL_TEXTEDITING: {
+            // Check if it's an event for the Window.
+            if (!Application::HandleInput)
+                break;
+            if (e.edit.windowID != window_id)
+                break;
+
+            count++;
+            TextEditingEventArgs edit_args = TextEditingEventArgs::FromSDLTextEditingEvent(e.edit);
+            Window::TextEditingEvent.Call(&edit_args);
+
+            if (GameScene::IsInitialized()) {
+                GameScene* curr_scene = GameScene::GetCurrentScene();
+                curr_scene->ForEach([&edit_args](GameObject* obj) {
+                    if (!obj->Enabled || !obj->HandleInput) return;
+                    obj->RaiseTextEditingEvent(&edit_args, true);
+                });
+            }
+            break;
+        }
         case SDL_MOUSEBUTTONDOWN: {
             // Check if it's an event for the Window.
             if (!Application::HandleInput)
@@ -261,6 +367,7 @@ size_t Engine::Application::HandleWindowEvent() {
 
             count++;
             MouseButtonEventArgs button_args = MouseButtonEventArgs::FromSDLMouseButtonEvent(e.button);
+            InputBuffer::Push(button_args);
             Window::MouseDownEvent.Call(&button_args);
 
             if (GameScene::IsInitialized()) {
@@ -287,6 +394,7 @@ size_t Engine::Application::HandleWindowEvent() {
 
             count++;
             MouseButtonEventArgs button_args = MouseButtonEventArgs::FromSDLMouseButtonEvent(e.button);
+            InputBuffer::Push(button_args);
             Window::MouseUpEvent.Call(&button_args);
 
             if (GameScene::IsInitialized()) {
@@ -312,6 +420,7 @@ size_t Engine::Application::HandleWindowEvent() {
 
             count++;
             MouseWheelEventArgs wheel_args = MouseWheelEventArgs::FromSDLMouseWheelEvent(e.wheel);
+            InputBuffer::Push(wheel_args);
             Window::MouseScrollEvent.Call(&wheel_args);
 
             if (GameScene::IsInitialized()) {
@@ -332,6 +441,7 @@ size_t Engine::Application::HandleWindowEvent() {
 
             count++;
             MouseMotionEventArgs motion_args = MouseMotionEventArgs::FromSDLMouseMotionEvent(e.motion);
+            InputBuffer::Push(motion_args);
             Window::MouseMovedEvent.Call(&motion_args);
 
             if (GameScene::IsInitialized()) {
@@ -0,0 +1,264 @@
+#ifndef __ENGINE_ACTIONMAP_H__
+#define __ENGINE_ACTIONMAP_H__
+
+#include "Engine_Define.h"
+#include "Engine_Enum.h"
+#include "Engine_Input.h"
+#include "Engine_Keycode.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace Engine {
+    /// @brief The Action Map class, map named actions and axes to keys, mouse buttons and modifiers. The bindings are
+    /// compiled into a dense table sorted by input, and all actions and axes are evaluated in one pass over the input
+    /// snapshot of the frame. All created Action Maps are evaluated by Application::Start() after capturing the input.
+    /// Actions and axes are queried by the ID returned from AddAction() and AddAxis().
+    class ActionMap {
+    private:
+        // The input index is the Scancode for keys, and SDL_NUM_SCANCODES + (button - 1) for mouse buttons.
+        struct __binding {
+            uint16_t input = 0;
+            uint16_t modifiers = 0;
+            uint16_t target = 0;
+            bool is_axis = false;
+            float scale = 1.0f;
+        };
+
+        std::vector<std::string> __action_names, __axis_names;
+        std::vector<__binding> __bindings;
+        std::vector<__binding> __compiled;
+        bool __is_compiled = true;
+
+        std::vector<uint8_t> __down, __previous_down;
+        std::vector<float> __axes;
+
+        static std::unordered_set<ActionMap*> __created_action_maps;
+
+        /// @brief Check if the given input is down in the given snapshot.
+        static bool __is_input_down(const InputSnapshot& snapshot, uint16_t input) {
+            if (input < SDL_NUM_SCANCODES) return (snapshot.Keys[input >> 6] >> (input & 63)) & 1;
+            return (snapshot.MouseButtons >> (input - SDL_NUM_SCANCODES)) & 1;
+        }
+        /// @brief Check if the current modifiers satisfy the required modifiers. For each modifier group (Shift, Ctrl, Alt
+        /// and GUI) that required, one of the required keys of the group must be down.
+        static bool __is_modifiers_matched(uint16_t current, uint16_t required) {
+            static const uint16_t groups[] = {
+                (uint16_t)KeyModifier::Shift, (uint16_t)KeyModifier::Ctrl, (uint16_t)KeyModifier::Alt, (uint16_t)KeyModifier::GUI,
+                (uint16_t)KeyModifier::NumLock, (uint16_t)KeyModifier::Capslock, (uint16_t)KeyModifier::Mode, (uint16_t)KeyModifier::Scroll
+            };
+            for (uint16_t group : groups)
+                if ((required & group) && !(current & required & group)) return false;
+            return true;
+        }
+        /// @brief Add a binding to the given target.
+        bool __bind(int target, bool is_axis, uint16_t input, KeyModifier modifiers, float scale) {
+            size_t count = is_axis ? __axis_names.size() : __action_names.size();
+            if (target < 0 || (size_t)target >= count) return false;
+            __binding binding;
+            binding.input = input;
+            binding.modifiers = (uint16_t)modifiers;
+            binding.target = (uint16_t)target;
+            binding.is_axis = is_axis;
+            binding.scale = scale;
+            __bindings.push_back(binding);
+            __is_compiled = false;
+            return true;
+        }
+        /// @brief Remove all bindings of the given target.
+        void __unbind(int target, bool is_axis) {
+            __bindings.erase(std::remove_if(__bindings.begin(), __bindings.end(), [&](const __binding& binding) {
+                return binding.is_axis == is_axis && binding.target == target;
+            }), __bindings.end());
+            __is_compiled = false;
+        }
+    public:
+        /// @brief If this false, all actions and axes are evaluated as released (and 0). Default is true.
+        bool Enabled = true;
+
+        ActionMap() { ActionMap::__created_action_maps.insert(this); }
+        virtual ~ActionMap() { ActionMap::__created_action_maps.erase(this); }
+
+        ENGINE_NOT_COPYABLE(ActionMap)
+        ENGINE_NOT_ASSIGNABLE(ActionMap)
+
+        /// @brief Add a new action to the Action Map.
+        /// @param name The name of the action.
+        /// @return The action ID, or the ID of the existing action with the given name.
+        int AddAction(const std::string& name) {
+            int action_id = FindAction(name);
+            if (action_id >= 0) return action_id;
+            __action_names.push_back(name);
+            __is_compiled = false;
+            return (int)__action_names.size() - 1;
+        }
+        /// @brief Add a new axis to the Action Map. The value of the axis is the sum of the scales of the bindings that down,
+        /// clamped to -1 and 1.
+        /// @param name The name of the axis.
+        /// @return The axis ID, or the ID of the existing axis with the given name.
+        int AddAxis(const std::string& name) {
+            int axis_id = FindAxis(name);
+            if (axis_id >= 0) return axis_id;
+            __axis_names.push_back(name);
+            __is_compiled = false;
+            return (int)__axis_names.size() - 1;
+        }
+        /// @brief Find the action with the given name.
+        /// @param name The name to find.
+        /// @return The action ID, or -1 if not found.
+        int FindAction(const std::string& name) const {
+            for (size_t i = 0; i < __action_names.size(); i++)
+                if (__action_names[i] == name) return (int)i;
+            return -1;
+        }
+        /// @brief Find the axis with the given name.
+        /// @param name The name to find.
+        /// @return The axis ID, or -1 if not found.
+        int FindAxis(const std::string& name) const {
+            for (size_t i = 0; i < __axis_names.size(); i++)
+                if (__axis_names[i] == name) return (int)i;
+            return -1;
+        }
+        /// @brief Get the number of actions of the Action Map.
+        /// @return The number of actions.
+        size_t GetActionCount() const { return __action_names.size(); }
+        /// @brief Get the number of axes of the Action Map.
+        /// @return The number of axes.
+        size_t GetAxisCount() const { return __axis_names.size(); }
+
+        /// @brief Bind a key to the given action.
+        /// @param action_id The action ID to bind.
+        /// @param scancode The Scancode of the key.
+        /// @param modifiers The modifier keys that must be down too. Default is KeyModifier::None.
+        /// @return true on success, false on failed (invalid action ID or Scancode).
+        bool BindKey(int action_id, Scancode scancode, KeyModifier modifiers = KeyModifier::None) {
+            if ((unsigned)scancode >= SDL_NUM_SCANCODES) return false;
+            return __bind(action_id, false, (uint16_t)scancode, modifiers, 1.0f);
+        }
+        /// @brief Bind a mouse button to the given action.
+        /// @param action_id The action ID to bind.
+        /// @param button The Mouse Button.
+        /// @param modifiers The modifier keys that must be down too. Default is KeyModifier::None.
+        /// @return true on success, false on failed (invalid action ID or Mouse Button).
+        bool BindMouseButton(int action_id, MouseButton button, KeyModifier modifiers = KeyModifier::None) {
+            if ((unsigned)button - 1 >= 32) return false;
+            return __bind(action_id, false, (uint16_t)(SDL_NUM_SCANCODES + (int)button - 1), modifiers, 1.0f);
+        }
+        /// @brief Bind a key to the given axis.
+        /// @param axis_id The axis ID to bind.
+        /// @param scancode The Scancode of the key.
+        /// @param scale The value added to the axis while the key is down (e.g. -1 for left, 1 for right).
+        /// @param modifiers The modifier keys that must be down too. Default is KeyModifier::None.
+        /// @return true on success, false on failed (invalid axis ID or Scancode).
+        bool BindAxisKey(int axis_id, Scancode scancode, float scale, KeyModifier modifiers = KeyModifier::None) {
+            if ((unsigned)scancode >= SDL_NUM_SCANCODES) return false;
+            return __bind(axis_id, true, (uint16_t)scancode, modifiers, scale);
+        }
+        /// @brief Bind a mouse button to the given axis.
+        /// @param axis_id The axis ID to bind.
+        /// @param button The Mouse Button.
+        /// @param scale The value added to the axis while the mouse button is down.
+        /// @param modifiers The modifier keys that must be down too. Default is KeyModifier::None.
+        /// @return true on success, false on failed (invalid axis ID or Mouse Button).
+        bool BindAxisMouseButton(int axis_id, MouseButton button, float scale, KeyModifier modifiers = KeyModifier::None) {
+            if ((unsigned)button - 1 >= 32) return false;
+            return __bind(axis_id, true, (uint16_t)(SDL_NUM_SCANCODES + (int)button - 1), modifiers, scale);
+        }
+        /// @brief Remove all bindings of the given action.
+        /// @param action_id The action ID to unbind.
+        void UnbindAction(int action_id) { __unbind(action_id, false); }
+        /// @brief Remove all bindings of the given axis.
+        /// @param axis_id The axis ID to unbind.
+        void UnbindAxis(int axis_id) { __unbind(axis_id, true); }
+        /// @brief Remove all bindings of the Action Map, the actions and axes are kept.
+        void UnbindAll() {
+            __bindings.clear();
+            __is_compiled = false;
+        }
+
+        /// @brief Compile the bindings into the dense table. This is done automatically on the next Evaluate() after the
+        /// bindings changed.
+        void Compile() {
+            __compiled = __bindings;
+            // Sorted by input, so the evaluation read the snapshot bitset in order.
+            std::stable_sort(__compiled.begin(), __compiled.end(), [](const __binding& a, const __binding& b) {
+                return a.input < b.input;
+            });
+            // The IDs are the indices and never change, so the state of the existing actions is kept (otherwise a held
+            // action would be pressed again, and a release on the next frame would be missed). New ones start released.
+            __down.resize(__action_names.size(), 0);
+            __previous_down.resize(__action_names.size(), 0);
+            __axes.resize(__axis_names.size(), 0.0f);
+            __is_compiled = true;
+        }
+        /// @brief Evaluate all actions and axes from the input snapshot of the current frame. This is called for all created
+        /// Action Maps by Application::Start().
+        void Evaluate() {
+            if (!__is_compiled) Compile();
+            __down.swap(__previous_down);
+            std::fill(__down.begin(), __down.end(), 0);
+            std::fill(__axes.begin(), __axes.end(), 0.0f);
+            if (!Enabled) return;
+
+            const InputSnapshot& snapshot = Input::GetSnapshot();
+            for (const __binding& binding : __compiled) {
+                if (!__is_input_down(snapshot, binding.input)) continue;
+                if (binding.modifiers && !__is_modifiers_matched(snapshot.Modifiers, binding.modifiers)) continue;
+                if (binding.is_axis) __axes[binding.target] += binding.scale;
+                else __down[binding.target] = 1;
+            }
+            for (float& value : __axes)
+                value = ENGINE_FAST_CLAMP(-1.0f, 1.0f, value);
+        }
+
+        /// @brief Check if the given action is down on the current frame.
+        /// @param action_id The action ID to check.
+        /// @return true if the action is down, false otherwise (or invalid action ID).
+        bool IsDown(int action_id) const {
+            return action_id >= 0 && (size_t)action_id < __down.size() && __down[action_id];
+        }
+        /// @brief Check if the given action went down on the current frame.
+        /// @param action_id The action ID to check.
+        /// @return true if the action went down on the current frame, false otherwise (or invalid action ID).
+        bool WasPressed(int action_id) const {
+            return IsDown(action_id) && !__previous_down[action_id];
+        }
+        /// @brief Check if the given action went up on the current frame.
+        /// @param action_id The action ID to check.
+        /// @return true if the action went up on the current frame, false otherwise (or invalid action ID).
+        bool WasReleased(int action_id) const {
+            return action_id >= 0 && (size_t)action_id < __down.size() && !__down[action_id] && __previous_down[action_id];
+        }
+        /// @brief Get the value of the given axis on the current frame.
+        /// @param axis_id The axis ID to get.
+        /// @return The value of the axis from -1 to 1, or 0 if invalid axis ID.
+        float GetAxis(int axis_id) const {
+            return (axis_id >= 0 && (size_t)axis_id < __axes.size()) ? __axes[axis_id] : 0.0f;
+        }
+
+        /// @brief Evaluate all created Action Maps. This is called by Application::Start() after capturing the input.
+        static void EvaluateAllCreatedActionMaps() {
+            for (ActionMap* map : ActionMap::__created_action_maps)
+                if (map) map->Evaluate();
+        }
+        /// @brief Execute an action for each created Action Map.
+        /// @param action The action to execute.
+        /// @return The number of Action Map that called with the given action.
+        static size_t ForEachActionMap(const std::function<void(ActionMap*)>& action) {
+            if (!action) return 0;
+            size_t count = 0;
+            for (ActionMap* map : ActionMap::__created_action_maps)
+                if (map) { action(map); count++; }
+
+            return count;
+        }
+    };
+}
+
+std::unordered_set<Engine::ActionMap*> Engine::ActionMap::__created_action_maps = std::unordered_set<Engine::ActionMap*>();
+
+#endif // __ENGINE_ACTIONMAP_H__
\ No newline at end of file
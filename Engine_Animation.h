@@ -4,6 +4,7 @@
 #include "Engine_GameObject.h"
 #include "Engine_Math.h"
 #include "Engine_Renderer.h"
+#include "Engine_Timer.h"
 
 namespace Engine {
     class AnimationScript;
@@ -17,11 +18,36 @@ namespace Engine {
         bool __is_started = false, __is_played = false;
         double __delay = 0, __duration = 0.01;
         double __time = 0;
+        // The delay is waited on the Timer, so a delaying script do nothing on each frame.
+        TimerID __delay_timer = 0;
+        double __delay_end = 0;
+        bool __is_delay_elapsed = false;
+
+        /// @brief Stop waiting the delay on the Timer, and keep the time waited.
+        void __cancel_delay() {
+            if (!__delay_timer) return;
+            __time = __delay - Timer::GetRemainingTime(__delay_timer);
+            Timer::Cancel(__delay_timer);
+            __delay_timer = 0;
+        }
+
+        std::vector<std::pair<uint64_t, std::function<void()>>> __stop_actions;
+
+        /// @brief Execute (and remove) all actions added with AddStopAction().
+        void __run_stop_actions() {
+            if (__stop_actions.empty()) return;
+            // Taken out first, an action may destroy the Animation Script.
+            std::vector<std::pair<uint64_t, std::function<void()>>> actions;
+            actions.swap(__stop_actions);
+            for (auto& action : actions) action.second();
+        }
 
         static bool __is_destroy_all;
+        static uint64_t __next_stop_action_id;
         static std::unordered_set<AnimationScript*> __created_scripts;
     protected:
-        /// @brief Occurred when the Animation Script is delaying (after started but before playing).
+        /// @brief Occurred when the Animation Script start delaying (after started but before playing). The rest of the delay
+        /// is waited on the Timer.
         /// @param Target The target Game Object of the animation.
         virtual void OnDelayAnimation(GameObject* Target) {}
         /// @brief Occurred when the Animation Script is starting (before updating).
@@ -40,7 +66,7 @@ namespace Engine {
         /// @brief If this true, will reset and play the Animation Script after finish the animation. Default is false.
         bool Repeated = false;
 
-        /// @brief The Delay Animation Event, will occurred when the Animation Script is delaying (after started but before playing).
+        /// @brief The Delay Animation Event, will occurred when the Animation Script start delaying (after started but before playing).
         AnimationScriptEventCaller DelayAnimationEvent;
         /// @brief The Start Animation Event, will occurred when the Animation Script is starting (before updating).
         AnimationScriptEventCaller StartAnimationEvent;
@@ -52,6 +78,8 @@ namespace Engine {
         /// @brief Create a new Animation Script, should be created with 'new' keyword (new AnimationScript()).
         AnimationScript() { AnimationScript::__created_scripts.insert(this); }
         virtual ~AnimationScript() {
+            Timer::Cancel(__delay_timer);
+            __run_stop_actions();
             if (!AnimationScript::__is_destroy_all)
                 AnimationScript::__created_scripts.erase(this);
         }
@@ -68,41 +96,53 @@ namespace Engine {
 
         /// @brief Set the amount of time to wait after starting the Animation Script, but before playing.
         /// @param Delay The amount of time to delay in seconds to set, will clamped to be non-negative.
-        void SetDelay(double Delay) { __delay = Delay < 0 ? 0 : Delay; }
+        void SetDelay(double Delay) { __cancel_delay(); __delay = Delay < 0 ? 0 : Delay; }
         /// @brief Get the amount of time to delay before playing of the Animation Script.
         /// @return The amount of time to delay before playing of the Animation Script in seconds.
         double GetDelay() const { return __delay; }
 
         /// @brief Get the current playing time of the Animation Script.
         /// @return The current playing time of the Animation Script in seconds.
-        double GetPlayTime() const { return __time; }
+        double GetPlayTime() const { return __delay_timer ? __delay - Timer::GetRemainingTime(__delay_timer) : __time; }
+        /// @brief Seek the Animation Script to the given playing time (include the delay).
+        /// @param Time The playing time in seconds to set, will clamped to be non-negative.
+        void SetPlayTime(double Time) { __cancel_delay(); __is_delay_elapsed = false; __time = Time < 0 ? 0 : Time; }
 
         /// @brief Play the animation.
         void PlayAnimation() { __is_started = true; }
         /// @brief Pause the animation.
-        void PauseAnimation() { __is_started = false; }
+        void PauseAnimation() { __cancel_delay(); __is_started = false; }
         /// @brief Reset the animation to the beginning.
-        void ResetAnimation() { __time = 0; __is_played = false; }
-        /// @brief Reset and stop the animation.
-        void StopAnimation() { ResetAnimation(); __is_started = false; }
+        void ResetAnimation() { __cancel_delay(); __time = 0; __is_played = false; __is_delay_elapsed = false; }
+        /// @brief Reset and stop the animation. This will also execute the actions added with AddStopAction().
+        void StopAnimation() { ResetAnimation(); __is_started = false; __run_stop_actions(); }
 
         /// @brief Check if the Animation Script is started and playing (not delaying).
         /// @return true if the Animation Script is playing, false otherwise.
-        bool IsPlaying() const { return __is_started && __time >= __delay; }
+        bool IsPlaying() const { return __is_started && !__delay_timer && __time >= __delay; }
         /// @brief Check if the Animation Script is started delaying.
         /// @return true if the Animation Script is delaying, false otherwise.
-        bool IsDelay() const { return __is_started && __time < __delay; }
+        bool IsDelay() const { return __is_started && (__delay_timer || __time < __delay); }
         /// @brief Check if the Animation Script is started.
         /// @return true if the Animation Script is started, false otherwise.
         bool IsStarted() const { return __is_started; }
 
 
         void OnUpdate(Engine::GameObject* Target) override {
-            if (!__is_started)
+            if (!__is_started || __delay_timer)
                 return;
-            __time += Application::GetDeltaTime();
+            // The time of this frame is already counted by the Timer when the delay elapsed.
+            if (__is_delay_elapsed) __is_delay_elapsed = false;
+            else __time += Application::GetDeltaTime();
             if (__time < __delay) {
                 OnDelayAnimation(Target); DelayAnimationEvent.Call(this);
+                // Wait for the rest of the delay on the Timer.
+                __delay_end = Timer::GetTime() + (__delay - __time);
+                __delay_timer = Timer::After(__delay - __time, [this]() {
+                    __delay_timer = 0;
+                    __time = __delay + (Timer::GetTime() - __delay_end);
+                    __is_delay_elapsed = true;
+                });
                 return;
             }
             if (!__is_played && __time >= __delay) {
@@ -119,9 +159,36 @@ namespace Engine {
                     ResetAnimation();
                 if (Repeated)
                     PlayAnimation();
+                __run_stop_actions();
             }
         }
 
+        /// @brief Add an action to execute once when the Animation Script finish playing next time (after the Stop
+        /// Animation Event), is stopped with StopAnimation() or is destroyed (so the action can't be left waiting). When
+        /// executed on destroying, the action must not use the Animation Script.
+        /// @param Action The action to execute.
+        /// @return The ID of the action (use for RemoveStopAction()), or 0 on failed (the action is empty).
+        uint64_t AddStopAction(const std::function<void()>& Action) {
+            if (!Action) return 0;
+            __stop_actions.emplace_back(++AnimationScript::__next_stop_action_id, Action);
+            return AnimationScript::__next_stop_action_id;
+        }
+        /// @brief Remove an action that added with AddStopAction() and not executed yet.
+        /// @param ID The ID of the action.
+        /// @return true if the action is removed, false if not found.
+        bool RemoveStopAction(uint64_t ID) {
+            for (auto it = __stop_actions.begin(); it != __stop_actions.end(); ++it)
+                if (it->first == ID) { __stop_actions.erase(it); return true; }
+            return false;
+        }
+
+        /// @brief Check if the given Animation Script is created and not destroyed yet.
+        /// @param Script The Animation Script to check.
+        /// @return true if the Animation Script is not destroyed, false otherwise.
+        static bool IsCreated(const AnimationScript* Script) {
+            return Script && AnimationScript::__created_scripts.count(const_cast<AnimationScript*>(Script)) != 0;
+        }
+
 
         /// @brief Destroy all created Animation Scripts. This will be called on Engine::Deinitialize()
         static void DestroyAllCreatedScripts() {
@@ -136,6 +203,7 @@ namespace Engine {
 }
 
 bool Engine::AnimationScript::__is_destroy_all = false;
+uint64_t Engine::AnimationScript::__next_stop_action_id = 0;
 std::unordered_set<Engine::AnimationScript*> Engine::AnimationScript::__created_scripts
     = std::unordered_set<Engine::AnimationScript*>();
 
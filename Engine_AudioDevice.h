@@ -0,0 +1,246 @@
+#ifndef __ENGINE_AUDIODEVICE_H__
+#define __ENGINE_AUDIODEVICE_H__
+
+#define ENGINE_AUDIO_MAX_POST_MIX_HANDLERS 8
+#define ENGINE_AUDIO_ADAPTIVE_PROBE_TIME 0.25
+
+#include "Engine_Define.h"
+
+#include <atomic>
+#include <cmath>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+
+namespace Engine {
+    /// @brief The Audio Post Mix Handler, will be called on the audio thread with the mixed output of the Audio Device (after
+    /// SDL_mixer channels and music) in the device format.
+    typedef void (*AudioPostMixHandler)(Uint8* stream, int len);
+
+    /// @brief The Audio Latency Report struct, contain the audio callback timing measured by the Audio Device.
+    struct AudioLatencyReport {
+    public:
+        /// @brief The expected period in seconds between two audio callbacks (buffer size / frequency).
+        double ExpectedPeriod = 0;
+        /// @brief The average measured period in seconds between two audio callbacks.
+        double AveragePeriod = 0;
+        /// @brief The standard deviation in seconds of the measured period (jitter).
+        double Jitter = 0;
+        /// @brief The maximum measured period in seconds between two audio callbacks.
+        double MaximumPeriod = 0;
+        /// @brief The number of measured audio callbacks.
+        unsigned long long CallbackCount = 0;
+        /// @brief The number of late audio callbacks (period longer than 1.5 times the expected period), each of them
+        /// likely caused an underrun of the audio device.
+        unsigned long long UnderrunCount = 0;
+    };
+
+    /// @brief The Audio Device class, use to configure and open the audio device, and to measure it latency. The public
+    /// settings must be set before Engine::Initialize() (or before reopening the Audio Device).
+    class AudioDevice final {
+    private:
+        static bool __is_opened;
+        static int __frequency, __channels, __buffer_size, __frame_size;
+        static Uint16 __format;
+        static std::atomic<AudioPostMixHandler> __post_mix_handlers[ENGINE_AUDIO_MAX_POST_MIX_HANDLERS];
+
+        // The latency probe. Written by the audio thread only, read by the main thread.
+        static std::atomic<bool> __reset_probe;
+        static Uint64 __last_callback_counter;
+        static std::atomic<unsigned long long> __callback_count, __underrun_count;
+        static std::atomic<double> __period_sum, __period_square_sum, __period_max;
+
+        /// @brief Update the latency probe with the given callback (audio thread).
+        static void __probe_callback(int frames) {
+            Uint64 counter = SDL_GetPerformanceCounter();
+            if (AudioDevice::__reset_probe.exchange(false, std::memory_order_acq_rel)) {
+                AudioDevice::__callback_count.store(0, std::memory_order_relaxed);
+                AudioDevice::__underrun_count.store(0, std::memory_order_relaxed);
+                AudioDevice::__period_sum.store(0, std::memory_order_relaxed);
+                AudioDevice::__period_square_sum.store(0, std::memory_order_relaxed);
+                AudioDevice::__period_max.store(0, std::memory_order_relaxed);
+                AudioDevice::__last_callback_counter = 0;
+            }
+            if (AudioDevice::__last_callback_counter != 0) {
+                double period = (double)(counter - AudioDevice::__last_callback_counter) / (double)SDL_GetPerformanceFrequency();
+                double expected = (double)frames / (double)AudioDevice::__frequency;
+                AudioDevice::__period_sum.store(AudioDevice::__period_sum.load(std::memory_order_relaxed) + period, std::memory_order_relaxed);
+                AudioDevice::__period_square_sum.store(
+                    AudioDevice::__period_square_sum.load(std::memory_order_relaxed) + period * period, std::memory_order_relaxed);
+                if (period > AudioDevice::__period_max.load(std::memory_order_relaxed))
+                    AudioDevice::__period_max.store(period, std::memory_order_relaxed);
+                if (period > expected * 1.5)
+                    AudioDevice::__underrun_count.fetch_add(1, std::memory_order_relaxed);
+                AudioDevice::__callback_count.fetch_add(1, std::memory_order_release);
+            }
+            AudioDevice::__last_callback_counter = counter;
+        }
+        /// @brief The post mix callback of SDL_mixer (audio thread).
+        static void __post_mix(void* udata, Uint8* stream, int len) {
+            __probe_callback(len / AudioDevice::__frame_size);
+            for (std::atomic<AudioPostMixHandler>& handler : AudioDevice::__post_mix_handlers) {
+                AudioPostMixHandler func = handler.load(std::memory_order_acquire);
+                if (func) func(stream, len);
+            }
+        }
+        /// @brief Open the audio device with the given buffer size.
+        static bool __open(int buffer_size) {
+            if (Mix_OpenAudio(Frequency, Format, Channels, buffer_size) != 0)
+                return false;
+            int channels = 0;
+            if (Mix_QuerySpec(&AudioDevice::__frequency, &AudioDevice::__format, &channels) == 0) {
+                Mix_CloseAudio();
+                return false;
+            }
+            AudioDevice::__channels = channels;
+            AudioDevice::__buffer_size = buffer_size;
+            AudioDevice::__frame_size = channels * (SDL_AUDIO_BITSIZE(AudioDevice::__format) / 8);
+            AudioDevice::__reset_probe.store(true, std::memory_order_release);
+            AudioDevice::__is_opened = true;
+            Mix_SetPostMix(&AudioDevice::__post_mix, nullptr);
+            return true;
+        }
+    public:
+        /// @brief The requested frequency (sample rate) of the Audio Device in Hz. Default is 44100.
+        static int Frequency;
+        /// @brief The requested sample format of the Audio Device. Default is MIX_DEFAULT_FORMAT.
+        static Uint16 Format;
+        /// @brief The requested number of output channels of the Audio Device (1 for mono, 2 for stereo). Default is 2.
+        static int Channels;
+        /// @brief The requested buffer size of the Audio Device in sample frames, should be a power of 2. Smaller buffer mean
+        /// lower latency, but higher chance of underrun. If AdaptiveBufferSize is true, this is the maximum buffer size to
+        /// try. Default is 4096.
+        static int BufferSize;
+        /// @brief If this true, on opening the Audio Device will pick the smallest buffer size (a power of 2, from
+        /// MinimumBufferSize to BufferSize) that run without underruns on the current machine. Each buffer size is probed
+        /// for ENGINE_AUDIO_ADAPTIVE_PROBE_TIME seconds, so this will block the opening. Default is false.
+        static bool AdaptiveBufferSize;
+        /// @brief The minimum buffer size in sample frames to try with AdaptiveBufferSize. Default is 256.
+        static int MinimumBufferSize;
+
+        /// @brief Open the Audio Device with the current settings. This is called on Engine::Initialize().
+        /// @return true on success, false on failed.
+        static bool Open() {
+            if (AudioDevice::__is_opened) return true;
+            if (!AdaptiveBufferSize) return __open(BufferSize);
+
+            int buffer_size = ENGINE_MAX(MinimumBufferSize, 1);
+            while (true) {
+                bool is_last = buffer_size >= BufferSize;
+                if (__open(is_last ? BufferSize : buffer_size)) {
+                    if (is_last) return true;
+                    SDL_Delay((Uint32)(ENGINE_AUDIO_ADAPTIVE_PROBE_TIME * 1000));
+                    AudioLatencyReport report = GetLatencyReport();
+                    if (report.CallbackCount > 0 && report.UnderrunCount == 0) return true;
+                    Close();
+                }
+                else if (is_last) return false;
+                buffer_size *= 2;
+            }
+        }
+        /// @brief Close the Audio Device. This is called on Engine::Deinitialize().
+        static void Close() {
+            if (!AudioDevice::__is_opened) return;
+            Mix_SetPostMix(nullptr, nullptr);
+            Mix_CloseAudio();
+            AudioDevice::__is_opened = false;
+        }
+        /// @brief Check if the Audio Device is opened.
+        /// @return true if the Audio Device is opened, false otherwise.
+        static bool IsOpened() { return AudioDevice::__is_opened; }
+
+        /// @brief Get the actual frequency (sample rate) of the opened Audio Device.
+        /// @return The frequency in Hz, or 0 if the Audio Device is not opened.
+        static int GetFrequency() { return AudioDevice::__is_opened ? AudioDevice::__frequency : 0; }
+        /// @brief Get the actual sample format of the opened Audio Device.
+        /// @return The sample format, or 0 if the Audio Device is not opened.
+        static Uint16 GetFormat() { return AudioDevice::__is_opened ? AudioDevice::__format : 0; }
+        /// @brief Get the actual number of output channels of the opened Audio Device.
+        /// @return The number of channels, or 0 if the Audio Device is not opened.
+        static int GetChannels() { return AudioDevice::__is_opened ? AudioDevice::__channels : 0; }
+        /// @brief Get the buffer size in sample frames of the opened Audio Device (the one picked if AdaptiveBufferSize is true).
+        /// @return The buffer size, or 0 if the Audio Device is not opened.
+        static int GetBufferSize() { return AudioDevice::__is_opened ? AudioDevice::__buffer_size : 0; }
+        /// @brief Get the buffer latency of the opened Audio Device (buffer size / frequency).
+        /// @return The buffer latency in seconds, or 0 if the Audio Device is not opened.
+        static double GetBufferLatency() {
+            return AudioDevice::__is_opened ? (double)AudioDevice::__buffer_size / (double)AudioDevice::__frequency : 0;
+        }
+
+        /// @brief Get the audio callback timing measured since the Audio Device is opened (or since the last reset).
+        /// @return The latency report.
+        static AudioLatencyReport GetLatencyReport() {
+            AudioLatencyReport report;
+            if (!AudioDevice::__is_opened) return report;
+            report.ExpectedPeriod = GetBufferLatency();
+            report.CallbackCount = AudioDevice::__callback_count.load(std::memory_order_acquire);
+            report.UnderrunCount = AudioDevice::__underrun_count.load(std::memory_order_relaxed);
+            report.MaximumPeriod = AudioDevice::__period_max.load(std::memory_order_relaxed);
+            if (report.CallbackCount == 0) return report;
+
+            double count = (double)report.CallbackCount;
+            report.AveragePeriod = AudioDevice::__period_sum.load(std::memory_order_relaxed) / count;
+            double variance = AudioDevice::__period_square_sum.load(std::memory_order_relaxed) / count -
+                report.AveragePeriod * report.AveragePeriod;
+            report.Jitter = variance > 0 ? std::sqrt(variance) : 0;
+            return report;
+        }
+        /// @brief Reset the measured audio callback timing, the reset is done on the next audio callback.
+        static void ResetLatencyReport() { AudioDevice::__reset_probe.store(true, std::memory_order_release); }
+
+        /// @brief Add a handler that will be called on the audio thread after each mix.
+        /// @param handler The handler to add.
+        /// @return true on success, false if the handler is null or there's no free handler slot.
+        static bool AddPostMixHandler(AudioPostMixHandler handler) {
+            if (!handler) return false;
+            for (std::atomic<AudioPostMixHandler>& slot : AudioDevice::__post_mix_handlers)
+                if (slot.load(std::memory_order_relaxed) == handler) return true;
+            for (std::atomic<AudioPostMixHandler>& slot : AudioDevice::__post_mix_handlers) {
+                if (slot.load(std::memory_order_relaxed)) continue;
+                slot.store(handler, std::memory_order_release);
+                return true;
+            }
+            return false;
+        }
+        /// @brief Remove a post mix handler. After this return, the handler is not running and will not be called anymore.
+        /// @param handler The handler to remove.
+        static void RemovePostMixHandler(AudioPostMixHandler handler) {
+            if (!handler) return;
+            for (std::atomic<AudioPostMixHandler>& slot : AudioDevice::__post_mix_handlers)
+                if (slot.load(std::memory_order_relaxed) == handler)
+                    slot.store(nullptr, std::memory_order_release);
+            WaitForAudioCallback();
+        }
+        /// @brief Wait for the running audio callback (if any) to finish. Data that is unpublished from the audio thread
+        /// before this call is never read by the audio thread after it return.
+        static void WaitForAudioCallback() {
+            // Mix_SetPostMix() lock the audio device while setting the callback.
+            if (AudioDevice::__is_opened)
+                Mix_SetPostMix(&AudioDevice::__post_mix, nullptr);
+        }
+    };
+}
+
+bool Engine::AudioDevice::__is_opened = false;
+int Engine::AudioDevice::__frequency = 0;
+int Engine::AudioDevice::__channels = 0;
+int Engine::AudioDevice::__buffer_size = 0;
+int Engine::AudioDevice::__frame_size = 1;
+Uint16 Engine::AudioDevice::__format = 0;
+std::atomic<Engine::AudioPostMixHandler> Engine::AudioDevice::__post_mix_handlers[ENGINE_AUDIO_MAX_POST_MIX_HANDLERS] = {};
+
+std::atomic<bool> Engine::AudioDevice::__reset_probe(false);
+Uint64 Engine::AudioDevice::__last_callback_counter = 0;
+std::atomic<unsigned long long> Engine::AudioDevice::__callback_count(0);
+std::atomic<unsigned long long> Engine::AudioDevice::__underrun_count(0);
+std::atomic<double> Engine::AudioDevice::__period_sum(0);
+std::atomic<double> Engine::AudioDevice::__period_square_sum(0);
+std::atomic<double> Engine::AudioDevice::__period_max(0);
+
+int Engine::AudioDevice::Frequency = 44100;
+Uint16 Engine::AudioDevice::Format = MIX_DEFAULT_FORMAT;
+int Engine::AudioDevice::Channels = 2;
+int Engine::AudioDevice::BufferSize = 4096;
+bool Engine::AudioDevice::AdaptiveBufferSize = false;
+int Engine::AudioDevice::MinimumBufferSize = 256;
+
+#endif // __ENGINE_AUDIODEVICE_H__
\ No newline at end of file
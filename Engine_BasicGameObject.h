@@ -13,7 +13,7 @@ namespace Engine {
             GameObject::OnRender(args);
             if (LayoutTexture) {
                 LayoutTexture->SetColorMod(LayoutColor);
-                Renderer::DrawTexture(args->TargetArea, LayoutTexture);
+                Renderer::DrawTexture(args->Transform, args->GetLocalArea(), LayoutTexture);
                 LayoutTexture->SetColorMod(Color(255, 255, 255, 255));
             }
         }
@@ -0,0 +1,739 @@
+#ifndef __ENGINE_COLLISION_H__
+#define __ENGINE_COLLISION_H__
+
+#include "Engine_Define.h"
+#include "Engine_Event.h"
+#include "Engine_GameObject.h"
+#include "Engine_Imaging.h"
+#include "Engine_Math.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+/// @brief The maximum number of the sweep bands of the collision broadphase.
+#define ENGINE_COLLISION_MAX_BAND_COUNT 1024
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENGINE_COLLISION_SSE2
+#endif
+
+#if defined(ENGINE_COLLISION_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace Engine {
+    class ColliderScript;
+    class RigidBodyScript;
+
+    /// @brief The Collider Shape enum, define the shape of a Collider Script.
+    enum class ColliderShape {
+        /// @brief An axis-aligned box with the collider size.
+        Box = 0,
+        /// @brief A circle at the center of the collider size.
+        Circle = 1,
+        /// @brief A capsule along the longer side of the collider size.
+        Capsule = 2
+    };
+
+    /// @brief The Collision Mask class, represent the solid pixels of an image as one bit per pixel, packed in 64-bit words
+    /// per row, for pixel-perfect overlap tests. Two masks are tested 64 pixels at a time (128 with SSE2), only inside the
+    /// overlap of their bounds (the bounding box of the solid pixels).
+    class CollisionMask {
+    private:
+        int __width = 0, __height = 0;
+        size_t __words_per_row = 0;
+        std::vector<uint64_t> __bits;
+        Rectangle __bounds = Rectangle::Empty;
+
+        const uint64_t* __row(int y) const { return __bits.data() + (size_t)y * __words_per_row; }
+        /// @brief Get the 64 bits of the given row starting at the given bit (may be out of range, read as 0).
+        uint64_t __get_word(const uint64_t* row, int bit) const {
+            int word = bit >> 6, shift = bit & 63;
+            uint64_t low = (word >= 0 && (size_t)word < __words_per_row) ? row[word] : 0;
+            if (!shift) return low;
+            uint64_t high = (word + 1 >= 0 && (size_t)(word + 1) < __words_per_row) ? row[word + 1] : 0;
+            return (low >> shift) | (high << (64 - shift));
+        }
+        /// @brief Get the bits from the given start (inclusive) to the given end (exclusive) of a word at the given bit.
+        static uint64_t __range_bits(int word_start, int start, int end) {
+            int from = ENGINE_MAX(0, start - word_start), to = ENGINE_MIN(64, end - word_start);
+            if (from >= to) return 0;
+            uint64_t bits = to == 64 ? ~(uint64_t)0 : (((uint64_t)1 << to) - 1);
+            return bits & ~(((uint64_t)1 << from) - 1);
+        }
+        void __update_bounds() {
+            int left = __width, top = __height, right = -1, bottom = -1;
+            for (int y = 0; y < __height; y++) {
+                const uint64_t* row = __row(y);
+                for (size_t w = 0; w < __words_per_row; w++) {
+                    if (!row[w]) continue;
+                    int first = (int)(w * 64), last = (int)(w * 64) + 63;
+                    while (!((row[w] >> (first & 63)) & 1)) first++;
+                    while (!((row[w] >> (last & 63)) & 1)) last--;
+                    left = ENGINE_MIN(left, first); right = ENGINE_MAX(right, last);
+                    top = ENGINE_MIN(top, y); bottom = y;
+                }
+            }
+            __bounds = right < 0 ? Rectangle::Empty : Rectangle(left, top, right - left + 1, bottom - top + 1);
+        }
+    public:
+        /// @brief Create an empty Collision Mask.
+        CollisionMask() = default;
+        /// @brief Create a Collision Mask with the given size, with no solid pixel.
+        /// @param Size The size of the mask.
+        CollisionMask(const Engine::Size& Size) : __width(abs(Size.Width)), __height(abs(Size.Height)) {
+            __words_per_row = ((size_t)__width + 63) / 64;
+            __bits.assign(__words_per_row * __height, 0);
+        }
+        /// @brief Create a Collision Mask from the alpha channel of the given Color Map.
+        /// @param Map The Color Map to create from, the mask is empty if this null or not avaliable.
+        /// @param AlphaThreshold The minimum alpha of a solid pixel. Default is 128.
+        CollisionMask(ColorMap* Map, uint8_t AlphaThreshold = 128) {
+            if (!Map || !Map->IsAvaliable()) return;
+            *this = CollisionMask(Map->GetSize());
+            SDL_Surface* surface = Map->GetSDLSurface();
+            bool is_locked = Map->IsMustLock();
+            if (is_locked) Map->Lock();
+
+            const SDL_PixelFormat* format = surface->format;
+            uint32_t alpha_mask = format->Amask, alpha_shift = 0;
+            while (alpha_mask && !((alpha_mask >> alpha_shift) & 1)) alpha_shift++;
+            // Read the alpha directly from 32-bit pixels with 8-bit alpha, the others go through SDL_GetRGBA().
+            bool is_fast = format->BytesPerPixel == 4 && (alpha_mask >> alpha_shift) == 0xFF;
+            for (int y = 0; y < __height; y++) {
+                const uint8_t* pixels = (const uint8_t*)surface->pixels + (size_t)y * surface->pitch;
+                uint64_t* row = __bits.data() + (size_t)y * __words_per_row;
+                for (int x = 0; x < __width; x++) {
+                    uint8_t alpha = 0;
+                    if (is_fast) alpha = (uint8_t)((((const uint32_t*)pixels)[x] & alpha_mask) >> alpha_shift);
+                    else {
+                        uint32_t pixel = 0;
+                        SDL_memcpy(&pixel, pixels + x * format->BytesPerPixel, format->BytesPerPixel);
+                        uint8_t r, g, b;
+                        SDL_GetRGBA(pixel, surface->format, &r, &g, &b, &alpha);
+                    }
+                    if (alpha >= AlphaThreshold) row[x >> 6] |= (uint64_t)1 << (x & 63);
+                }
+            }
+            if (is_locked) Map->Unlock();
+            __update_bounds();
+        }
+
+        /// @brief Get the size of the mask.
+        /// @return The size of the mask.
+        Size GetSize() const { return Size(__width, __height); }
+        /// @brief Get the bounding box of the solid pixels.
+        /// @return The bounds of the solid pixels, or Rectangle::Empty if there's none.
+        Rectangle GetBounds() const { return __bounds; }
+        /// @brief Check if the given pixel is solid.
+        /// @param X The x position of the pixel.
+        /// @param Y The y position of the pixel.
+        /// @return true if the pixel is solid, false otherwise (or out of range).
+        bool GetPixel(int X, int Y) const {
+            if (X < 0 || X >= __width || Y < 0 || Y >= __height) return false;
+            return (__row(Y)[X >> 6] >> (X & 63)) & 1;
+        }
+        /// @brief Set the given pixel to be solid or not.
+        /// @param X The x position of the pixel, will not set if out of range.
+        /// @param Y The y position of the pixel, will not set if out of range.
+        /// @param Solid true to set the pixel solid, false otherwise.
+        void SetPixel(int X, int Y, bool Solid) {
+            if (X < 0 || X >= __width || Y < 0 || Y >= __height) return;
+            uint64_t& word = __bits[(size_t)Y * __words_per_row + (X >> 6)];
+            uint64_t bit = (uint64_t)1 << (X & 63);
+            word = Solid ? (word | bit) : (word & ~bit);
+            // The bounds only grow here, a bounds larger than the solid pixels is still correct for the pre-reject.
+            if (!Solid) return;
+            if (__bounds.IsEmptyArea()) { __bounds = Rectangle(X, Y, 1, 1); return; }
+            int left = ENGINE_MIN(__bounds.X, X), top = ENGINE_MIN(__bounds.Y, Y);
+            int right = ENGINE_MAX(__bounds.X + __bounds.Width, X + 1), bottom = ENGINE_MAX(__bounds.Y + __bounds.Height, Y + 1);
+            __bounds = Rectangle(left, top, right - left, bottom - top);
+        }
+
+        /// @brief Check if this mask overlap the given mask, placed at the given offset from this mask.
+        /// @param Other The other mask.
+        /// @param OffsetX The x position of the other mask, relative to this mask.
+        /// @param OffsetY The y position of the other mask, relative to this mask.
+        /// @return true if any solid pixel of both masks overlap, false otherwise.
+        bool Overlaps(const CollisionMask& Other, int OffsetX, int OffsetY) const {
+            if (__bounds.IsEmptyArea() || Other.__bounds.IsEmptyArea()) return false;
+            // The overlap of the bounds, in this mask space.
+            int left = ENGINE_MAX(__bounds.X, Other.__bounds.X + OffsetX);
+            int top = ENGINE_MAX(__bounds.Y, Other.__bounds.Y + OffsetY);
+            int right = ENGINE_MIN(__bounds.X + __bounds.Width, Other.__bounds.X + Other.__bounds.Width + OffsetX);
+            int bottom = ENGINE_MIN(__bounds.Y + __bounds.Height, Other.__bounds.Y + Other.__bounds.Height + OffsetY);
+            if (left >= right || top >= bottom) return false;
+
+            const int first_word = left >> 6, last_word = (right - 1) >> 6;
+#if defined(ENGINE_COLLISION_SSE2)
+            // The word w of this mask meet the bits from (w * 64 - OffsetX) of the other, that is the words (w + word_offset)
+            // and (w + word_offset + 1) shifted by bit_offset. The inner words are full and in range of both rows.
+            const int word_offset = (-OffsetX) >> 6, bit_offset = (-OffsetX) & 63;
+            const __m128i shift = _mm_cvtsi32_si128(bit_offset), high_shift = _mm_cvtsi32_si128(64 - bit_offset);
+#endif
+            for (int y = top; y < bottom; y++) {
+                const uint64_t* row = __row(y);
+                const uint64_t* other_row = Other.__row(y - OffsetY);
+                // Accumulate the row without branching, so the loop is cheap for wide masks.
+                uint64_t overlap = 0;
+                int w = first_word;
+#if defined(ENGINE_COLLISION_SSE2)
+                if (last_word - first_word >= 3) {
+                    overlap |= row[w] & Other.__get_word(other_row, w * 64 - OffsetX) & __range_bits(w * 64, left, right);
+                    w++;
+                    // Two words at a time (a shift by 64 give 0, so the high words are ignored when bit_offset is 0).
+                    __m128i accumulator = _mm_setzero_si128();
+                    for (; w + 2 <= last_word; w += 2) {
+                        __m128i low = _mm_loadu_si128((const __m128i*)(other_row + w + word_offset));
+                        __m128i high = _mm_loadu_si128((const __m128i*)(other_row + w + word_offset + 1));
+                        __m128i other = _mm_or_si128(_mm_srl_epi64(low, shift), _mm_sll_epi64(high, high_shift));
+                        accumulator = _mm_or_si128(accumulator, _mm_and_si128(_mm_loadu_si128((const __m128i*)(row + w)), other));
+                    }
+                    uint64_t words[2];
+                    _mm_storeu_si128((__m128i*)words, accumulator);
+                    overlap |= words[0] | words[1];
+                }
+#endif
+                for (; w <= last_word; w++)
+                    overlap |= row[w] & Other.__get_word(other_row, w * 64 - OffsetX) & __range_bits(w * 64, left, right);
+                if (overlap) return true;
+            }
+            return false;
+        }
+        /// @brief Check if any solid pixel of this mask is in the given area.
+        /// @param Area The area to check, in this mask space.
+        /// @return true if any solid pixel is in the area, false otherwise.
+        bool Overlaps(const Rectangle& Area) const {
+            if (__bounds.IsEmptyArea()) return false;
+            int left = ENGINE_MAX(__bounds.X, ENGINE_MIN(Area.X, Area.X + Area.Width));
+            int top = ENGINE_MAX(__bounds.Y, ENGINE_MIN(Area.Y, Area.Y + Area.Height));
+            int right = ENGINE_MIN(__bounds.X + __bounds.Width, ENGINE_MAX(Area.X, Area.X + Area.Width));
+            int bottom = ENGINE_MIN(__bounds.Y + __bounds.Height, ENGINE_MAX(Area.Y, Area.Y + Area.Height));
+            if (left >= right || top >= bottom) return false;
+            for (int y = top; y < bottom; y++) {
+                const uint64_t* row = __row(y);
+                uint64_t overlap = 0;
+                for (int w = left >> 6; w <= (right - 1) >> 6; w++)
+                    overlap |= row[w] & __range_bits(w * 64, left, right);
+                if (overlap) return true;
+            }
+            return false;
+        }
+    };
+
+    /// @brief The Contact struct, represent a contact between two colliders.
+    struct Contact {
+        /// @brief The first collider of the contact.
+        ColliderScript* A = nullptr;
+        /// @brief The second collider of the contact.
+        ColliderScript* B = nullptr;
+        /// @brief The contact normal, point from A to B.
+        Vec2f Normal = Vec2f::Zero;
+        /// @brief The penetration depth along the Normal.
+        float Depth = 0.0f;
+        /// @brief The contact point, between the surfaces of A and B.
+        Vec2f Point = Vec2f::Zero;
+    };
+    /// @brief The Collision Event Args struct, contain a batch of contacts. If a handler remove a collider (or destroy
+    /// its Game Object), the contacts of that collider stay in the batch with null A and B until the event is done, so
+    /// the handlers should skip them.
+    struct CollisionEventArgs : public EventArgs {
+        /// @brief The contacts of the event.
+        const Contact* Contacts = nullptr;
+        /// @brief The number of contacts.
+        size_t Count = 0;
+    };
+    /// @brief The Collision Event Caller, use for collision event.
+    typedef GlobalEventCaller<CollisionEventArgs> CollisionEventCaller;
+
+    /// @brief The Collider Script class, attach a collider to the Game Object (with AddScript<ColliderScript>()). The
+    /// collider is placed at the precise position of the Game Object (Position + PositionOffset), so the colliders are
+    /// compared in the space of their parents, and colliding Game Objects should have the same parent.
+    class ColliderScript : public GameScript {
+        friend class Collision;
+        friend class Physics;
+    private:
+        GameObject* __target = nullptr;
+        RigidBodyScript* __body = nullptr;
+        uint32_t __proxy = UINT32_MAX;
+        uint32_t __id = 0;
+    protected:
+        void OnStart(GameObject* Target) override;
+        void OnStop(GameObject* Target) override;
+    public:
+        /// @brief If this false, the collider is ignored. Default is true.
+        bool Enabled = true;
+        /// @brief The shape of the collider. Default is ColliderShape::Box.
+        ColliderShape Shape = ColliderShape::Box;
+        /// @brief The offset of the collider from the position of the Game Object. Default is Vec2f::Zero.
+        Vec2f Offset = Vec2f::Zero;
+        /// @brief The size of the collider. Default is Vec2f::Zero mean the Size of the Game Object.
+        Vec2f Size = Vec2f::Zero;
+        /// @brief The radius of the Circle and Capsule shape. Default is 0 mean half of the shorter side of the size.
+        float Radius = 0.0f;
+        /// @brief The layers of the collider, as bit flags. Default is 1.
+        uint32_t Layer = 1;
+        /// @brief The layers that the collider collide with. Two colliders collide only if each one's Layer is in the
+        /// other's Mask. Default is all layers.
+        uint32_t Mask = UINT32_MAX;
+        /// @brief If this true, the collider only report contacts and is not resolved by the physics. Default is false.
+        bool IsTrigger = false;
+        /// @brief The pixel mask of the collider, placed at the position of the Game Object plus the Offset (unscaled).
+        /// If set, the contacts of the collider are kept only if the mask overlap the other collider's mask (or bounds,
+        /// if it has no mask). The mask is not owned by the collider. Default is nullptr.
+        const CollisionMask* PixelMask = nullptr;
+
+        ColliderScript() = default;
+        virtual ~ColliderScript();
+
+        /// @brief Get the Game Object of the collider.
+        /// @return The Game Object, or nullptr if not attached.
+        GameObject* GetTarget() const { return __target; }
+        /// @brief Get the bounds of the collider, as of the last Collision::Update().
+        /// @return The bounds of the collider.
+        RectF GetBounds() const;
+    };
+
+    /// @brief The Collision class, detect the contacts between all attached colliders once per frame. The broadphase sort
+    /// the colliders by their left side and sweep along the X axis within horizontal bands, the order is kept between
+    /// frames so it's mostly sorted already (the colliders only move a little per frame). Each shape is a box core rounded by a radius, so all
+    /// shape pairs share one exact narrowphase test. The contacts are reported in batches, ordered by the colliders.
+    class Collision final {
+        friend class ColliderScript;
+        friend class Physics;
+    private:
+        static std::vector<ColliderScript*> __colliders;
+        // Per collider: center and half size of the core box, the radius and the bounds.
+        static std::vector<float> __center_x, __center_y, __half_x, __half_y, __radius;
+        static std::vector<float> __min_x, __min_y, __max_x, __max_y;
+        // The collider indices sorted by __min_x, and the bounds in that order for the sweep. The colliders added since the
+        // last Detect() are unsorted after the first __sorted_count indices.
+        static std::vector<uint32_t> __order;
+        static size_t __sorted_count;
+        // The colliders removed since the last compaction, their slots in __colliders are null until then.
+        static std::vector<ColliderScript*> __removed_colliders;
+        // The bounds of the active colliders grouped by band, and the start of each band.
+        struct __entry {
+            float min_x, max_x, min_y, max_y;
+            uint32_t index;
+        };
+        static std::vector<__entry> __entries;
+        static std::vector<uint32_t> __band_offsets, __band_cursors;
+        static std::vector<uint8_t> __active;
+        static std::vector<Contact> __contacts, __previous_contacts, __begin_contacts, __end_contacts;
+        static uint32_t __next_id;
+        // Changed when a collider is added or removed.
+        static uint32_t __version;
+        // While the events are raised, the contacts of the removed colliders are only marked (null A and B).
+        static bool __is_dispatching, __has_marked_contacts;
+        // Set by Detect(), and cleared by Update() after raising the events.
+        static bool __is_detected;
+
+        static void __add(ColliderScript* collider) {
+            if (collider->__proxy != UINT32_MAX) return;
+            collider->__proxy = (uint32_t)__colliders.size();
+            collider->__id = ++__next_id;
+            __version++;
+            __colliders.push_back(collider);
+            for (std::vector<float>* array : { &__center_x, &__center_y, &__half_x, &__half_y, &__radius,
+                                               &__min_x, &__min_y, &__max_x, &__max_y })
+                array->push_back(0.0f);
+            __order.push_back(collider->__proxy);
+        }
+        static void __remove(ColliderScript* collider) {
+            uint32_t index = collider->__proxy;
+            if (index == UINT32_MAX) return;
+            // Only leave a tombstone, the arrays and the contacts are compacted once by __compact() (so removing all
+            // colliders of a scene stays linear).
+            __colliders[index] = nullptr;
+            __removed_colliders.push_back(collider);
+
+            // The removed collider must not be reported after this. The batches being raised keep their size, so
+            // their contacts are marked and swept after the events.
+            if (__is_dispatching) {
+                auto involve = [collider](const Contact& contact) { return contact.A == collider || contact.B == collider; };
+                for (std::vector<Contact>* contacts : { &__contacts, &__begin_contacts, &__end_contacts })
+                    for (Contact& contact : *contacts)
+                        if (involve(contact)) { contact.A = contact.B = nullptr; __has_marked_contacts = true; }
+            }
+            collider->__proxy = UINT32_MAX;
+            collider->__body = nullptr;
+            __version++;
+        }
+        /// @brief Drop the slots and the contacts of the removed colliders. The order of the others is kept, so it stays
+        /// mostly sorted. This is done by Detect() and Update(), not while the events are raised.
+        static void __compact() {
+            if (__removed_colliders.empty() || __is_dispatching) return;
+            // A removed collider may be freed already, so its contacts are found by the address only.
+            std::sort(__removed_colliders.begin(), __removed_colliders.end());
+            auto is_removed = [](const Contact& contact) {
+                return std::binary_search(__removed_colliders.begin(), __removed_colliders.end(), contact.A) ||
+                    std::binary_search(__removed_colliders.begin(), __removed_colliders.end(), contact.B);
+            };
+            for (std::vector<Contact>* contacts : { &__contacts, &__previous_contacts, &__begin_contacts, &__end_contacts })
+                contacts->erase(std::remove_if(contacts->begin(), contacts->end(), is_removed), contacts->end());
+            __removed_colliders.clear();
+
+            const uint32_t count = (uint32_t)__colliders.size();
+            std::vector<uint32_t> remap(count, UINT32_MAX);
+            uint32_t kept = 0;
+            for (uint32_t i = 0; i < count; i++) {
+                if (!__colliders[i]) continue;
+                remap[i] = kept;
+                if (kept != i) {
+                    __colliders[kept] = __colliders[i];
+                    __colliders[kept]->__proxy = kept;
+                    for (std::vector<float>* array : { &__center_x, &__center_y, &__half_x, &__half_y, &__radius,
+                                                       &__min_x, &__min_y, &__max_x, &__max_y })
+                        (*array)[kept] = (*array)[i];
+                }
+                kept++;
+            }
+            __colliders.resize(kept);
+            for (std::vector<float>* array : { &__center_x, &__center_y, &__half_x, &__half_y, &__radius,
+                                               &__min_x, &__min_y, &__max_x, &__max_y })
+                array->resize(kept);
+
+            size_t order_count = 0, sorted_count = 0;
+            for (size_t k = 0; k < __order.size(); k++) {
+                uint32_t index = remap[__order[k]];
+                if (index == UINT32_MAX) continue;
+                if (k < __sorted_count) sorted_count++;
+                __order[order_count++] = index;
+            }
+            __order.resize(order_count);
+            __sorted_count = sorted_count;
+        }
+        /// @brief Remove the contacts marked while raising an event.
+        static void __sweep_marked_contacts() {
+            if (!__has_marked_contacts) return;
+            auto is_marked = [](const Contact& contact) { return contact.A == nullptr; };
+            for (std::vector<Contact>* contacts : { &__contacts, &__begin_contacts, &__end_contacts })
+                contacts->erase(std::remove_if(contacts->begin(), contacts->end(), is_marked), contacts->end());
+            __has_marked_contacts = false;
+        }
+        static uint64_t __key(const Contact& contact) {
+            return ((uint64_t)contact.A->__id << 32) | (uint64_t)contact.B->__id;
+        }
+        /// @brief Update the shape and bounds of the collider at the given index from its Game Object.
+        static void __update_proxy(uint32_t i) {
+            ColliderScript* collider = __colliders[i];
+            GameObject* target = collider->__target;
+            Vec2f size = (collider->Size.X == 0.0f && collider->Size.Y == 0.0f) ? Vec2f(target->Size) : collider->Size;
+            size = Vec2f(fabsf(size.X), fabsf(size.Y));
+            Vec2f center = target->GetPrecisePosition() + collider->Offset + size * 0.5f;
+            float half_x = size.X * 0.5f, half_y = size.Y * 0.5f, radius = 0.0f;
+            if (collider->Shape != ColliderShape::Box) {
+                radius = collider->Radius > 0.0f ? collider->Radius : ENGINE_MIN(half_x, half_y);
+                if (collider->Shape == ColliderShape::Circle) half_x = half_y = 0.0f;
+                else if (half_x >= half_y) { half_x = ENGINE_MAX(0.0f, half_x - radius); half_y = 0.0f; }
+                else { half_y = ENGINE_MAX(0.0f, half_y - radius); half_x = 0.0f; }
+            }
+            __center_x[i] = center.X; __center_y[i] = center.Y;
+            __half_x[i] = half_x; __half_y[i] = half_y; __radius[i] = radius;
+            __min_x[i] = center.X - half_x - radius; __max_x[i] = center.X + half_x + radius;
+            __min_y[i] = center.Y - half_y - radius; __max_y[i] = center.Y + half_y + radius;
+        }
+        /// @brief Sort the order by the left side. Use insertion sort since the order is usually almost sorted, and fall
+        /// back to a full sort when it's not.
+        static void __sort_order() {
+            const float* min_x = __min_x.data();
+            uint32_t* order = __order.data();
+            const size_t count = __order.size();
+            size_t budget = count * 8;
+            for (size_t i = 1; i < count; i++) {
+                uint32_t value = order[i];
+                float key = min_x[value];
+                size_t j = i;
+                while (j > 0 && min_x[order[j - 1]] > key) {
+                    order[j] = order[j - 1]; j--;
+                    if (--budget == 0) {
+                        order[j] = value;
+                        std::sort(__order.begin(), __order.end(), [min_x](uint32_t a, uint32_t b) { return min_x[a] < min_x[b]; });
+                        return;
+                    }
+                }
+                order[j] = value;
+            }
+        }
+        /// @brief Check if the pixel masks of the colliders at the given indices overlap, a collider without mask is
+        /// tested with its bounds.
+        static bool __is_masks_overlapped(uint32_t a, uint32_t b) {
+            const ColliderScript* collider_a = __colliders[a], * collider_b = __colliders[b];
+            if (!collider_a->PixelMask) { std::swap(a, b); std::swap(collider_a, collider_b); }
+            Vec2f position_a = collider_a->__target->GetPrecisePosition() + collider_a->Offset;
+            int x = (int)floorf(position_a.X), y = (int)floorf(position_a.Y);
+            if (collider_b->PixelMask) {
+                Vec2f position_b = collider_b->__target->GetPrecisePosition() + collider_b->Offset;
+                return collider_a->PixelMask->Overlaps(*collider_b->PixelMask, (int)floorf(position_b.X) - x, (int)floorf(position_b.Y) - y);
+            }
+            int left = (int)floorf(__min_x[b]) - x, top = (int)floorf(__min_y[b]) - y;
+            return collider_a->PixelMask->Overlaps(Rectangle(left, top,
+                (int)ceilf(__max_x[b]) - x - left, (int)ceilf(__max_y[b]) - y - top));
+        }
+        /// @brief Test the colliders at the given indices, and add the contact if they collide.
+        static void __narrowphase(uint32_t a, uint32_t b) {
+            // Order by ID, so the contacts are reported in the same order every run.
+            if (__colliders[a]->__id > __colliders[b]->__id) std::swap(a, b);
+            float dx = __center_x[b] - __center_x[a], dy = __center_y[b] - __center_y[a];
+            float sign_x = dx < 0.0f ? -1.0f : 1.0f, sign_y = dy < 0.0f ? -1.0f : 1.0f;
+            float gap_x = fabsf(dx) - (__half_x[a] + __half_x[b]);
+            float gap_y = fabsf(dy) - (__half_y[a] + __half_y[b]);
+            float radius = __radius[a] + __radius[b];
+
+            Contact contact;
+            if (gap_x > 0.0f || gap_y > 0.0f) {
+                // The cores are apart, the distance between the cores must be less than the radius.
+                float distance_x = ENGINE_MAX(0.0f, gap_x), distance_y = ENGINE_MAX(0.0f, gap_y);
+                float distance_squared = distance_x * distance_x + distance_y * distance_y;
+                if (distance_squared >= radius * radius) return;
+                float distance = sqrtf(distance_squared);
+                contact.Normal = Vec2f(distance_x * sign_x / distance, distance_y * sign_y / distance);
+                contact.Depth = radius - distance;
+            }
+            else {
+                // The cores overlap, separate along the axis with the least overlap.
+                if (gap_x > gap_y) { contact.Normal = Vec2f(sign_x, 0.0f); contact.Depth = radius - gap_x; }
+                else { contact.Normal = Vec2f(0.0f, sign_y); contact.Depth = radius - gap_y; }
+                if (contact.Depth <= 0.0f) return;
+            }
+            // The contact point is halfway between the closest surface points of A and B.
+            Vec2f point_a = Vec2f(
+                __center_x[a] + ENGINE_FAST_CLAMP(-__half_x[a], __half_x[a], dx),
+                __center_y[a] + ENGINE_FAST_CLAMP(-__half_y[a], __half_y[a], dy)) + contact.Normal * __radius[a];
+            Vec2f point_b = Vec2f(
+                __center_x[b] + ENGINE_FAST_CLAMP(-__half_x[b], __half_x[b], -dx),
+                __center_y[b] + ENGINE_FAST_CLAMP(-__half_y[b], __half_y[b], -dy)) - contact.Normal * __radius[b];
+            contact.Point = (point_a + point_b) * 0.5f;
+            contact.A = __colliders[a]; contact.B = __colliders[b];
+            if ((contact.A->PixelMask || contact.B->PixelMask) && !__is_masks_overlapped(a, b)) return;
+            __contacts.push_back(contact);
+        }
+        /// @brief Sort the contacts and add the started and ended contacts.
+        static void __finish_detect() {
+            auto compare = [](const Contact& a, const Contact& b) { return __key(a) < __key(b); };
+            std::sort(__contacts.begin(), __contacts.end(), compare);
+            std::set_difference(__contacts.begin(), __contacts.end(), __previous_contacts.begin(), __previous_contacts.end(),
+                std::back_inserter(__begin_contacts), compare);
+            std::set_difference(__previous_contacts.begin(), __previous_contacts.end(), __contacts.begin(), __contacts.end(),
+                std::back_inserter(__end_contacts), compare);
+        }
+    public:
+        /// @brief The height of the sweep bands, relative to the average height of the colliders. A smaller factor mean
+        /// more bands with less colliders each, but more colliders are in more than one band. Default is 4.
+        static float BandSizeFactor;
+
+        /// @brief Occurred on Update() with the contacts that started on this frame.
+        static CollisionEventCaller ContactBeginEvent;
+        /// @brief Occurred on Update() with all current contacts (including the started ones).
+        static CollisionEventCaller ContactStayEvent;
+        /// @brief Occurred on Update() with the contacts that ended on this frame (the Depth and Point are of the last frame).
+        static CollisionEventCaller ContactEndEvent;
+
+        /// @brief Detect the contacts between all colliders without raising the events. The started and ended contacts are
+        /// kept until the next Update(), so the contacts of the physics steps are reported too. This is called by Update()
+        /// and Physics::Step().
+        static void Detect() {
+            __compact();
+            __is_detected = true;
+            std::swap(__contacts, __previous_contacts);
+            __contacts.clear();
+
+            const uint32_t count = (uint32_t)__colliders.size();
+            for (uint32_t i = 0; i < count; i++) {
+                if (__colliders[i] && __colliders[i]->__target) __update_proxy(i);
+            }
+            __sort_order();
+            __sorted_count = __order.size();
+
+            // Split the space into horizontal bands, a collider is in each band it overlaps. The bands are filled in the
+            // sorted order, so each band is sorted by the left side too, and only sweep over the colliders of the band.
+            float top = INFINITY, bottom = -INFINITY, total_height = 0.0f;
+            uint32_t active_count = 0;
+            __active.resize(count);
+            for (uint32_t i = 0; i < count; i++) {
+                ColliderScript* collider = __colliders[i];
+                __active[i] = collider && collider->Enabled && collider->__target && collider->__target->Enabled && collider->Layer;
+                if (!__active[i]) continue;
+                top = ENGINE_MIN(top, __min_y[i]); bottom = ENGINE_MAX(bottom, __max_y[i]);
+                total_height += __max_y[i] - __min_y[i];
+                active_count++;
+            }
+            __entries.clear();
+            if (active_count < 2) { __band_offsets.assign(1, 0); __finish_detect(); return; }
+
+            float band_height = ENGINE_MAX(total_height / active_count * Collision::BandSizeFactor,
+                (bottom - top) / ENGINE_COLLISION_MAX_BAND_COUNT);
+            band_height = ENGINE_MAX(band_height, 1e-3f);
+            const float inverse_band_height = 1.0f / band_height;
+            const uint32_t band_count = ENGINE_MIN((uint32_t)ENGINE_COLLISION_MAX_BAND_COUNT,
+                (uint32_t)((bottom - top) * inverse_band_height) + 1);
+            auto band_of = [top, inverse_band_height, band_count](float y) {
+                return ENGINE_MIN(band_count - 1, (uint32_t)ENGINE_MAX(0.0f, (y - top) * inverse_band_height));
+            };
+
+            __band_offsets.assign(band_count + 1, 0);
+            for (uint32_t i : __order) {
+                if (!__active[i]) continue;
+                for (uint32_t band = band_of(__min_y[i]), last = band_of(__max_y[i]); band <= last; band++)
+                    __band_offsets[band + 1]++;
+            }
+            for (uint32_t band = 0; band < band_count; band++) __band_offsets[band + 1] += __band_offsets[band];
+            __entries.resize(__band_offsets[band_count]);
+            __band_cursors.assign(__band_offsets.begin(), __band_offsets.end() - 1);
+            for (uint32_t i : __order) {
+                if (!__active[i]) continue;
+                __entry entry = { __min_x[i], __max_x[i], __min_y[i], __max_y[i], i };
+                for (uint32_t band = band_of(__min_y[i]), last = band_of(__max_y[i]); band <= last; band++)
+                    __entries[__band_cursors[band]++] = entry;
+            }
+
+            // Sweep each band along the X axis. A pair may share more than one band, so it's only tested in the band of
+            // the top of their overlap.
+            const __entry* entries = __entries.data();
+            for (uint32_t band = 0; band < band_count; band++) {
+                const uint32_t end = __band_offsets[band + 1];
+                for (uint32_t k = __band_offsets[band]; k < end; k++) {
+                    const __entry& a = entries[k];
+                    for (uint32_t l = k + 1; l < end && entries[l].min_x <= a.max_x; l++) {
+                        const __entry& b = entries[l];
+                        if (b.min_y > a.max_y || b.max_y < a.min_y) continue;
+                        if (band_of(ENGINE_MAX(a.min_y, b.min_y)) != band) continue;
+                        const ColliderScript* collider_a = __colliders[a.index], * collider_b = __colliders[b.index];
+                        if (!(collider_a->Layer & collider_b->Mask) || !(collider_b->Layer & collider_a->Mask)) continue;
+                        __narrowphase(a.index, b.index);
+                    }
+                }
+            }
+            __finish_detect();
+        }
+        /// @brief Detect the contacts between all colliders and raise the events. This is called by Application::Start()
+        /// after updating the Game Scene. If Physics::Step() detected the contacts on this frame already, they are reused
+        /// instead of running the broadphase again (so they are as of the last physics step).
+        static void Update() {
+            if (!__is_detected) Detect();
+            else __compact();
+            __is_dispatching = true;
+            CollisionEventArgs args;
+            if (!__begin_contacts.empty()) {
+                args.Contacts = __begin_contacts.data(); args.Count = __begin_contacts.size();
+                ContactBeginEvent.Call(&args);
+                __sweep_marked_contacts();
+            }
+            if (!__contacts.empty()) {
+                args.Contacts = __contacts.data(); args.Count = __contacts.size();
+                ContactStayEvent.Call(&args);
+                __sweep_marked_contacts();
+            }
+            if (!__end_contacts.empty()) {
+                args.Contacts = __end_contacts.data(); args.Count = __end_contacts.size();
+                ContactEndEvent.Call(&args);
+                __sweep_marked_contacts();
+            }
+            __is_dispatching = false;
+            __is_detected = false;
+            __begin_contacts.clear(); __end_contacts.clear();
+        }
+
+        /// @brief Get all current contacts, as of the last Update().
+        /// @return The current contacts, ordered by the colliders.
+        static const std::vector<Contact>& GetContacts() { __compact(); return __contacts; }
+        /// @brief Get the number of colliders.
+        /// @return The number of attached colliders.
+        static size_t GetColliderCount() { return __colliders.size() - __removed_colliders.size(); }
+        /// @brief Find all enabled colliders which bounds intersect the given area, as of the last Update().
+        /// @param Area The area to query.
+        /// @param Result The vector to add the found colliders to.
+        /// @param Mask The layers to find. Default is all layers.
+        /// @return The number of colliders found.
+        static size_t Query(const RectF& Area, std::vector<ColliderScript*>& Result, uint32_t Mask = UINT32_MAX) {
+            size_t found = 0;
+            auto test = [&Area, &Result, Mask, &found](uint32_t i) {
+                if (__max_x[i] < Area.Left() || __min_y[i] > Area.Bottom() || __max_y[i] < Area.Top()) return;
+                ColliderScript* collider = __colliders[i];
+                if (!collider || !(collider->Layer & Mask) || !collider->Enabled || !collider->__target->Enabled) return;
+                Result.push_back(collider);
+                found++;
+            };
+            const size_t sorted_count = ENGINE_MIN(__sorted_count, __order.size());
+            for (size_t k = 0; k < sorted_count; k++) {
+                uint32_t i = __order[k];
+                if (__min_x[i] > Area.Right()) break;
+                test(i);
+            }
+            // The colliders added since the last Detect() are not sorted and have no bounds yet.
+            for (size_t k = sorted_count; k < __order.size(); k++) {
+                uint32_t i = __order[k];
+                if (!__colliders[i] || !__colliders[i]->__target) continue;
+                __update_proxy(i);
+                if (__min_x[i] <= Area.Right()) test(i);
+            }
+            return found;
+        }
+        /// @brief Remove all colliders from the collision detection, and clear all contacts. This is called by
+        /// Deinitialize().
+        static void RemoveAllColliders() {
+            for (ColliderScript* collider : __colliders)
+                if (collider) { collider->__proxy = UINT32_MAX; collider->__body = nullptr; }
+            __colliders.clear(); __order.clear(); __removed_colliders.clear();
+            __sorted_count = 0; __is_detected = false;
+            __version++;
+            for (std::vector<float>* array : { &__center_x, &__center_y, &__half_x, &__half_y, &__radius,
+                                               &__min_x, &__min_y, &__max_x, &__max_y })
+                array->clear();
+            __entries.clear(); __band_offsets.clear(); __band_cursors.clear(); __active.clear();
+            __contacts.clear(); __previous_contacts.clear(); __begin_contacts.clear(); __end_contacts.clear();
+        }
+    };
+}
+
+void Engine::ColliderScript::OnStart(GameObject* Target) {
+    __target = Target;
+    Collision::__add(this);
+}
+void Engine::ColliderScript::OnStop(GameObject* Target) {
+    Collision::__remove(this);
+    __target = nullptr;
+}
+Engine::ColliderScript::~ColliderScript() { Collision::__remove(this); }
+Engine::RectF Engine::ColliderScript::GetBounds() const {
+    if (__proxy == UINT32_MAX) return RectF();
+    return RectF(Collision::__min_x[__proxy], Collision::__min_y[__proxy],
+        Collision::__max_x[__proxy] - Collision::__min_x[__proxy], Collision::__max_y[__proxy] - Collision::__min_y[__proxy]);
+}
+
+std::vector<Engine::ColliderScript*> Engine::Collision::__colliders = std::vector<Engine::ColliderScript*>();
+std::vector<float> Engine::Collision::__center_x = std::vector<float>();
+std::vector<float> Engine::Collision::__center_y = std::vector<float>();
+std::vector<float> Engine::Collision::__half_x = std::vector<float>();
+std::vector<float> Engine::Collision::__half_y = std::vector<float>();
+std::vector<float> Engine::Collision::__radius = std::vector<float>();
+std::vector<float> Engine::Collision::__min_x = std::vector<float>();
+std::vector<float> Engine::Collision::__min_y = std::vector<float>();
+std::vector<float> Engine::Collision::__max_x = std::vector<float>();
+std::vector<float> Engine::Collision::__max_y = std::vector<float>();
+std::vector<uint32_t> Engine::Collision::__order = std::vector<uint32_t>();
+size_t Engine::Collision::__sorted_count = 0;
+std::vector<Engine::ColliderScript*> Engine::Collision::__removed_colliders = std::vector<Engine::ColliderScript*>();
+std::vector<Engine::Collision::__entry> Engine::Collision::__entries = std::vector<Engine::Collision::__entry>();
+std::vector<uint32_t> Engine::Collision::__band_offsets = std::vector<uint32_t>();
+std::vector<uint32_t> Engine::Collision::__band_cursors = std::vector<uint32_t>();
+std::vector<uint8_t> Engine::Collision::__active = std::vector<uint8_t>();
+std::vector<Engine::Contact> Engine::Collision::__contacts = std::vector<Engine::Contact>();
+std::vector<Engine::Contact> Engine::Collision::__previous_contacts = std::vector<Engine::Contact>();
+std::vector<Engine::Contact> Engine::Collision::__begin_contacts = std::vector<Engine::Contact>();
+std::vector<Engine::Contact> Engine::Collision::__end_contacts = std::vector<Engine::Contact>();
+uint32_t Engine::Collision::__next_id = 0;
+uint32_t Engine::Collision::__version = 0;
+bool Engine::Collision::__is_dispatching = false;
+bool Engine::Collision::__has_marked_contacts = false;
+bool Engine::Collision::__is_detected = false;
+float Engine::Collision::BandSizeFactor = 4.0f;
+Engine::CollisionEventCaller Engine::Collision::ContactBeginEvent = Engine::CollisionEventCaller();
+Engine::CollisionEventCaller Engine::Collision::ContactStayEvent = Engine::CollisionEventCaller();
+Engine::CollisionEventCaller Engine::Collision::ContactEndEvent = Engine::CollisionEventCaller();
+
+#endif // __ENGINE_COLLISION_H__
\ No newline at end of file
@@ -0,0 +1,306 @@
+#ifndef __ENGINE_COROUTINE_H__
+#define __ENGINE_COROUTINE_H__
+
+#include "Engine_Animation.h"
+#include "Engine_Define.h"
+#include "Engine_GameObject.h"
+#include "Engine_Timer.h"
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// The number of block sizes of the Coroutine Frame Pool (64, 128, ..., 4096 bytes).
+#define ENGINE_COROUTINE_POOL_CLASS_COUNT 7
+// The number of blocks allocated at once for each block size of the Coroutine Frame Pool.
+#define ENGINE_COROUTINE_POOL_CHUNK_BLOCKS 32
+
+namespace Engine {
+    class CoroutineScript;
+
+    /// @brief The Coroutine Frame Pool class, provide the memory of the coroutine frames of the Coroutine Scripts. The
+    /// frames are taken from free lists of fixed size blocks, and given back to them when the coroutine is done, so
+    /// starting a coroutine don't allocate once the pool is warm. The blocks are never freed. Frames bigger than the
+    /// biggest block size are allocated with the global operator new.
+    /// @note Used on the main thread only.
+    class CoroutineFramePool final {
+    private:
+        struct __block {
+            __block* next;
+        };
+
+        static __block* __free_blocks[ENGINE_COROUTINE_POOL_CLASS_COUNT];
+        static std::vector<std::unique_ptr<char[]>> __chunks;
+        static size_t __used_count;
+
+        static int __class_of(size_t size) {
+            int index = 0;
+            for (size_t block_size = 64; block_size < size; block_size <<= 1) index++;
+            return index;
+        }
+    public:
+        /// @brief Allocate a block for a coroutine frame.
+        /// @param Size The size of the frame in bytes.
+        /// @return The block.
+        static void* Allocate(size_t Size) {
+            int index = __class_of(Size);
+            if (index >= ENGINE_COROUTINE_POOL_CLASS_COUNT) return ::operator new(Size);
+            if (!CoroutineFramePool::__free_blocks[index]) {
+                size_t block_size = (size_t)64 << index;
+                CoroutineFramePool::__chunks.emplace_back(new char[block_size * ENGINE_COROUTINE_POOL_CHUNK_BLOCKS]);
+                char* chunk = CoroutineFramePool::__chunks.back().get();
+                for (int i = ENGINE_COROUTINE_POOL_CHUNK_BLOCKS - 1; i >= 0; i--) {
+                    __block* block = (__block*)(chunk + block_size * i);
+                    block->next = CoroutineFramePool::__free_blocks[index];
+                    CoroutineFramePool::__free_blocks[index] = block;
+                }
+            }
+            __block* block = CoroutineFramePool::__free_blocks[index];
+            CoroutineFramePool::__free_blocks[index] = block->next;
+            CoroutineFramePool::__used_count++;
+            return block;
+        }
+        /// @brief Give back a block allocated with Allocate().
+        /// @param Block The block to give back.
+        /// @param Size The size given to Allocate().
+        static void Deallocate(void* Block, size_t Size) {
+            if (!Block) return;
+            int index = __class_of(Size);
+            if (index >= ENGINE_COROUTINE_POOL_CLASS_COUNT) { ::operator delete(Block); return; }
+            __block* block = (__block*)Block;
+            block->next = CoroutineFramePool::__free_blocks[index];
+            CoroutineFramePool::__free_blocks[index] = block;
+            CoroutineFramePool::__used_count--;
+        }
+        /// @brief Get the number of pooled blocks in use.
+        /// @return The number of blocks in use.
+        static size_t GetUsedCount() { return CoroutineFramePool::__used_count; }
+    };
+
+    /// @brief The Script Task class, the return type of the coroutines of a Coroutine Script (the OnRun() body, and
+    /// the member coroutines it co_await as sub-steps).
+    class ScriptTask {
+        friend class CoroutineScript;
+    public:
+        struct promise_type;
+    private:
+        struct __final_awaiter {
+            bool await_ready() const noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+            void await_resume() const noexcept {}
+        };
+
+        std::coroutine_handle<promise_type> __handle = nullptr;
+
+        explicit ScriptTask(std::coroutine_handle<promise_type> handle) : __handle(handle) {}
+    public:
+        struct promise_type {
+            /// @brief The outermost coroutine of the chain, own the Coroutine Script.
+            std::coroutine_handle<promise_type> root = nullptr;
+            /// @brief The coroutine awaiting this one, or null for the root.
+            std::coroutine_handle<> continuation = nullptr;
+            /// @brief The Coroutine Script running the chain (set on the root only), null if stopped while running.
+            CoroutineScript* script = nullptr;
+
+            ScriptTask get_return_object() noexcept { return ScriptTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            __final_awaiter final_suspend() const noexcept { return {}; }
+            void return_void() const noexcept {}
+            void unhandled_exception() const noexcept { std::terminate(); }
+
+            static void* operator new(size_t size) { return CoroutineFramePool::Allocate(size); }
+            static void operator delete(void* block, size_t size) { CoroutineFramePool::Deallocate(block, size); }
+        };
+
+        ~ScriptTask() { if (__handle) __handle.destroy(); }
+
+        ENGINE_NOT_COPYABLE(ScriptTask)
+        ENGINE_NOT_ASSIGNABLE(ScriptTask)
+
+        // Awaiting a Script Task run it as a sub-step of the awaiting coroutine.
+        bool await_ready() const noexcept { return !__handle || __handle.done(); }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> awaiting) noexcept {
+            __handle.promise().root = awaiting.promise().root;
+            __handle.promise().continuation = awaiting;
+            return __handle;
+        }
+        void await_resume() const noexcept {}
+    };
+
+    /// @brief The Coroutine Script class, provide a base class to create a script as a coroutine (OnRun()), for multi-step
+    /// behaviors without state machines. The coroutine is started when the script is added to the Game Object, and can
+    /// co_await NextFrame(), Frames(), Seconds(), Until(), AnimationFinished() or another Script Task. While suspended,
+    /// the coroutine is parked on the Timer (or on the Animation Script) and do nothing on each frame; it's resumed by
+    /// Timer::Update(), before updating the Game Scene.
+    /// @note Overriding OnStart() or OnStop() should call the base one.
+    class CoroutineScript : public GameScript {
+        friend class ScriptTask;
+    private:
+        using __handle_t = std::coroutine_handle<ScriptTask::promise_type>;
+
+        struct __frames_awaiter {
+            uint64_t frames;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(__handle_t handle) {
+                CoroutineScript* script = __park(handle);
+                if (!script) return;
+                script->__wait_timer = Timer::AfterFrames(frames, [script]() { script->__wait_timer = 0; script->__resume(); });
+            }
+            void await_resume() const noexcept {}
+        };
+        struct __seconds_awaiter {
+            double seconds;
+            bool await_ready() const noexcept { return seconds <= 0; }
+            void await_suspend(__handle_t handle) {
+                CoroutineScript* script = __park(handle);
+                if (!script) return;
+                script->__wait_timer = Timer::After(seconds, [script]() { script->__wait_timer = 0; script->__resume(); });
+            }
+            void await_resume() const noexcept {}
+        };
+        struct __until_awaiter {
+            std::function<bool()> predicate;
+            bool await_ready() { return !predicate || predicate(); }
+            void await_suspend(__handle_t handle) {
+                CoroutineScript* script = __park(handle);
+                if (!script) return;
+                // Checked once per frame by the Timer, the awaiter live in the suspended frame.
+                script->__wait_timer = Timer::EveryFrames(1, [script, this]() {
+                    if (!predicate()) return;
+                    Timer::Cancel(script->__wait_timer);
+                    script->__wait_timer = 0;
+                    script->__resume();
+                });
+            }
+            void await_resume() const noexcept {}
+        };
+        struct __animation_awaiter {
+            AnimationScript* animation;
+            bool await_ready() const { return !AnimationScript::IsCreated(animation) || !animation->IsStarted(); }
+            void await_suspend(__handle_t handle) {
+                CoroutineScript* script = __park(handle);
+                if (!script) return;
+                script->__wait_animation = animation;
+                script->__wait_action = animation->AddStopAction([script]() {
+                    script->__wait_animation = nullptr; script->__wait_action = 0;
+                    // Resumed by the Timer, not inside the update of the Animation Script.
+                    script->__wait_timer = Timer::After(0, [script]() { script->__wait_timer = 0; script->__resume(); });
+                });
+            }
+            void await_resume() const noexcept {}
+        };
+
+        __handle_t __root = nullptr;
+        std::coroutine_handle<> __suspended = nullptr;
+        TimerID __wait_timer = 0;
+        AnimationScript* __wait_animation = nullptr;
+        uint64_t __wait_action = 0;
+        GameObject* __target = nullptr;
+        bool __is_resuming = false;
+
+        /// @brief Record the suspended coroutine, or destroy the chain if the script is stopped while it was running.
+        /// @return The Coroutine Script to park on, or null if the chain is destroyed.
+        static CoroutineScript* __park(__handle_t handle) {
+            __handle_t root = handle.promise().root;
+            CoroutineScript* script = root.promise().script;
+            if (!script) { root.destroy(); return nullptr; }
+            script->__suspended = handle;
+            script->__is_resuming = false;
+            return script;
+        }
+        /// @brief Resume the suspended coroutine. The script is not touched after, the coroutine may destroy it.
+        void __resume() {
+            std::coroutine_handle<> handle = __suspended;
+            __suspended = nullptr;
+            if (!handle) return;
+            __is_resuming = true;
+            handle.resume();
+        }
+        void __cancel_wait() {
+            if (__wait_timer) { Timer::Cancel(__wait_timer); __wait_timer = 0; }
+            if (__wait_animation && AnimationScript::IsCreated(__wait_animation))
+                __wait_animation->RemoveStopAction(__wait_action);
+            __wait_animation = nullptr; __wait_action = 0;
+            __suspended = nullptr;
+        }
+    protected:
+        /// @brief The body of the Coroutine Script, a coroutine started when the script is added to the Game Object.
+        /// @param Target The target Game Object of the script.
+        /// @return The Script Task of the coroutine.
+        virtual ScriptTask OnRun(GameObject* Target) = 0;
+
+        /// @brief Wait until the next frame.
+        static __frames_awaiter NextFrame() { return __frames_awaiter{ 1 }; }
+        /// @brief Wait for the given number of frames.
+        /// @param Count The number of frames, will clamped to be at least 1.
+        static __frames_awaiter Frames(uint64_t Count) { return __frames_awaiter{ Count }; }
+        /// @brief Wait for the given time.
+        /// @param Time The time in seconds, don't wait if non-positive.
+        static __seconds_awaiter Seconds(double Time) { return __seconds_awaiter{ Time }; }
+        /// @brief Wait until the given predicate is true, checked once per frame.
+        /// @param Predicate The predicate, don't wait if it's true already (or empty).
+        static __until_awaiter Until(const std::function<bool()>& Predicate) { return __until_awaiter{ Predicate }; }
+        /// @brief Wait until the given Animation Script finish playing, is stopped with StopAnimation() or is destroyed.
+        /// @param Animation The Animation Script, don't wait if it's not started (or destroyed).
+        static __animation_awaiter AnimationFinished(AnimationScript* Animation) { return __animation_awaiter{ Animation }; }
+    public:
+        CoroutineScript() = default;
+        virtual ~CoroutineScript() { Stop(); }
+
+        ENGINE_NOT_COPYABLE(CoroutineScript)
+        ENGINE_NOT_ASSIGNABLE(CoroutineScript)
+
+        void OnStart(GameObject* Target) override { __target = Target; Restart(); }
+        void OnStop(GameObject* Target) override { Stop(); }
+
+        /// @brief Check if the coroutine is running (started and not finished or stopped).
+        /// @return true if the coroutine is running, false otherwise.
+        bool IsRunning() const { return (bool)__root; }
+        /// @brief Stop the coroutine, and start it again from the beginning.
+        void Restart() {
+            Stop();
+            ScriptTask task = OnRun(__target);
+            if (!task.__handle) return;
+            __root = task.__handle;
+            task.__handle = nullptr;
+            __root.promise().root = __root;
+            __root.promise().script = this;
+            __is_resuming = true;
+            __root.resume();
+        }
+        /// @brief Stop the coroutine. If called from the coroutine itself, it's destroyed on its next co_await.
+        void Stop() {
+            __cancel_wait();
+            if (!__root) return;
+            if (__is_resuming) __root.promise().script = nullptr;
+            else __root.destroy();
+            __root = nullptr;
+            __is_resuming = false;
+        }
+    };
+}
+
+std::coroutine_handle<> Engine::ScriptTask::__final_awaiter::await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+    promise_type& promise = handle.promise();
+    if (promise.continuation) return promise.continuation;
+    // The root is done, the frame is given back to the pool right away.
+    if (promise.script) {
+        promise.script->__root = nullptr;
+        promise.script->__is_resuming = false;
+    }
+    handle.destroy();
+    return std::noop_coroutine();
+}
+
+Engine::CoroutineFramePool::__block* Engine::CoroutineFramePool::__free_blocks[ENGINE_COROUTINE_POOL_CLASS_COUNT] = {};
+std::vector<std::unique_ptr<char[]>> Engine::CoroutineFramePool::__chunks = std::vector<std::unique_ptr<char[]>>();
+size_t Engine::CoroutineFramePool::__used_count = 0;
+
+#endif // defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#endif // __ENGINE_COROUTINE_H__
\ No newline at end of file
@@ -6,109 +6,28 @@
 
 #include <SDL2/SDL_ttf.h>
 #include <unordered_map>
+#include <vector>
 
 namespace Engine {
     /// @brief The Font class, provide a base class to create an Engine font.
     class Font {
+        friend class TextBoxGameObject;
     private:
         int __min_line_height = 0;
         int __letter_spacing = 0;
 
         static bool __is_destroy_all;
         static std::unordered_set<Font*> __created_fonts;
-    protected:
-        /// @brief Get the texture of a single character.
-        /// @param character The character to query.
-        /// @return The texture of the given character, or nullptr if there's none.
-        /// @note On overriding, this should return an grayscale texture 
-        virtual Texture* GetCharacterTexture(char character) = 0;
-        /// @brief Get the texture size of a single character.
-        /// @param character The character to query.
-        /// @return The texture size of the given character, or Size::Zero if there's none.
-        virtual Size GetCharacterTextureSize(char character) {
-            Texture* text = GetCharacterTexture(character);
-            return text ? text->GetSize() : Size::Zero;
-        }
-    public:
-        /// @brief The name of the Font. Default is "Font".
-        std::string Name = "Font";
 
-        Font() { Font::__created_fonts.insert(this); }
-        virtual ~Font() {
-            if (!Font::__is_destroy_all)
-                Font::__created_fonts.erase(this);
+        /// @brief Draw a character texture at the given position, in the space of the given transform (or in the drawing area
+        /// if there's none).
+        static void __draw_character(const Point& Position, Texture* c_texture, const Mat3x2f* Transform) {
+            if (!Transform) { Renderer::DrawTexture(Position, c_texture); return; }
+            Size c_tex_size = c_texture->GetSize();
+            Renderer::DrawTexture(*Transform,
+                RectF((float)Position.X, (float)Position.Y, (float)c_tex_size.Width, (float)c_tex_size.Height), c_texture);
         }
-
-        ENGINE_NOT_COPYABLE(Font)
-        ENGINE_NOT_ASSIGNABLE(Font)
-
-        //TODO: Probably add render with wrapping (on newline and reach max width).
-
-        /// @brief Get the minimum height in pixels of a line when rendering with this Font.
-        /// @return The minimum height of a line when rendering with this Font. 0 on default.
-        int GetLineMinimumHeight() const { return __min_line_height; }
-        /// @brief Set the minimum height in pixels of a line when rendering with this Font.
-        /// @param min_line_height The minimum height to set, will clamped to be at least 0.
-        void SetLineMinimumHeight(int min_line_height) { __min_line_height = min_line_height < 0 ? 0 : min_line_height; }
-
-        /// @brief Get the distance in pixels between two consecutive letter when rendering with this Font.
-        /// @return The distance in pixels between two consecutive letter when rendering with this Font. 0 on default.
-        int GetLetterSpacing() const { return __letter_spacing; }
-        /// @brief Get the distance in pixels between two consecutive letter when rendering with this Font.
-        /// @param spacing The spacing distance to set, will be clamped to be at least 0.
-        void SetLetterSpacing(int spacing) { __letter_spacing = spacing < 0 ? 0 : spacing; }
-
-        /// @brief Calculate the possible output size when rendering the given text with this Font on a single line (meaning
-        /// will not go to newline when met the newline '\n' character).
-        /// @param Text The text to calculate the output size.
-        /// @return The result of the calculation. Or Size::Zero if the given text is empty.
-        virtual Size CalculateOutputSizeSingleLine(const std::string& Text) {
-            if (Text.empty())
-                return Size::Zero;
-            int res_w = 0, res_h = __min_line_height;
-
-            for (char c : Text) {
-                Size c_size = GetCharacterTextureSize(c);
-                res_w += c_size.Width + __letter_spacing;
-                res_h = ENGINE_MAX(res_h, c_size.Height);
-            }
-
-            return Size(res_w - __letter_spacing, res_h);
-        }
-        /// @brief Calculate the possible output size when rendering the given text with newline wrapping (meaning will go to newline
-        /// when met the newline '\n' character).
-        /// @param Text The text to calculate the output size.
-        /// @return The result of the calculation. Or Size::Zero if the given text is empty.
-        virtual Size CalculateOutputSizeMultiline(const std::string& Text) {
-            if (Text.empty())
-                return Size::Zero;
-            int res_w = 0, res_h = __min_line_height;
-            int curr_x = 0, curr_y = 0;
-
-            for (char c : Text) {
-                if (c == '\n') {
-                    curr_x = 0; curr_y = res_h;
-                    res_h += __min_line_height;
-                    continue;
-                }
-                Size c_size = GetCharacterTextureSize(c);
-                curr_x += c_size.Width + __letter_spacing;
-                if (res_w < curr_x)
-                    res_w = curr_x;
-                res_h = ENGINE_MAX(res_h, curr_y + c_size.Height);
-            }
-            res_w -= __letter_spacing;
-            return Size(res_w < 0 ? 0 : res_w, res_h);
-        }
-
-        /// @brief Render the given text with this Font on a single line (meaning will not go to newline when met the newline '\n'
-        /// character).
-        /// @param Text The text to render.
-        /// @param Position The position of the top-left corner of the text area to render.
-        /// @param ModColor The additional color value that will be multiply for each pixel from the original character texture on
-        /// rendering operation (draw_color = source_color * (mod_color / 255)). This can be treated as foreground color of the text
-        /// if the texture of each character of the text is grayscale texture. Default is White (255, 255, 255, 255).
-        virtual void RenderSingleLine(const std::string& Text, const Point& Position, Color ModColor = KnownColor::White) {
+        void __render_single_line(const std::string& Text, const Point& Position, Color ModColor, const Mat3x2f* Transform) {
             if (Text.empty()) return;
             
             int target_height = __min_line_height;
@@ -142,17 +61,14 @@ namespace Engine {
                 Color curr_mod = c_texture->GetColorMod();
                 c_texture->SetColorMod(ModColor);
 
-                Renderer::DrawTexture(
-                    Point(curr_x, Position.Y + (target_height - c_tex_size.Height)),
-                    c_texture);
+                __draw_character(Point(curr_x, Position.Y + (target_height - c_tex_size.Height)), c_texture, Transform);
 
                 c_texture->SetColorMod(curr_mod);
                 
                 curr_x += c_tex_size.Width + __letter_spacing;
             }
         }
-
-        virtual void RenderMultiline(const std::string& Text, const Point& Position, Color ModColor = KnownColor::White) {
+        void __render_multiline(const std::string& Text, const Point& Position, Color ModColor, const Mat3x2f* Transform) {
             if (Text.empty()) return;
 
             int curr_y = Position.Y;
@@ -201,7 +117,7 @@ namespace Engine {
                     Color curr_mod = c_texture->GetColorMod();
                     c_texture->SetColorMod(ModColor);
 
-                    Renderer::DrawTexture(Point(curr_x, curr_y + (target_height - c_tex_size.Height)), c_texture);
+                    __draw_character(Point(curr_x, curr_y + (target_height - c_tex_size.Height)), c_texture, Transform);
 
                     c_texture->SetColorMod(curr_mod);
 
@@ -214,6 +130,141 @@ namespace Engine {
                 }
             }
         }
+    protected:
+        /// @brief Get the texture of a single character.
+        /// @param character The character to query.
+        /// @return The texture of the given character, or nullptr if there's none.
+        /// @note On overriding, this should return an grayscale texture 
+        virtual Texture* GetCharacterTexture(char character) = 0;
+        /// @brief Get the texture size of a single character.
+        /// @param character The character to query.
+        /// @return The texture size of the given character, or Size::Zero if there's none.
+        virtual Size GetCharacterTextureSize(char character) {
+            Texture* text = GetCharacterTexture(character);
+            return text ? text->GetSize() : Size::Zero;
+        }
+        /// @brief Get the texture of a single Unicode code point (of an UTF-8 text).
+        /// @param code_point The code point to query.
+        /// @return The texture of the given code point, or nullptr if there's none.
+        /// @note The default implementation use GetCharacterTexture(), the code points outside ASCII are shown as '?'.
+        virtual Texture* GetGlyphTexture(uint32_t code_point) {
+            return GetCharacterTexture(code_point < 0x80 ? (char)code_point : '?');
+        }
+        /// @brief Get the texture size of a single Unicode code point (of an UTF-8 text).
+        /// @param code_point The code point to query.
+        /// @return The texture size of the given code point, or Size::Zero if there's none.
+        virtual Size GetGlyphTextureSize(uint32_t code_point) {
+            return GetCharacterTextureSize(code_point < 0x80 ? (char)code_point : '?');
+        }
+    public:
+        /// @brief The name of the Font. Default is "Font".
+        std::string Name = "Font";
+
+        Font() { Font::__created_fonts.insert(this); }
+        virtual ~Font() {
+            if (!Font::__is_destroy_all)
+                Font::__created_fonts.erase(this);
+        }
+
+        ENGINE_NOT_COPYABLE(Font)
+        ENGINE_NOT_ASSIGNABLE(Font)
+
+        //TODO: Probably add render with wrapping (on newline and reach max width).
+
+        /// @brief Get the minimum height in pixels of a line when rendering with this Font.
+        /// @return The minimum height of a line when rendering with this Font. 0 on default.
+        int GetLineMinimumHeight() const { return __min_line_height; }
+        /// @brief Set the minimum height in pixels of a line when rendering with this Font.
+        /// @param min_line_height The minimum height to set, will clamped to be at least 0.
+        void SetLineMinimumHeight(int min_line_height) { __min_line_height = min_line_height < 0 ? 0 : min_line_height; }
+
+        /// @brief Get the distance in pixels between two consecutive letter when rendering with this Font.
+        /// @return The distance in pixels between two consecutive letter when rendering with this Font. 0 on default.
+        int GetLetterSpacing() const { return __letter_spacing; }
+        /// @brief Get the distance in pixels between two consecutive letter when rendering with this Font.
+        /// @param spacing The spacing distance to set, will be clamped to be at least 0.
+        void SetLetterSpacing(int spacing) { __letter_spacing = spacing < 0 ? 0 : spacing; }
+
+        /// @brief Calculate the possible output size when rendering the given text with this Font on a single line (meaning
+        /// will not go to newline when met the newline '\n' character).
+        /// @param Text The text to calculate the output size.
+        /// @return The result of the calculation. Or Size::Zero if the given text is empty.
+        virtual Size CalculateOutputSizeSingleLine(const std::string& Text) {
+            if (Text.empty())
+                return Size::Zero;
+            int res_w = 0, res_h = __min_line_height;
+
+            for (char c : Text) {
+                Size c_size = GetCharacterTextureSize(c);
+                res_w += c_size.Width + __letter_spacing;
+                res_h = ENGINE_MAX(res_h, c_size.Height);
+            }
+
+            return Size(res_w - __letter_spacing, res_h);
+        }
+        /// @brief Calculate the possible output size when rendering the given text with newline wrapping (meaning will go to newline
+        /// when met the newline '\n' character).
+        /// @param Text The text to calculate the output size.
+        /// @return The result of the calculation. Or Size::Zero if the given text is empty.
+        virtual Size CalculateOutputSizeMultiline(const std::string& Text) {
+            if (Text.empty())
+                return Size::Zero;
+            int res_w = 0, res_h = __min_line_height;
+            int curr_x = 0, curr_y = 0;
+
+            for (char c : Text) {
+                if (c == '\n') {
+                    curr_x = 0; curr_y = res_h;
+                    res_h += __min_line_height;
+                    continue;
+                }
+                Size c_size = GetCharacterTextureSize(c);
+                curr_x += c_size.Width + __letter_spacing;
+                if (res_w < curr_x)
+                    res_w = curr_x;
+                res_h = ENGINE_MAX(res_h, curr_y + c_size.Height);
+            }
+            res_w -= __letter_spacing;
+            return Size(res_w < 0 ? 0 : res_w, res_h);
+        }
+
+        /// @brief Render the given text with this Font on a single line (meaning will not go to newline when met the newline '\n'
+        /// character).
+        /// @param Text The text to render.
+        /// @param Position The position of the top-left corner of the text area to render.
+        /// @param ModColor The additional color value that will be multiply for each pixel from the original character texture on
+        /// rendering operation (draw_color = source_color * (mod_color / 255)). This can be treated as foreground color of the text
+        /// if the texture of each character of the text is grayscale texture. Default is White (255, 255, 255, 255).
+        virtual void RenderSingleLine(const std::string& Text, const Point& Position, Color ModColor = KnownColor::White) {
+            __render_single_line(Text, Position, ModColor, nullptr);
+        }
+
+        virtual void RenderMultiline(const std::string& Text, const Point& Position, Color ModColor = KnownColor::White) {
+            __render_multiline(Text, Position, ModColor, nullptr);
+        }
+
+        /// @brief Render the given text with this Font on a single line, in the space of the given transform (the characters
+        /// are placed with sub-pixel precision, and rotated, scaled and flipped by the transform).
+        /// @param Text The text to render.
+        /// @param Transform The transform from the space of the text to the drawing area (e.g. RenderEventArgs::Transform).
+        /// @param Position The position of the top-left corner of the text area to render, before transformed. Default is (0, 0).
+        /// @param ModColor The additional color value that will be multiply for each pixel from the original character texture on
+        /// rendering operation. Default is White (255, 255, 255, 255).
+        virtual void RenderSingleLine(const std::string& Text, const Mat3x2f& Transform, const Point& Position = Point::Zero,
+            Color ModColor = KnownColor::White) {
+            __render_single_line(Text, Position, ModColor, &Transform);
+        }
+        /// @brief Render the given text with this Font on multiple lines, in the space of the given transform (the characters
+        /// are placed with sub-pixel precision, and rotated, scaled and flipped by the transform).
+        /// @param Text The text to render.
+        /// @param Transform The transform from the space of the text to the drawing area (e.g. RenderEventArgs::Transform).
+        /// @param Position The position of the top-left corner of the text area to render, before transformed. Default is (0, 0).
+        /// @param ModColor The additional color value that will be multiply for each pixel from the original character texture on
+        /// rendering operation. Default is White (255, 255, 255, 255).
+        virtual void RenderMultiline(const std::string& Text, const Mat3x2f& Transform, const Point& Position = Point::Zero,
+            Color ModColor = KnownColor::White) {
+            __render_multiline(Text, Position, ModColor, &Transform);
+        }
 
         /// @brief Execute an action for each created Font.
         /// @param action The action to execute.
@@ -356,15 +407,241 @@ namespace Engine {
         Strikethrough = TTF_STYLE_STRIKETHROUGH
     };
 
+    /// @brief The TTF Font Text Effect struct, describe the effect (outline, drop shadow) that baked into each glyph of a
+    /// TTFFont when the glyph is rasterized. Since the effect is baked, styled text is rendered in one pass.
+    struct TTFFontTextEffect {
+    public:
+        /// @brief The fill color of the glyph. Default is KnownColor::White.
+        Color FillColor = KnownColor::White;
+
+        /// @brief The size of the outline in pixels, or 0 (default) for no outline.
+        int OutlineSize = 0;
+        /// @brief The color of the outline. Default is KnownColor::Black.
+        Color OutlineColor = KnownColor::Black;
+
+        /// @brief The offset of the drop shadow from the glyph. Default is Point::Zero.
+        Point ShadowOffset = Point::Zero;
+        /// @brief The blur radius of the drop shadow in pixels. Default is 0 mean a hard shadow.
+        int ShadowBlurRadius = 0;
+        /// @brief The color of the drop shadow, or Color::Empty (default) for no shadow.
+        Color ShadowColor = Color::Empty;
+
+        /// @brief Check if the Text Effect has an outline.
+        /// @return true if the Text Effect has an outline, false otherwise.
+        bool HasOutline() const { return OutlineSize > 0 && OutlineColor.Alpha != 0; }
+        /// @brief Check if the Text Effect has a drop shadow.
+        /// @return true if the Text Effect has a drop shadow, false otherwise.
+        bool HasShadow() const { return ShadowColor.Alpha != 0 && (ShadowOffset != Point::Zero || ShadowBlurRadius > 0); }
+        /// @brief Check if the Text Effect has no effect (plain glyph).
+        /// @return true if the Text Effect has no effect, false otherwise.
+        bool IsEmpty() const { return !HasOutline() && !HasShadow(); }
+    };
+
     /// @brief The TTFFont class, provide a Font that using a true type font.
     class TTFFont : public Font {
     private:
         TTF_Font* __font = nullptr;
         std::unordered_map<char, Texture*> __char_textures;
         TTFFontRenderMethod __render_method = TTFFontRenderMethod::Soild;
+        std::unordered_map<char, Texture*> __effect_char_textures;
+        // The glyphs of the code points outside ASCII, rendered from UTF-8 (without the Text Effect).
+        std::unordered_map<uint32_t, Texture*> __glyph_textures;
+        TTFFontTextEffect __text_effect;
+
+        /// @brief Encode the given code point as UTF-8.
+        static std::string __encode_utf8(uint32_t code_point) {
+            std::string res;
+            if (code_point < 0x80) res.push_back((char)code_point);
+            else if (code_point < 0x800) {
+                res.push_back((char)(0xC0 | (code_point >> 6)));
+                res.push_back((char)(0x80 | (code_point & 0x3F)));
+            }
+            else if (code_point < 0x10000) {
+                res.push_back((char)(0xE0 | (code_point >> 12)));
+                res.push_back((char)(0x80 | ((code_point >> 6) & 0x3F)));
+                res.push_back((char)(0x80 | (code_point & 0x3F)));
+            }
+            else {
+                res.push_back((char)(0xF0 | ((code_point >> 18) & 0x07)));
+                res.push_back((char)(0x80 | ((code_point >> 12) & 0x3F)));
+                res.push_back((char)(0x80 | ((code_point >> 6) & 0x3F)));
+                res.push_back((char)(0x80 | (code_point & 0x3F)));
+            }
+            return res;
+        }
+
+        /// @brief Render the given glyph in white and extract it alpha channel.
+        std::vector<uint8_t> __render_glyph_alpha(char character, int& width, int& height) const {
+            width = 0; height = 0;
+            SDL_Surface* surface = nullptr;
+            switch (__render_method)
+            {
+            case TTFFontRenderMethod::Blended:
+                surface = TTF_RenderGlyph_Blended(__font, character, SDL_Color{255, 255, 255, 255});
+                break;
+            
+            default:
+                surface = TTF_RenderGlyph_Solid(__font, character, SDL_Color{255, 255, 255, 255});
+                break;
+            }
+            if (!surface) return std::vector<uint8_t>();
+
+            SDL_Surface* rgba = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+            SDL_FreeSurface(surface);
+            if (!rgba) return std::vector<uint8_t>();
+
+            width = rgba->w; height = rgba->h;
+            std::vector<uint8_t> result((size_t)width * height);
+            SDL_LockSurface(rgba);
+            for (int y = 0; y < height; ++y) {
+                const uint8_t* row = (const uint8_t*)rgba->pixels + y * rgba->pitch;
+                for (int x = 0; x < width; ++x)
+                    result[(size_t)y * width + x] = row[x * 4 + 3];
+            }
+            SDL_UnlockSurface(rgba);
+            SDL_FreeSurface(rgba);
+            return result;
+        }
+        /// @brief Blend a coverage layer with the given color over the RGBA canvas (straight alpha, source-over).
+        static void __blend_layer(std::vector<uint8_t>& canvas, int canvas_w, int canvas_h,
+            const std::vector<uint8_t>& layer, int layer_w, int layer_h, int offset_x, int offset_y, const Color& color) {
+            for (int y = 0; y < layer_h; ++y) {
+                int cy = y + offset_y;
+                if (cy < 0 || cy >= canvas_h) continue;
+                for (int x = 0; x < layer_w; ++x) {
+                    int cx = x + offset_x;
+                    if (cx < 0 || cx >= canvas_w) continue;
+                    uint32_t src_a = (uint32_t)layer[(size_t)y * layer_w + x] * color.Alpha / 255;
+                    if (src_a == 0) continue;
+
+                    uint8_t* dst = &canvas[((size_t)cy * canvas_w + cx) * 4];
+                    uint32_t dst_a = dst[3] * (255 - src_a) / 255;
+                    uint32_t out_a = src_a + dst_a;
+                    dst[0] = (uint8_t)((color.Red * src_a + dst[0] * dst_a) / out_a);
+                    dst[1] = (uint8_t)((color.Green * src_a + dst[1] * dst_a) / out_a);
+                    dst[2] = (uint8_t)((color.Blue * src_a + dst[2] * dst_a) / out_a);
+                    dst[3] = (uint8_t)out_a;
+                }
+            }
+        }
+        /// @brief Blur the given coverage map in place with a separable box blur (two iterations, close to gaussian).
+        static void __box_blur(std::vector<uint8_t>& map, int w, int h, int radius) {
+            if (radius <= 0 || map.empty()) return;
+            std::vector<uint8_t> tmp(map.size());
+            int window = radius * 2 + 1;
+            for (int iteration = 0; iteration < 2; ++iteration) {
+                // Horizontal pass (map -> tmp), with running sum.
+                for (int y = 0; y < h; ++y) {
+                    const uint8_t* src = &map[(size_t)y * w];
+                    uint8_t* dst = &tmp[(size_t)y * w];
+                    int sum = 0;
+                    for (int x = -radius; x <= radius; ++x)
+                        sum += (x >= 0 && x < w) ? src[x] : 0;
+                    for (int x = 0; x < w; ++x) {
+                        dst[x] = (uint8_t)(sum / window);
+                        int add = x + radius + 1, sub = x - radius;
+                        sum += (add < w ? src[add] : 0) - (sub >= 0 ? src[sub] : 0);
+                    }
+                }
+                // Vertical pass (tmp -> map).
+                for (int x = 0; x < w; ++x) {
+                    int sum = 0;
+                    for (int y = -radius; y <= radius; ++y)
+                        sum += (y >= 0 && y < h) ? tmp[(size_t)y * w + x] : 0;
+                    for (int y = 0; y < h; ++y) {
+                        map[(size_t)y * w + x] = (uint8_t)(sum / window);
+                        int add = y + radius + 1, sub = y - radius;
+                        sum += (add < h ? tmp[(size_t)add * w + x] : 0) - (sub >= 0 ? tmp[(size_t)sub * w + x] : 0);
+                    }
+                }
+            }
+        }
+        /// @brief Rasterize the given character with the current Text Effect baked in (shadow, outline and fill).
+        Texture* __bake_effect_glyph(char character, SDL_Renderer* renderer) {
+            int fill_w = 0, fill_h = 0;
+            std::vector<uint8_t> fill = __render_glyph_alpha(character, fill_w, fill_h);
+            if (fill.empty()) return nullptr;
+
+            // Outline glyph is rendered with FreeType stroker, it's larger than the fill glyph by outline size on each side.
+            int outline = 0, outline_w = 0, outline_h = 0;
+            std::vector<uint8_t> outline_map;
+            if (__text_effect.HasOutline()) {
+                int prev_outline = TTF_GetFontOutline(__font);
+                TTF_SetFontOutline(__font, __text_effect.OutlineSize);
+                outline_map = __render_glyph_alpha(character, outline_w, outline_h);
+                TTF_SetFontOutline(__font, prev_outline);
+                if (!outline_map.empty()) outline = __text_effect.OutlineSize;
+            }
+            int base_w = outline_map.empty() ? fill_w : outline_w, base_h = outline_map.empty() ? fill_h : outline_h;
+
+            bool has_shadow = __text_effect.HasShadow();
+            int blur = has_shadow ? ENGINE_MAX(0, __text_effect.ShadowBlurRadius) : 0;
+            int dx = has_shadow ? __text_effect.ShadowOffset.X : 0, dy = has_shadow ? __text_effect.ShadowOffset.Y : 0;
+
+            // The base glyph origin inside the canvas, leave room for the shadow on every side it spill over.
+            int base_x = blur + ENGINE_MAX(0, -dx), base_y = blur + ENGINE_MAX(0, -dy);
+            int canvas_w = base_w + abs(dx) + blur * 2, canvas_h = base_h + abs(dy) + blur * 2;
+            std::vector<uint8_t> canvas((size_t)canvas_w * canvas_h * 4, 0);
+
+            if (has_shadow) {
+                // Silhouette of the glyph (outline included) at the shadow position, then blurred.
+                std::vector<uint8_t> shadow((size_t)canvas_w * canvas_h, 0);
+                for (int y = 0; y < base_h; ++y)
+                    for (int x = 0; x < base_w; ++x) {
+                        uint8_t a = outline_map.empty() ? 0 : outline_map[(size_t)y * outline_w + x];
+                        int fx = x - outline, fy = y - outline;
+                        if (fx >= 0 && fx < fill_w && fy >= 0 && fy < fill_h)
+                            a = ENGINE_MAX(a, fill[(size_t)fy * fill_w + fx]);
+                        shadow[(size_t)(y + base_y + dy) * canvas_w + (x + base_x + dx)] = a;
+                    }
+                __box_blur(shadow, canvas_w, canvas_h, blur);
+                __blend_layer(canvas, canvas_w, canvas_h, shadow, canvas_w, canvas_h, 0, 0, __text_effect.ShadowColor);
+            }
+            if (!outline_map.empty())
+                __blend_layer(canvas, canvas_w, canvas_h, outline_map, outline_w, outline_h, base_x, base_y, __text_effect.OutlineColor);
+            __blend_layer(canvas, canvas_w, canvas_h, fill, fill_w, fill_h, base_x + outline, base_y + outline, __text_effect.FillColor);
+
+            SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, canvas_w, canvas_h, 32, SDL_PIXELFORMAT_RGBA32);
+            if (!surface) return nullptr;
+            SDL_LockSurface(surface);
+            for (int y = 0; y < canvas_h; ++y)
+                SDL_memcpy((uint8_t*)surface->pixels + y * surface->pitch, &canvas[(size_t)y * canvas_w * 4], (size_t)canvas_w * 4);
+            SDL_UnlockSurface(surface);
+
+            Texture* result = Texture::FromSDLTexture(SDL_CreateTextureFromSurface(renderer, surface));
+            SDL_FreeSurface(surface);
+            return result;
+        }
+        /// @brief Get (or bake) the glyph texture of the given character with the current Text Effect.
+        Texture* __get_effect_character_texture(char character) {
+            Texture* res_tex = nullptr;
+            if (__effect_char_textures.count(character) != 0) {
+                res_tex = __effect_char_textures[character];
+                if (res_tex)
+                    if (res_tex->IsAvaliable()) return res_tex;
+            }
+
+            if (res_tex)
+                delete res_tex;
+            __effect_char_textures.erase(character);
+            if (!__font) return nullptr;
+            if (!Window::IsInitialized()) return nullptr;
+            if (!Renderer::IsInitialized()) return nullptr;
+
+            SDL_Window* window = SDL_GetWindowFromID(Window::GetID());
+            if (!window) return nullptr;
+            SDL_Renderer* renderer = SDL_GetRenderer(window);
+            if (!renderer) return nullptr;
+
+            Texture* c_texture = __bake_effect_glyph(character, renderer);
+            if (!c_texture) return nullptr;
+            __effect_char_textures[character] = c_texture;
+            return c_texture;
+        }
     protected:
         Texture* GetCharacterTexture(char character) override {
             if (character == '\n') return nullptr;
+            if (!__text_effect.IsEmpty()) return __get_effect_character_texture(character);
             Texture* res_tex = nullptr;
             if (__char_textures.count(character) != 0) {
                 res_tex = __char_textures[character];
@@ -406,6 +683,10 @@ namespace Engine {
         }
         Size GetCharacterTextureSize(char character) override {
             if (character == '\n') return Size::Zero;
+            if (!__text_effect.IsEmpty()) {
+                Texture* effect_tex = __get_effect_character_texture(character);
+                return effect_tex ? effect_tex->GetSize() : Size::Zero;
+            }
             Texture* tex = nullptr;
             if (__char_textures.count(character) != 0) {
                 tex = __char_textures[character];
@@ -420,12 +701,72 @@ namespace Engine {
             return res;
         }
 
+        Texture* GetGlyphTexture(uint32_t code_point) override {
+            if (code_point < 0x80) return GetCharacterTexture((char)code_point);
+            Texture* res_tex = nullptr;
+            if (__glyph_textures.count(code_point) != 0) {
+                res_tex = __glyph_textures[code_point];
+                if (res_tex)
+                    if (res_tex->IsAvaliable()) return res_tex;
+            }
+
+            if (res_tex)
+                delete res_tex;
+            __glyph_textures.erase(code_point);
+            if (!__font) return nullptr;
+            if (!Window::IsInitialized()) return nullptr;
+            if (!Renderer::IsInitialized()) return nullptr;
+
+            SDL_Window* window = SDL_GetWindowFromID(Window::GetID());
+            if (!window) return nullptr;
+            SDL_Renderer* renderer = SDL_GetRenderer(window);
+            if (!renderer) return nullptr;
+
+            std::string text = __encode_utf8(code_point);
+            SDL_Surface* c_surface = nullptr;
+            switch (__render_method)
+            {
+            case TTFFontRenderMethod::Blended:
+                c_surface = TTF_RenderUTF8_Blended(__font, text.c_str(), SDL_Color{255, 255, 255, 255});
+                break;
+
+            default:
+                c_surface = TTF_RenderUTF8_Solid(__font, text.c_str(), SDL_Color{255, 255, 255, 255});
+                break;
+            }
+
+            if (!c_surface) return nullptr;
+
+            Texture* c_texture = Texture::FromSDLTexture(SDL_CreateTextureFromSurface(renderer, c_surface));
+            SDL_FreeSurface(c_surface);
+
+            if (!c_texture) return nullptr;
+            __glyph_textures[code_point] = c_texture;
+            return c_texture;
+        }
+        Size GetGlyphTextureSize(uint32_t code_point) override {
+            if (code_point < 0x80) return GetCharacterTextureSize((char)code_point);
+            auto it = __glyph_textures.find(code_point);
+            if (it != __glyph_textures.end() && it->second && it->second->IsAvaliable()) return it->second->GetSize();
+            if (!__font) return Size::Zero;
+            Size res = Size::Zero;
+            if (TTF_SizeUTF8(__font, __encode_utf8(code_point).c_str(), &res.Width, &res.Height) != 0)
+                return Size::Zero;
+            return res;
+        }
+
         TTFFont(TTF_Font* font) : __font(font) {}
     public:
         virtual ~TTFFont() {
             for (auto& pair : __char_textures)
                 if (pair.second) delete pair.second;
             __char_textures.clear();
+            for (auto& pair : __effect_char_textures)
+                if (pair.second) delete pair.second;
+            __effect_char_textures.clear();
+            for (auto& pair : __glyph_textures)
+                if (pair.second) delete pair.second;
+            __glyph_textures.clear();
             if (__font) TTF_CloseFont(__font);
             Font::~Font();
         }
@@ -437,12 +778,36 @@ namespace Engine {
         /// @return true if the data is avaliable, false otherwise.
         bool IsAvaliable() const { return (bool)__font; }
 
-        /// @brief Destroy all generated glyphs of the TTFFont.
+        /// @brief Destroy all generated glyphs of the TTFFont (including the glyphs baked with Text Effect).
         void DestroyAllGeneratedGlyphs() {
             for (auto& pair : __char_textures)
                 if (pair.second) delete pair.second;
             __char_textures.clear();
+            for (auto& pair : __glyph_textures)
+                if (pair.second) delete pair.second;
+            __glyph_textures.clear();
+            DestroyAllGeneratedEffectGlyphs();
+        }
+        /// @brief Destroy all glyphs baked with the Text Effect of the TTFFont, the plain glyphs are kept.
+        void DestroyAllGeneratedEffectGlyphs() {
+            for (auto& pair : __effect_char_textures)
+                if (pair.second) delete pair.second;
+            __effect_char_textures.clear();
+        }
+
+        /// @brief Get the Text Effect that baked into the glyphs of the TTFFont.
+        /// @return The current Text Effect of the TTFFont.
+        const TTFFontTextEffect& GetTextEffect() const { return __text_effect; }
+        /// @brief Set the Text Effect that baked into the glyphs of the TTFFont. While the Text Effect is not empty, the glyphs
+        /// are baked in full color (shadow, outline and fill color), so the text should be rendered with a white mod color
+        /// to keep the effect colors. This will destroy all glyphs baked with the previous Text Effect.
+        /// @param effect The Text Effect to set.
+        void SetTextEffect(const TTFFontTextEffect& effect) {
+            __text_effect = effect;
+            DestroyAllGeneratedEffectGlyphs();
         }
+        /// @brief Remove the Text Effect of the TTFFont, the plain glyphs will be used again.
+        void ClearTextEffect() { SetTextEffect(TTFFontTextEffect()); }
 
         /// @brief Get the family name of the font.
         /// @return The family name of the font, will return empty string ("") on failed.
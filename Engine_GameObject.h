@@ -48,6 +48,10 @@ namespace Engine {
     typedef EventCaller<GameObject, RenderEventArgs> GameObjectRenderEventCaller;
     /// @brief The Game Object Key Event Caller, use for Game Object keyboard event.
     typedef EventCaller<GameObject, KeyEventArgs> GameObjectKeyEventCaller;
+    /// @brief The Game Object Text Input Event Caller, use for Game Object text input event.
+    typedef EventCaller<GameObject, TextInputEventArgs> GameObjectTextInputEventCaller;
+    /// @brief The Game Object Text Editing Event Caller, use for Game Object text editing (IME composition) event.
+    typedef EventCaller<GameObject, TextEditingEventArgs> GameObjectTextEditingEventCaller;
     /// @brief The Game Object Mouse Event Caller, use for Game Object mouse button event.
     typedef EventCaller<GameObject, MouseButtonEventArgs> GameObjectMouseEventCaller;
     /// @brief The Game Object Mouse Wheel Event Caller, use for Game Object mouse wheel event.
@@ -72,14 +76,18 @@ namespace Engine {
             if (!RenderBackground)
                 return;
             Renderer::SetDrawColor(BackgroundColor);
-            Renderer::FillRectangle(args->TargetArea);
+            Renderer::FillRectangle(args->Transform, args->GetLocalArea());
             if (BackgroundTexture)
-                Renderer::DrawTexture(args->TargetArea, BackgroundTexture);
+                Renderer::DrawTexture(args->Transform, args->GetLocalArea(), BackgroundTexture);
         }
         /// @brief Occurred when a key is being pressed while the Window has input focus.
         virtual void OnKeyDown(KeyEventArgs* args) {}
         /// @brief Occurred when a key is being released while the Window has input focus.
         virtual void OnKeyUp(KeyEventArgs* args) {}
+        /// @brief Occurred when a text is committed while accepting text input.
+        virtual void OnTextInput(TextInputEventArgs* args) {}
+        /// @brief Occurred when the IME composition is changed while accepting text input.
+        virtual void OnTextEditing(TextEditingEventArgs* args) {}
         /// @brief Occurred when a mouse button is being pressed while the Window has input focus.
         virtual void OnGlobalMouseDown(MouseButtonEventArgs* args) {}
         /// @brief Occurred when a mouse button is being released while the Window has input focus.
@@ -112,6 +120,16 @@ namespace Engine {
         Engine::Size Size = Engine::Size::Zero;
         /// @brief The alignment of the Game Object related to it parent. Default is RectangleAlignment::TopLeft.
         RectangleAlignment Alignment = RectangleAlignment::TopLeft;
+        /// @brief The sub-pixel offset added to the Position when rendering, use for smooth movement (see
+        /// SetPrecisePosition()). Default is Vec2f::Zero.
+        Vec2f PositionOffset = Vec2f::Zero;
+        /// @brief The rotation angle in degrees (clockwise) around the Pivot when rendering. Default is 0.
+        double Rotation = 0;
+        /// @brief The scale around the Pivot when rendering. Default is Vec2f::One.
+        Vec2f Scale = Vec2f::One;
+        /// @brief The pivot of the Rotation and Scale, relative to the Size ((0, 0) is the top-left corner and (1, 1) is
+        /// the bottom-right corner). Default is (0.5, 0.5).
+        Vec2f Pivot = Vec2f(0.5f, 0.5f);
 
         /// @brief The background color of the Game Object. Default is Color::Empty.
         Color BackgroundColor = Color::Empty;
@@ -133,6 +151,10 @@ namespace Engine {
         GameObjectKeyEventCaller KeyDownEvent;
         /// @brief Occurred when a key is being released while the Window has input focus.
         GameObjectKeyEventCaller KeyUpEvent;
+        /// @brief Occurred when a text is committed while accepting text input.
+        GameObjectTextInputEventCaller TextInputEvent;
+        /// @brief Occurred when the IME composition is changed while accepting text input.
+        GameObjectTextEditingEventCaller TextEditingEvent;
         /// @brief Occurred when a mouse button is being pressed while the Window has input focus.
         GameObjectMouseEventCaller GlobalMouseDownEvent;
         /// @brief Occurred when a mouse button is being released while the Window has input focus.
@@ -154,6 +176,27 @@ namespace Engine {
         /// @brief Get the area of the Game Object (or the local area related to it parent).
         /// @return The Rectangle represent the area of the Game Object.
         Rectangle GetArea() const { return Rectangle(Position, Size); }
+        /// @brief Get the position of the Game Object with sub-pixel precision (Position + PositionOffset).
+        /// @return The precise position of the Game Object.
+        Vec2f GetPrecisePosition() const { return Vec2f(Position) + PositionOffset; }
+        /// @brief Set the position of the Game Object with sub-pixel precision, the integer part is set to the Position and
+        /// the fraction part is set to the PositionOffset.
+        /// @param position The precise position to set.
+        void SetPrecisePosition(const Vec2f& position) {
+            float x = floorf(position.X), y = floorf(position.Y);
+            Position = Point((int)x, (int)y);
+            PositionOffset = Vec2f(position.X - x, position.Y - y);
+        }
+        /// @brief Get the render transform of the Game Object, from its local space to the space of its target area (the
+        /// PositionOffset, Rotation and Scale around the Pivot).
+        /// @return The render transform.
+        Mat3x2f GetRenderTransform() const {
+            Mat3x2f transform = Mat3x2f::Translation(PositionOffset);
+            if (Rotation == 0 && Scale == Vec2f::One) return transform;
+            Vec2f pivot = Vec2f(Size) * Pivot;
+            return Mat3x2f::Translation(-pivot) * Mat3x2f::Scale(Scale) * Mat3x2f::Rotation((float)Rotation)
+                * Mat3x2f::Translation(pivot) * transform;
+        }
 
         /// @brief Set the parent of this Game Object.
         /// @param parent The parent to set, or nullptr to detach the Game Object from it parent.
@@ -395,6 +438,7 @@ namespace Engine {
         /// if it's enabled. The given args will be adjust base on each Game Object.
         void RaiseRenderEvent(RenderEventArgs* args, bool recursive = true) {
             RenderEventArgs* tmp = !args ? new RenderEventArgs() : args;
+            tmp->Transform = GetRenderTransform() * Mat3x2f::Translation(Vec2f(tmp->TargetArea.TopLeft())) * tmp->ParentTransform;
             OnRender(tmp); RenderEvent.Call(this, tmp);
             if (recursive) {
                 for (GameObject* child : __childs) {
@@ -403,6 +447,7 @@ namespace Engine {
 
                     RenderEventArgs child_args(*tmp);
                     child_args.TargetArea = child_args.TargetArea.LocalToGlobal(child->GetArea(), child->Alignment);
+                    child_args.ParentTransform = Mat3x2f::Translation(-Vec2f(tmp->TargetArea.TopLeft())) * tmp->Transform;
                     child->RaiseRenderEvent(&child_args, recursive);
                 }
             }
@@ -440,6 +485,38 @@ namespace Engine {
             }
             if (tmp && !args) delete tmp;
         }
+        /// @brief Raise the Text Input event to the Game Object.
+        /// @param recursive If this true (default), will also raise the event on all of the Game Object child recursively
+        /// if it's enabled.
+        void RaiseTextInputEvent(TextInputEventArgs* args, bool recursive = true) {
+            TextInputEventArgs* tmp = !args ? new TextInputEventArgs() : args;
+            OnTextInput(tmp); TextInputEvent.Call(this, tmp);
+            if (recursive) {
+                for (GameObject* child : __childs) {
+                    if (!child) continue;
+                    if (!child->Enabled || !child->HandleInput) continue;
+
+                    child->RaiseTextInputEvent(tmp, recursive);
+                }
+            }
+            if (tmp && !args) delete tmp;
+        }
+        /// @brief Raise the Text Editing event to the Game Object.
+        /// @param recursive If this true (default), will also raise the event on all of the Game Object child recursively
+        /// if it's enabled.
+        void RaiseTextEditingEvent(TextEditingEventArgs* args, bool recursive = true) {
+            TextEditingEventArgs* tmp = !args ? new TextEditingEventArgs() : args;
+            OnTextEditing(tmp); TextEditingEvent.Call(this, tmp);
+            if (recursive) {
+                for (GameObject* child : __childs) {
+                    if (!child) continue;
+                    if (!child->Enabled || !child->HandleInput) continue;
+
+                    child->RaiseTextEditingEvent(tmp, recursive);
+                }
+            }
+            if (tmp && !args) delete tmp;
+        }
         /// @brief Raise the Mouse Scroll event to the Game Object.
         /// @param recursive If this true (default), will also raise the event on all of the Game Object child recursively
         /// if it's enabled.
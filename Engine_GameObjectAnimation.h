@@ -8,11 +8,13 @@ namespace Engine {
     class StartEndMoveAnimationScript : public AnimationScript {
     protected:
         void OnUpdateAnimation(GameObject* Target, double AnimationTime) override {
-            Target->Position.X = (int)roundf(Interpolation::FromInterpolationFunction(
-                MovementInterpolationFunction, StartPosition.X, EndPosition.X, AnimationTime
-            ));
-            Target->Position.Y = (int)roundf(Interpolation::FromInterpolationFunction(
-                MovementInterpolationFunction, StartPosition.Y, EndPosition.Y, AnimationTime
+            Target->SetPrecisePosition(Vec2f(
+                (float)Interpolation::FromInterpolationFunction(
+                    MovementInterpolationFunction, StartPosition.X, EndPosition.X, AnimationTime
+                ),
+                (float)Interpolation::FromInterpolationFunction(
+                    MovementInterpolationFunction, StartPosition.Y, EndPosition.Y, AnimationTime
+                )
             ));
         }
     public:
@@ -28,17 +30,18 @@ namespace Engine {
     /// direction and amount.
     class DirectionalMoveAnimationScript : public AnimationScript {
     private:
-        Point __start_position;
+        Vec2f __start_position;
     protected:
-        void OnStartAnimation(GameObject* Target) override { __start_position = Target->Position; }
+        void OnStartAnimation(GameObject* Target) override { __start_position = Target->GetPrecisePosition(); }
         void OnUpdateAnimation(GameObject* Target, double AnimationTime) override {
-            int x_end = __start_position.X + Direction.X, y_end = __start_position.Y + Direction.Y;
-            Target->Position.X = (int)roundf(Interpolation::FromInterpolationFunction(
-                MovementInterpolationFunction, 0, Direction.X, AnimationTime
-            ) + __start_position.X);
-            Target->Position.Y = (int)roundf(Interpolation::FromInterpolationFunction(
-                MovementInterpolationFunction, 0, Direction.Y, AnimationTime
-            ) + __start_position.Y);
+            Target->SetPrecisePosition(Vec2f(
+                (float)Interpolation::FromInterpolationFunction(
+                    MovementInterpolationFunction, 0, Direction.X, AnimationTime
+                ) + __start_position.X,
+                (float)Interpolation::FromInterpolationFunction(
+                    MovementInterpolationFunction, 0, Direction.Y, AnimationTime
+                ) + __start_position.Y
+            ));
         }
     public:
         /// @brief The direction (also distance for each dimension) of the movement animation. Default is Point::Zero.
@@ -50,15 +53,17 @@ namespace Engine {
     /// @brief The Move To Animation Script, provide a movement Animation Script for moving to specific position.
     class MoveToAnimationScript : public AnimationScript {
     private:
-        Point __start_position;
+        Vec2f __start_position;
     protected:
-        void OnStartAnimation(GameObject* Target) override { __start_position = Target->Position; }
+        void OnStartAnimation(GameObject* Target) override { __start_position = Target->GetPrecisePosition(); }
         void OnUpdateAnimation(GameObject* Target, double AnimationTime) override {
-            Target->Position.X = (int)roundf(Interpolation::FromInterpolationFunction(
-                MovementInterpolationFunction, __start_position.X, EndPosition.X, AnimationTime
-            ));
-            Target->Position.Y = (int)roundf(Interpolation::FromInterpolationFunction(
-                MovementInterpolationFunction, __start_position.Y, EndPosition.Y, AnimationTime
+            Target->SetPrecisePosition(Vec2f(
+                (float)Interpolation::FromInterpolationFunction(
+                    MovementInterpolationFunction, __start_position.X, EndPosition.X, AnimationTime
+                ),
+                (float)Interpolation::FromInterpolationFunction(
+                    MovementInterpolationFunction, __start_position.Y, EndPosition.Y, AnimationTime
+                )
             ));
         }
     public:
@@ -70,15 +75,17 @@ namespace Engine {
     /// @brief The Move From Animation Script, provide a movement Animation Script for moving from specific position.
     class MoveFromAnimationScript : public AnimationScript {
     private:
-        Point __end_position;
+        Vec2f __end_position;
     protected:
-        void OnStartAnimation(GameObject* Target) override { __end_position = Target->Position; }
+        void OnStartAnimation(GameObject* Target) override { __end_position = Target->GetPrecisePosition(); }
         void OnUpdateAnimation(GameObject* Target, double AnimationTime) override {
-            Target->Position.X = (int)roundf(Interpolation::FromInterpolationFunction(
-                MovementInterpolationFunction, __end_position.X, StartPosition.X, AnimationTime
-            ));
-            Target->Position.Y = (int)roundf(Interpolation::FromInterpolationFunction(
-                MovementInterpolationFunction, __end_position.Y, StartPosition.Y, AnimationTime
+            Target->SetPrecisePosition(Vec2f(
+                (float)Interpolation::FromInterpolationFunction(
+                    MovementInterpolationFunction, __end_position.X, StartPosition.X, AnimationTime
+                ),
+                (float)Interpolation::FromInterpolationFunction(
+                    MovementInterpolationFunction, __end_position.Y, StartPosition.Y, AnimationTime
+                )
             ));
         }
     public:
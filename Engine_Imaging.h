@@ -589,6 +589,41 @@ void Engine::Renderer::DrawTexture(const Engine::Rectangle& Area, Engine::Textur
     SDL_RenderCopyEx(Renderer::__renderer, Texture->GetSDLTexture(), nullptr, &dst_rect, RotationAngle, nullptr,
         (SDL_RendererFlip)(((uint32_t)HorizontalFlip * SDL_FLIP_HORIZONTAL) | ((uint32_t)VerticalFlip * SDL_FLIP_VERTICAL)));
 }
+void Engine::Renderer::DrawTexture(const Engine::RectF& Area, Engine::Texture* Texture, double RotationAngle,
+    bool HorizontalFlip, bool VerticalFlip) {
+
+    if (!Texture || !Renderer::__renderer || Area.Width == 0.0f || Area.Height == 0.0f) return;
+    if (!Texture->IsAvaliable()) return;
+
+    SDL_FRect dst_rect = {ENGINE_MIN(Area.X, Area.X + Area.Width), ENGINE_MIN(Area.Y, Area.Y + Area.Height), fabsf(Area.Width), fabsf(Area.Height)};
+    SDL_RenderCopyExF(Renderer::__renderer, Texture->GetSDLTexture(), nullptr, &dst_rect, RotationAngle, nullptr,
+        (SDL_RendererFlip)(((uint32_t)HorizontalFlip * SDL_FLIP_HORIZONTAL) | ((uint32_t)VerticalFlip * SDL_FLIP_VERTICAL)));
+}
+void Engine::Renderer::DrawTexture(const Engine::Mat3x2f& Transform, const Engine::RectF& Area, Engine::Texture* Texture) {
+    if (Transform.M12 == 0.0f && Transform.M21 == 0.0f) {
+        // Axis-aligned, a negative scale is a flip.
+        DrawTexture(Transform.TransformBounds(Area), Texture, 0, Transform.M11 < 0.0f, Transform.M22 < 0.0f);
+        return;
+    }
+    // SDL rotate around the center of the destination area, so draw the scaled area around the transformed center.
+    Vec2f scale = Transform.GetScale();
+    Vec2f center = Transform.TransformPoint(Area.Center());
+    float width = fabsf(Area.Width * scale.X), height = fabsf(Area.Height * scale.Y);
+    DrawTexture(RectF(center.X - width * 0.5f, center.Y - height * 0.5f, width, height), Texture,
+        Transform.GetRotation(), false, scale.Y < 0.0f);
+}
+bool Engine::Renderer::SetTarget(Engine::Texture* Target) {
+    if (!Renderer::__renderer) return false;
+    if (Target && !Target->IsAvaliable()) return false;
+    return SDL_SetRenderTarget(Renderer::__renderer, Target ? Target->GetSDLTexture() : nullptr) == 0;
+}
+void Engine::Renderer::DrawGeometry(Engine::Texture* Texture, const SDL_Vertex* Vertices, int VertexCount,
+    const int* Indices, int IndexCount) {
+
+    if (!Renderer::__renderer || !Vertices || VertexCount <= 0) return;
+    if (Texture && !Texture->IsAvaliable()) return;
+    SDL_RenderGeometry(Renderer::__renderer, Texture ? Texture->GetSDLTexture() : nullptr, Vertices, VertexCount, Indices, IndexCount);
+}
 void Engine::Renderer::DrawTexture(const Engine::Point& Position, Engine::Texture* Texture, const Engine::Point& Center, double RotationAngle,
     bool HorizontalFlip, bool VerticalFlip) {
         
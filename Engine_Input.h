@@ -1,8 +1,17 @@
 #ifndef __ENGINE_INPUT_H__
 #define __ENGINE_INPUT_H__
 
+#define ENGINE_INPUT_KEY_MAP_SIZE 256
+
 #include <SDL2/SDL_keyboard.h>
 #include <SDL2/SDL_events.h>
+#include <SDL2/SDL_timer.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
 
 #include "Engine_Enum.h"
 #include "Engine_Keycode.h"
@@ -10,6 +19,123 @@
 #include "Engine_Structure.h"
 
 namespace Engine {
+	/// @brief The Input Snapshot struct, contain a compact bitset of the keyboard and mouse button state at a frame.
+	struct InputSnapshot {
+	public:
+		/// @brief The keyboard state, one bit per Scancode.
+		uint64_t Keys[(SDL_NUM_SCANCODES + 63) / 64] = {};
+		/// @brief The mouse button state, one bit per Mouse Button (same as MouseButtonMask).
+		uint32_t MouseButtons = 0;
+		/// @brief The modifier keys state (same as KeyModifier).
+		uint16_t Modifiers = 0;
+
+		/// @brief Check if a key is down in the snapshot.
+		/// @param Scancode The Scancode of the key to check.
+		/// @return true if the key is down, false otherwise.
+		bool IsKeyDown(Engine::Scancode Scancode) const {
+			unsigned index = (unsigned)Scancode;
+			return index < SDL_NUM_SCANCODES && ((Keys[index >> 6] >> (index & 63)) & 1);
+		}
+		/// @brief Check if a mouse button is down in the snapshot.
+		/// @param Button The Mouse Button to check.
+		/// @return true if the mouse button is down, false otherwise.
+		bool IsMouseButtonDown(MouseButton Button) const {
+			unsigned index = (unsigned)Button - 1;
+			return index < 32 && ((MouseButtons >> index) & 1);
+		}
+	};
+
+	/// @brief The Input static class, capture the keyboard and mouse button state once per frame (this is called by
+	/// Application::Start() after handling the window event), and keep the snapshot of the previous frame.
+	class Input final {
+	private:
+		static InputSnapshot __snapshots[2];
+		static int __current_snapshot;
+		static bool __is_key_map_built;
+		static Engine::Scancode __key_map[ENGINE_INPUT_KEY_MAP_SIZE];
+		static Uint32 __sync_ticks;
+		static Uint64 __sync_counter;
+	public:
+		/// @brief Capture the current keyboard and mouse button state into the snapshot, the old snapshot become the
+		/// previous snapshot. This is called once per frame by Application::Start().
+		static void Capture() {
+			if (!Input::__is_key_map_built) RefreshKeyMap();
+			Input::__current_snapshot ^= 1;
+			InputSnapshot& snapshot = Input::__snapshots[Input::__current_snapshot];
+
+			int count = 0;
+			const Uint8* state = SDL_GetKeyboardState(&count);
+			std::memset(snapshot.Keys, 0, sizeof(snapshot.Keys));
+			if (state) {
+				if (count > SDL_NUM_SCANCODES) count = SDL_NUM_SCANCODES;
+				for (int i = 0; i < count; i++)
+					snapshot.Keys[i >> 6] |= (uint64_t)(state[i] != 0) << (i & 63);
+			}
+			snapshot.MouseButtons = SDL_GetMouseState(nullptr, nullptr);
+			snapshot.Modifiers = (uint16_t)SDL_GetModState();
+		}
+		/// @brief Rebuild the Key Code to Scancode table from the current keyboard layout. This is called when the
+		/// keyboard layout is changed (SDL_KEYMAPCHANGED).
+		static void RefreshKeyMap() {
+			for (int i = 0; i < ENGINE_INPUT_KEY_MAP_SIZE; i++)
+				Input::__key_map[i] = (Engine::Scancode)SDL_GetScancodeFromKey((SDL_Keycode)i);
+			Input::__is_key_map_built = true;
+		}
+
+		/// @brief Get the Scancode of the given Key Code, with the precomputed table.
+		/// @param KeyCode The Key Code to get the Scancode.
+		/// @return The Scancode that corresponds to the given Key Code.
+		static Engine::Scancode GetScancode(Engine::KeyCode KeyCode) {
+			uint32_t key = (uint32_t)KeyCode;
+			// The non-character keys are the Scancode with a mask, so they don't depend on the keyboard layout.
+			if (key & SDLK_SCANCODE_MASK) {
+				key &= ~(uint32_t)SDLK_SCANCODE_MASK;
+				return key < SDL_NUM_SCANCODES ? (Engine::Scancode)key : Engine::Scancode::Unknown;
+			}
+			if (key < ENGINE_INPUT_KEY_MAP_SIZE) {
+				if (!Input::__is_key_map_built) RefreshKeyMap();
+				return Input::__key_map[key];
+			}
+			return (Engine::Scancode)SDL_GetScancodeFromKey((SDL_Keycode)key);
+		}
+
+		/// @brief Get the current high-resolution time in seconds, from SDL_GetPerformanceCounter(). This is the time base of
+		/// the input event timestamps.
+		/// @return The current time in seconds.
+		static double GetTime() {
+			return (double)SDL_GetPerformanceCounter() / (double)SDL_GetPerformanceFrequency();
+		}
+		/// @brief Pair the SDL tick count with the performance counter, used to convert the SDL event timestamps. This is
+		/// called by Application::HandleWindowEvent() before polling the events.
+		static void SyncClock() {
+			Input::__sync_counter = SDL_GetPerformanceCounter();
+			Input::__sync_ticks = SDL_GetTicks();
+		}
+		/// @brief Get the SDL tick count that paired by the last SyncClock().
+		/// @return The SDL tick count in milliseconds.
+		static Uint32 GetSyncTicks() { return Input::__sync_ticks; }
+		/// @brief Convert the given SDL event timestamp (in milliseconds) to the time base of GetTime(). SDL only stamp the
+		/// events in milliseconds, so the result is within a millisecond of the actual time.
+		/// @param Timestamp The SDL event timestamp to convert.
+		/// @return The time in seconds.
+		static double GetEventTime(Uint32 Timestamp) {
+			double frequency = (double)SDL_GetPerformanceFrequency();
+			// The signed difference handle the tick count wrap around.
+			double offset = (double)(Sint32)(Timestamp - Input::__sync_ticks) * 0.001;
+			return (double)Input::__sync_counter / frequency + offset;
+		}
+
+		/// @brief Get the input snapshot of the current frame.
+		/// @return The input snapshot of the current frame.
+		static const InputSnapshot& GetSnapshot() { return Input::__snapshots[Input::__current_snapshot]; }
+		/// @brief Get the input snapshot of the previous frame.
+		/// @return The input snapshot of the previous frame.
+		static const InputSnapshot& GetPreviousSnapshot() { return Input::__snapshots[Input::__current_snapshot ^ 1]; }
+		/// @brief Replace the input snapshot of the current frame (e.g. by the input replay), after Capture().
+		/// @param Snapshot The input snapshot to set.
+		static void SetSnapshot(const InputSnapshot& Snapshot) { Input::__snapshots[Input::__current_snapshot] = Snapshot; }
+	};
+
 	/// @brief The Keys static class, provide static method for working with keyboard input.
 	class Keys final {
 	public:
@@ -23,7 +149,7 @@ namespace Engine {
 		/// @param KeyCode The Key Code of the key to check.
 		/// @return true if the key is being pressed down, false otherwise.
 		static bool IsKeyDown(Engine::KeyCode KeyCode) {
-			return SDL_GetKeyboardState(nullptr)[SDL_GetScancodeFromKey((SDL_Keycode)KeyCode)] == 1;
+			return SDL_GetKeyboardState(nullptr)[(int)Input::GetScancode(KeyCode)] == 1;
 		}
 
 		/// @brief Check if a key is not being pressed down.
@@ -36,9 +162,38 @@ namespace Engine {
 		/// @param KeyCode The Key Code of the key to check.
 		/// @return true if the key is not being pressed down, false otherwise.
 		static bool IsKeyUp(Engine::KeyCode KeyCode) {
-			return SDL_GetKeyboardState(nullptr)[SDL_GetScancodeFromKey((SDL_Keycode)KeyCode)] == 0;
+			return SDL_GetKeyboardState(nullptr)[(int)Input::GetScancode(KeyCode)] == 0;
 		}
 
+		/// @brief Check if a key is down on the current frame (from the input snapshot).
+		/// @param Scancode The Scancode of the key to check.
+		/// @return true if the key is down, false otherwise.
+		static bool IsDown(Engine::Scancode Scancode) { return Input::GetSnapshot().IsKeyDown(Scancode); }
+		/// @brief Check if a key is down on the current frame (from the input snapshot).
+		/// @param KeyCode The Key Code of the key to check.
+		/// @return true if the key is down, false otherwise.
+		static bool IsDown(Engine::KeyCode KeyCode) { return IsDown(Input::GetScancode(KeyCode)); }
+		/// @brief Check if a key went down on the current frame (up on the previous frame).
+		/// @param Scancode The Scancode of the key to check.
+		/// @return true if the key went down on the current frame, false otherwise.
+		static bool WasPressed(Engine::Scancode Scancode) {
+			return Input::GetSnapshot().IsKeyDown(Scancode) && !Input::GetPreviousSnapshot().IsKeyDown(Scancode);
+		}
+		/// @brief Check if a key went down on the current frame (up on the previous frame).
+		/// @param KeyCode The Key Code of the key to check.
+		/// @return true if the key went down on the current frame, false otherwise.
+		static bool WasPressed(Engine::KeyCode KeyCode) { return WasPressed(Input::GetScancode(KeyCode)); }
+		/// @brief Check if a key went up on the current frame (down on the previous frame).
+		/// @param Scancode The Scancode of the key to check.
+		/// @return true if the key went up on the current frame, false otherwise.
+		static bool WasReleased(Engine::Scancode Scancode) {
+			return !Input::GetSnapshot().IsKeyDown(Scancode) && Input::GetPreviousSnapshot().IsKeyDown(Scancode);
+		}
+		/// @brief Check if a key went up on the current frame (down on the previous frame).
+		/// @param KeyCode The Key Code of the key to check.
+		/// @return true if the key went up on the current frame, false otherwise.
+		static bool WasReleased(Engine::KeyCode KeyCode) { return WasReleased(Input::GetScancode(KeyCode)); }
+
 		/// @brief Get the corresponding Key Code from the given Scancode.
 		/// @param Scancode The Scancode to get the Key Code.
 		/// @return The Key Code that corresponds to the given Scancode.
@@ -49,7 +204,7 @@ namespace Engine {
 		/// @param KeyCode The Key Code to get the Scancode.
 		/// @return The Scancode that corresponds to the given Key Code.
 		static Scancode GetScancodeFromKeyCode(Engine::KeyCode KeyCode) {
-			return (Scancode)SDL_GetScancodeFromKey((SDL_KeyCode)KeyCode);
+			return Input::GetScancode(KeyCode);
 		}
 
 		/// @brief Get the name of the given Key Code.
@@ -59,6 +214,21 @@ namespace Engine {
 		static const char* GetKeyName(Engine::KeyCode KeyCode) {
 			return SDL_GetKeyName((SDL_Keycode)KeyCode);
 		}
+
+		/// @brief Start accepting text input (SDL_TEXTINPUT and SDL_TEXTEDITING events), this will show the on-screen
+		/// keyboard or the IME if available.
+		static void StartTextInput() { SDL_StartTextInput(); }
+		/// @brief Stop accepting text input.
+		static void StopTextInput() { SDL_StopTextInput(); }
+		/// @brief Check if currently accepting text input.
+		/// @return true if currently accepting text input, false otherwise.
+		static bool IsTextInputActive() { return SDL_IsTextInputActive() == SDL_TRUE; }
+		/// @brief Set the area (relative to the Window) that the text is being input, used to place the IME candidate list.
+		/// @param Area The area to set.
+		static void SetTextInputArea(const Rectangle& Area) {
+			SDL_Rect rect = { Area.X, Area.Y, Area.Width, Area.Height };
+			SDL_SetTextInputRect(&rect);
+		}
 	};
 
 	/// @brief The Key Event Args, usually for keyboard input handling event.
@@ -80,9 +250,12 @@ namespace Engine {
 		bool IsPressed = false;
 		/// @brief If this is true, the key is released.
 		bool IsReleased = false;
+		/// @brief The time of the event in seconds, in the time base of Input::GetTime().
+		double Timestamp = 0.0;
 
 		static KeyEventArgs FromSDLKeyboardEvent(const SDL_KeyboardEvent& key_e) {
 			KeyEventArgs key_args;
+			key_args.Timestamp = Input::GetEventTime(key_e.timestamp);
 			key_args.Modifiers = (KeyModifier)key_e.keysym.mod;
 			key_args.Scancode = (Engine::Scancode)key_e.keysym.scancode;
 			key_args.KeyCode = (Engine::KeyCode)key_e.keysym.sym;
@@ -96,6 +269,44 @@ namespace Engine {
 		}
 	};
 
+	/// @brief The Text Input Event Args, usually for text input handling event (the committed text).
+	struct TextInputEventArgs : public EventArgs {
+	public:
+		/// @brief The input text, in UTF-8.
+		std::string Text = "";
+		/// @brief The time of the event in seconds, in the time base of Input::GetTime().
+		double Timestamp = 0.0;
+
+		static TextInputEventArgs FromSDLTextInputEvent(const SDL_TextInputEvent& text_e) {
+			TextInputEventArgs text_args;
+			text_args.Text = text_e.text;
+			text_args.Timestamp = Input::GetEventTime(text_e.timestamp);
+			return text_args;
+		}
+	};
+
+	/// @brief The Text Editing Event Args, usually for IME composition handling event (the text that not committed yet).
+	struct TextEditingEventArgs : public EventArgs {
+	public:
+		/// @brief The composition text, in UTF-8. Empty if the composition is ended.
+		std::string Text = "";
+		/// @brief The cursor position in the composition text.
+		int Start = 0;
+		/// @brief The length of the selection in the composition text.
+		int Length = 0;
+		/// @brief The time of the event in seconds, in the time base of Input::GetTime().
+		double Timestamp = 0.0;
+
+		static TextEditingEventArgs FromSDLTextEditingEvent(const SDL_TextEditingEvent& edit_e) {
+			TextEditingEventArgs edit_args;
+			edit_args.Text = edit_e.text;
+			edit_args.Start = edit_e.start;
+			edit_args.Length = edit_e.length;
+			edit_args.Timestamp = Input::GetEventTime(edit_e.timestamp);
+			return edit_args;
+		}
+	};
+
 	/// @brief The Mouse static class, provide static method for working with mouse input.
 	class Mouse final {
 	public:
@@ -119,6 +330,23 @@ namespace Engine {
 		/// @brief Check if currently in relative mode.
 		/// @return true if currently in relative mode, false otherwise.
 		static bool IsRelativeMode() { return SDL_GetRelativeMouseMode() == SDL_TRUE; }
+
+		/// @brief Check if a mouse button is down on the current frame (from the input snapshot).
+		/// @param Button The Mouse Button to check.
+		/// @return true if the mouse button is down, false otherwise.
+		static bool IsDown(MouseButton Button) { return Input::GetSnapshot().IsMouseButtonDown(Button); }
+		/// @brief Check if a mouse button went down on the current frame (up on the previous frame).
+		/// @param Button The Mouse Button to check.
+		/// @return true if the mouse button went down on the current frame, false otherwise.
+		static bool WasPressed(MouseButton Button) {
+			return Input::GetSnapshot().IsMouseButtonDown(Button) && !Input::GetPreviousSnapshot().IsMouseButtonDown(Button);
+		}
+		/// @brief Check if a mouse button went up on the current frame (down on the previous frame).
+		/// @param Button The Mouse Button to check.
+		/// @return true if the mouse button went up on the current frame, false otherwise.
+		static bool WasReleased(MouseButton Button) {
+			return !Input::GetSnapshot().IsMouseButtonDown(Button) && Input::GetPreviousSnapshot().IsMouseButtonDown(Button);
+		}
 	};
 
 	/// @brief The Mouse Button Event Args, usually for mouse button handling event.
@@ -139,9 +367,12 @@ namespace Engine {
 		bool IsPressed = false;
 		/// @brief If this is true, the button is released.
 		bool IsReleased = false;
+		/// @brief The time of the event in seconds, in the time base of Input::GetTime().
+		double Timestamp = 0.0;
 
 		static MouseButtonEventArgs FromSDLMouseButtonEvent(const SDL_MouseButtonEvent& button_e) {
 			MouseButtonEventArgs button_args;
+			button_args.Timestamp = Input::GetEventTime(button_e.timestamp);
 			button_args.LocalPosition = Point(button_e.x, button_e.y);
 			button_args.Button = (MouseButton)button_e.button;
 			button_args.Clicks = button_e.clicks;
@@ -174,9 +405,12 @@ namespace Engine {
 		/// @brief If this was true, the amount of scroll (DeltaX, DeltaY) is flipped.
 		/// If this was true and you want to get the non-flipped value, multiply it by -1.
 		bool IsFlipped = false;
+		/// @brief The time of the event in seconds, in the time base of Input::GetTime().
+		double Timestamp = 0.0;
 
 		static MouseWheelEventArgs FromSDLMouseWheelEvent(const SDL_MouseWheelEvent& wheel_e) {
 			MouseWheelEventArgs wheel_args;
+			wheel_args.Timestamp = Input::GetEventTime(wheel_e.timestamp);
 			wheel_args.DeltaX = wheel_e.x;
 			wheel_args.DeltaY = wheel_e.y;
 			wheel_args.PreciseDeltaX = wheel_e.preciseX;
@@ -199,9 +433,12 @@ namespace Engine {
 		/// @brief The x position of the mouse relative to the last mouse motion event.
 		/// (negative if move up, positive if move down and 0 if not moving in y direction).
 		int DeltaY = 0;
+		/// @brief The time of the event in seconds, in the time base of Input::GetTime().
+		double Timestamp = 0.0;
 
 		static MouseMotionEventArgs FromSDLMouseMotionEvent(const SDL_MouseMotionEvent& motion_e) {
 			MouseMotionEventArgs motion_args;
+			motion_args.Timestamp = Input::GetEventTime(motion_e.timestamp);
 			motion_args.ButtonState = (MouseButtonMask)motion_e.state;
 			motion_args.LocalPosition = Point(motion_e.x, motion_e.y);
 			motion_args.DeltaX = motion_e.xrel;
@@ -210,6 +447,138 @@ namespace Engine {
 			return motion_args;
 		}
 	};
+
+	/// @brief The Input Event Type enum, contain the type of a buffered input event.
+	enum class InputEventType {
+		KeyDown,
+		KeyUp,
+		MouseButtonDown,
+		MouseButtonUp,
+		MouseWheel,
+		MouseMotion
+	};
+
+	/// @brief The Buffered Input Event struct, a timestamped input event stored in the Input Buffer.
+	struct BufferedInputEvent {
+	public:
+		/// @brief The type of the event.
+		InputEventType Type = InputEventType::KeyDown;
+		/// @brief The time of the event in seconds, in the time base of Input::GetTime().
+		double Timestamp = 0.0;
+
+		/// @brief The modifier keys that being pressed down (key events only).
+		KeyModifier Modifiers = KeyModifier::None;
+		/// @brief The Scancode of the key (key events only).
+		Engine::Scancode Scancode = Engine::Scancode::Unknown;
+		/// @brief The Key Code of the key (key events only).
+		Engine::KeyCode KeyCode = Engine::KeyCode::Unknown;
+
+		/// @brief The mouse button (mouse button events only).
+		MouseButton Button = MouseButton::Unknown;
+		/// @brief The cursor position relative to the window (mouse button and motion events only).
+		Point Position = Point::Zero;
+		/// @brief The motion or scroll amount (mouse motion and wheel events only).
+		int DeltaX = 0, DeltaY = 0;
+	};
+
+	/// @brief The Input Buffer static class, keep the input events of the current frame ordered by time. A fixed timestep
+	/// simulation can consume the events of each sub-step with ForEachEvent(). The buffer is refilled by
+	/// Application::HandleWindowEvent() every frame (when Application::HandleInput is true).
+	class InputBuffer final {
+	private:
+		static std::vector<BufferedInputEvent> __events;
+		static double __start_time, __end_time;
+
+		static void __push(BufferedInputEvent& e) {
+			// Keep the buffer sorted, the events that stamped in the same millisecond are kept in the queue order.
+			if (!InputBuffer::__events.empty()) e.Timestamp = std::max(e.Timestamp, InputBuffer::__events.back().Timestamp);
+			// The SDL timestamps are rounded to milliseconds, so keep them in the frame [start, end].
+			e.Timestamp = ENGINE_FAST_CLAMP(InputBuffer::__start_time, InputBuffer::__end_time, e.Timestamp);
+			InputBuffer::__events.push_back(e);
+		}
+	public:
+		/// @brief Start a new frame, clear the buffered events. The frame start at the end time of the previous frame. This is
+		/// called by Application::HandleWindowEvent().
+		static void BeginFrame() {
+			InputBuffer::__events.clear();
+			double now = Input::GetTime();
+			InputBuffer::__start_time = (InputBuffer::__end_time > 0.0) ? InputBuffer::__end_time : now;
+			InputBuffer::__end_time = now;
+		}
+		/// @brief Add a key event to the buffer.
+		static void Push(const KeyEventArgs& Args) {
+			BufferedInputEvent e;
+			e.Type = Args.IsDownEvent ? InputEventType::KeyDown : InputEventType::KeyUp;
+			e.Timestamp = Args.Timestamp;
+			e.Modifiers = Args.Modifiers;
+			e.Scancode = Args.Scancode;
+			e.KeyCode = Args.KeyCode;
+			__push(e);
+		}
+		/// @brief Add a mouse button event to the buffer.
+		static void Push(const MouseButtonEventArgs& Args) {
+			BufferedInputEvent e;
+			e.Type = Args.IsDownEvent ? InputEventType::MouseButtonDown : InputEventType::MouseButtonUp;
+			e.Timestamp = Args.Timestamp;
+			e.Button = Args.Button;
+			e.Position = Args.LocalPosition;
+			__push(e);
+		}
+		/// @brief Add a mouse wheel event to the buffer.
+		static void Push(const MouseWheelEventArgs& Args) {
+			BufferedInputEvent e;
+			e.Type = InputEventType::MouseWheel;
+			e.Timestamp = Args.Timestamp;
+			e.DeltaX = Args.DeltaX;
+			e.DeltaY = Args.DeltaY;
+			__push(e);
+		}
+		/// @brief Add a mouse motion event to the buffer.
+		static void Push(const MouseMotionEventArgs& Args) {
+			BufferedInputEvent e;
+			e.Type = InputEventType::MouseMotion;
+			e.Timestamp = Args.Timestamp;
+			e.Position = Args.LocalPosition;
+			e.DeltaX = Args.DeltaX;
+			e.DeltaY = Args.DeltaY;
+			__push(e);
+		}
+
+		/// @brief Get all buffered events of the current frame, ordered by time.
+		/// @return The buffered events.
+		static const std::vector<BufferedInputEvent>& GetEvents() { return InputBuffer::__events; }
+		/// @brief Get the start time of the current frame (the events are stamped after this time).
+		/// @return The start time in seconds.
+		static double GetStartTime() { return InputBuffer::__start_time; }
+		/// @brief Get the end time of the current frame (the time that the events are polled).
+		/// @return The end time in seconds.
+		static double GetEndTime() { return InputBuffer::__end_time; }
+		/// @brief Execute an action for each buffered event that stamped in the given time range, in order.
+		/// @param StartTime The start of the time range (inclusive).
+		/// @param EndTime The end of the time range (exclusive).
+		/// @param Action The action to execute.
+		/// @return The number of event that called with the given action.
+		static size_t ForEachEvent(double StartTime, double EndTime, const std::function<void(const BufferedInputEvent&)>& Action) {
+			if (!Action) return 0;
+			auto it = std::lower_bound(InputBuffer::__events.begin(), InputBuffer::__events.end(), StartTime,
+				[](const BufferedInputEvent& e, double time) { return e.Timestamp < time; });
+			size_t count = 0;
+			for (; it != InputBuffer::__events.end() && it->Timestamp < EndTime; ++it, count++)
+				Action(*it);
+			return count;
+		}
+	};
 }
 
+Engine::InputSnapshot Engine::Input::__snapshots[2];
+int Engine::Input::__current_snapshot = 0;
+bool Engine::Input::__is_key_map_built = false;
+Engine::Scancode Engine::Input::__key_map[ENGINE_INPUT_KEY_MAP_SIZE];
+Uint32 Engine::Input::__sync_ticks = 0;
+Uint64 Engine::Input::__sync_counter = 0;
+
+std::vector<Engine::BufferedInputEvent> Engine::InputBuffer::__events = std::vector<Engine::BufferedInputEvent>();
+double Engine::InputBuffer::__start_time = 0.0;
+double Engine::InputBuffer::__end_time = 0.0;
+
 #endif // __ENGINE_INPUT_H__
\ No newline at end of file
@@ -0,0 +1,327 @@
+#ifndef __ENGINE_INPUTRECORDER_H__
+#define __ENGINE_INPUTRECORDER_H__
+
+#define ENGINE_INPUT_RECORD_MAGIC 0x52494741
+#define ENGINE_INPUT_RECORD_VERSION 1
+
+#include "Engine_Application.h"
+#include "Engine_Event.h"
+#include "Engine_Input.h"
+#include "Engine_Window.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <SDL2/SDL.h>
+
+namespace Engine {
+    /// @brief The Input Recorder static class, record the SDL events, the input snapshots and the delta time of every frame
+    /// at the Application::HandleWindowEvent() boundary into a compact binary file, and replay them with the recorded delta
+    /// time. The same session can be replayed on every build to compare the frame times.
+    /// The file is a header (magic, version, event size, snapshot size) followed by the records of each frame: the events
+    /// (tag 1 + SDL_Event with the timestamp relative to the frame), the input snapshot (tag 2) and the frame end (tag 3 +
+    /// delta time as double). The file is only portable between builds on the same platform.
+    /// Starting and stopping take effect at the next frame boundary (BeginFrame()), so they can be called from anywhere in
+    /// a frame and every recorded frame is complete.
+    /// @note The drop, system window manager, extended text editing and user events are not recorded (they contain
+    /// pointers). While replaying, the real events are discarded, and Mouse/Keys functions that read the SDL state
+    /// directly are not replayed.
+    class InputRecorder final {
+    private:
+        enum class __record_tag : uint8_t { Event = 1, Snapshot = 2, Frame = 3 };
+
+        struct __header {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t event_size;
+            uint32_t snapshot_size;
+        };
+
+        static SDL_RWops* __file;
+        static std::vector<uint8_t> __buffer;
+
+        static uint8_t* __replay_data;
+        static size_t __replay_size, __replay_cursor;
+        static bool __is_replaying, __is_headless, __is_queue_flushed;
+        static std::vector<double> __frame_times;
+
+        static size_t __frame_count;
+
+        // The requests that applied on the next BeginFrame().
+        static SDL_RWops* __pending_file;
+        static uint8_t* __pending_replay_data;
+        static size_t __pending_replay_size;
+        static bool __is_pending_headless, __is_stop_recording_requested, __is_stop_replay_requested;
+
+        static void __write(const void* data, size_t size) {
+            const uint8_t* bytes = (const uint8_t*)data;
+            InputRecorder::__buffer.insert(InputRecorder::__buffer.end(), bytes, bytes + size);
+        }
+        static bool __read_tag(__record_tag tag) {
+            if (InputRecorder::__replay_cursor >= InputRecorder::__replay_size) return false;
+            if (InputRecorder::__replay_data[InputRecorder::__replay_cursor] != (uint8_t)tag) return false;
+            InputRecorder::__replay_cursor++;
+            return true;
+        }
+        static bool __read(void* data, size_t size) {
+            if (InputRecorder::__replay_cursor + size > InputRecorder::__replay_size) return false;
+            std::memcpy(data, InputRecorder::__replay_data + InputRecorder::__replay_cursor, size);
+            InputRecorder::__replay_cursor += size;
+            return true;
+        }
+        /// @brief Check if the given event type can be recorded (doesn't contain pointers).
+        static bool __is_recordable(Uint32 type) {
+            if (type == SDL_SYSWMEVENT) return false;
+#if SDL_VERSION_ATLEAST(2, 0, 22)
+            if (type == SDL_TEXTEDITING_EXT) return false;
+#endif
+            return type < SDL_DROPFILE || (type > SDL_DROPCOMPLETE && type < SDL_USEREVENT);
+        }
+        /// @brief Check if the given event type have the windowID field (at the same offset as SDL_WindowEvent).
+        static bool __has_window_id(Uint32 type) {
+            return type == SDL_WINDOWEVENT || (type >= SDL_KEYDOWN && type <= SDL_TEXTINPUT) ||
+                (type >= SDL_MOUSEMOTION && type <= SDL_MOUSEWHEEL);
+        }
+        /// @brief End the replay, and raise the Replay Finished Event.
+        static void __finish_replay() {
+            __stop_replay();
+            InputRecorder::ReplayFinishedEvent.Call();
+            if (InputRecorder::StopOnReplayEnd) Application::Stop();
+        }
+        static void __stop_recording() {
+            InputRecorder::__is_stop_recording_requested = false;
+            if (!InputRecorder::__file) return;
+            if (!InputRecorder::__buffer.empty())
+                SDL_RWwrite(InputRecorder::__file, InputRecorder::__buffer.data(), 1, InputRecorder::__buffer.size());
+            InputRecorder::__buffer.clear();
+            SDL_RWclose(InputRecorder::__file);
+            InputRecorder::__file = nullptr;
+        }
+        static void __stop_replay() {
+            InputRecorder::__is_stop_replay_requested = false;
+            if (!InputRecorder::__is_replaying) return;
+            SDL_free(InputRecorder::__replay_data);
+            InputRecorder::__replay_data = nullptr;
+            InputRecorder::__replay_size = 0;
+            InputRecorder::__replay_cursor = 0;
+            InputRecorder::__is_replaying = false;
+            InputRecorder::__is_headless = false;
+        }
+    public:
+        /// @brief If this true, Application::Stop() is called when the replay finished. Default is false.
+        static bool StopOnReplayEnd;
+        /// @brief The Replay Finished Event, occurred when all recorded frames are replayed.
+        static GlobalEventCaller<EventArgs> ReplayFinishedEvent;
+
+        /// @brief Start recording into the given file, the file will be overwritten. The recording start at the next frame.
+        /// @param file_path The file path to record into.
+        /// @return true on success, false on failed (can't open the file, or is recording or replaying).
+        static bool StartRecording(const std::string& file_path) {
+            if (IsRecording() || IsReplaying()) return false;
+            InputRecorder::__pending_file = SDL_RWFromFile(file_path.c_str(), "wb");
+            return InputRecorder::__pending_file != nullptr;
+        }
+        /// @brief Stop recording, and close the file at the end of the current frame.
+        static void StopRecording() {
+            if (InputRecorder::__pending_file) {
+                SDL_RWclose(InputRecorder::__pending_file);
+                InputRecorder::__pending_file = nullptr;
+            }
+            if (InputRecorder::__file) InputRecorder::__is_stop_recording_requested = true;
+        }
+        /// @brief Check if the Input Recorder is recording (or will start recording at the next frame).
+        /// @return true if recording, false otherwise.
+        static bool IsRecording() {
+            return InputRecorder::__pending_file || (InputRecorder::__file && !InputRecorder::__is_stop_recording_requested);
+        }
+
+        /// @brief Start replaying the given file at the next frame. The whole file is loaded into memory, so the replay
+        /// doesn't read the disk.
+        /// @param file_path The file path to replay.
+        /// @param headless If true, the Game Scene is updated but not rendered, and the Application doesn't wait between
+        /// updates, so only the simulation is timed. Default is false.
+        /// @return true on success, false on failed (can't load the file, the file is not recorded by the same build, or is
+        /// recording or replaying).
+        static bool StartReplay(const std::string& file_path, bool headless = false) {
+            if (IsRecording() || IsReplaying()) return false;
+            size_t size = 0;
+            uint8_t* data = (uint8_t*)SDL_LoadFile(file_path.c_str(), &size);
+            if (!data) return false;
+            __header header;
+            if (size < sizeof(header)) { SDL_free(data); return false; }
+            std::memcpy(&header, data, sizeof(header));
+            if (header.magic != ENGINE_INPUT_RECORD_MAGIC || header.version != ENGINE_INPUT_RECORD_VERSION ||
+                header.event_size != sizeof(SDL_Event) || header.snapshot_size != sizeof(InputSnapshot)) {
+                SDL_free(data);
+                return false;
+            }
+            InputRecorder::__pending_replay_data = data;
+            InputRecorder::__pending_replay_size = size;
+            InputRecorder::__is_pending_headless = headless;
+            return true;
+        }
+        /// @brief Stop replaying at the end of the current frame. The measured frame times are kept until the next replay.
+        static void StopReplay() {
+            if (InputRecorder::__pending_replay_data) {
+                SDL_free(InputRecorder::__pending_replay_data);
+                InputRecorder::__pending_replay_data = nullptr;
+                InputRecorder::__pending_replay_size = 0;
+            }
+            if (InputRecorder::__is_replaying) InputRecorder::__is_stop_replay_requested = true;
+        }
+        /// @brief Check if the Input Recorder is replaying (or will start replaying at the next frame).
+        /// @return true if replaying, false otherwise.
+        static bool IsReplaying() {
+            return InputRecorder::__pending_replay_data ||
+                (InputRecorder::__is_replaying && !InputRecorder::__is_stop_replay_requested);
+        }
+        /// @brief Check if the Input Recorder is replaying in headless mode.
+        /// @return true if replaying in headless mode, false otherwise.
+        static bool IsHeadless() { return InputRecorder::__is_headless; }
+
+        /// @brief Get the number of frames that recorded or replayed.
+        /// @return The number of frames.
+        static size_t GetFrameCount() { return InputRecorder::__frame_count; }
+        /// @brief Get the measured time of each replayed frame.
+        /// @return The measured frame times in seconds.
+        static const std::vector<double>& GetReplayFrameTimes() { return InputRecorder::__frame_times; }
+
+        /// @brief Apply the requested starts and stops of recording and replaying. This is called by Application::Start()
+        /// at the beginning of each frame, before handling the Window events.
+        static void BeginFrame() {
+            if (InputRecorder::__is_stop_recording_requested) __stop_recording();
+            if (InputRecorder::__is_stop_replay_requested) __stop_replay();
+            if (InputRecorder::__pending_file) {
+                InputRecorder::__file = InputRecorder::__pending_file;
+                InputRecorder::__pending_file = nullptr;
+                __header header = { ENGINE_INPUT_RECORD_MAGIC, ENGINE_INPUT_RECORD_VERSION, (uint32_t)sizeof(SDL_Event), (uint32_t)sizeof(InputSnapshot) };
+                InputRecorder::__buffer.clear();
+                __write(&header, sizeof(header));
+                InputRecorder::__frame_count = 0;
+            }
+            if (InputRecorder::__pending_replay_data) {
+                InputRecorder::__replay_data = InputRecorder::__pending_replay_data;
+                InputRecorder::__replay_size = InputRecorder::__pending_replay_size;
+                InputRecorder::__replay_cursor = sizeof(__header);
+                InputRecorder::__is_replaying = true;
+                InputRecorder::__is_headless = InputRecorder::__is_pending_headless;
+                InputRecorder::__is_queue_flushed = false;
+                InputRecorder::__frame_times.clear();
+                InputRecorder::__frame_count = 0;
+                InputRecorder::__pending_replay_data = nullptr;
+                InputRecorder::__pending_replay_size = 0;
+            }
+        }
+        /// @brief Stop recording and replaying right away, and drop the requests. This is called by Engine::Deinitialize()
+        static void Deinitialize() {
+            StopRecording();
+            StopReplay();
+            __stop_recording();
+            __stop_replay();
+        }
+
+        /// @brief Poll the next event. While recording, the event is polled from SDL and recorded. While replaying, the
+        /// event is read from the recorded frame. This is called by Application::HandleWindowEvent().
+        /// @param event The event to poll into.
+        /// @return 1 if there's an event, 0 if there's no more event for this frame.
+        static int PollEvent(SDL_Event* event) {
+            if (!InputRecorder::__is_replaying) {
+                int result = SDL_PollEvent(event);
+                if (result && InputRecorder::__file && __is_recordable(event->type)) {
+                    SDL_Event recorded = *event;
+                    // The timestamp is stored relative to the frame, and rebased on replay.
+                    recorded.common.timestamp = event->common.timestamp - Input::GetSyncTicks();
+                    uint8_t tag = (uint8_t)__record_tag::Event;
+                    __write(&tag, 1);
+                    __write(&recorded, sizeof(recorded));
+                }
+                return result;
+            }
+
+            if (!InputRecorder::__is_queue_flushed) {
+                SDL_PumpEvents();
+                SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+                InputRecorder::__is_queue_flushed = true;
+            }
+            if (!__read_tag(__record_tag::Event)) return 0;
+            if (!__read(event, sizeof(SDL_Event))) { __finish_replay(); return 0; }
+            event->common.timestamp += Input::GetSyncTicks();
+            if (__has_window_id(event->type)) event->window.windowID = Window::GetID();
+            return 1;
+        }
+        /// @brief Record the input snapshot of the frame, or replace it with the recorded one while replaying. This is called
+        /// by Application::Start() after Input::Capture().
+        static void ProcessSnapshot() {
+            if (InputRecorder::__file) {
+                uint8_t tag = (uint8_t)__record_tag::Snapshot;
+                __write(&tag, 1);
+                __write(&Input::GetSnapshot(), sizeof(InputSnapshot));
+                return;
+            }
+            if (!InputRecorder::__is_replaying) return;
+
+            // Skip the events that not polled in this frame (e.g. the Window is not available).
+            SDL_Event skipped;
+            while (__read_tag(__record_tag::Event))
+                if (!__read(&skipped, sizeof(skipped))) { __finish_replay(); return; }
+            InputSnapshot snapshot;
+            if (!__read_tag(__record_tag::Snapshot) || !__read(&snapshot, sizeof(snapshot))) { __finish_replay(); return; }
+            Input::SetSnapshot(snapshot);
+        }
+        /// @brief End the frame. While recording, the delta time is recorded and the frame is written to the file. While
+        /// replaying, the measured frame time is kept and the recorded delta time is returned. This is called by
+        /// Application::Start() at the end of each update.
+        /// @param frame_time The measured time of the frame in seconds.
+        /// @return The delta time for the next frame.
+        static long double EndFrame(long double frame_time) {
+            if (InputRecorder::__file) {
+                double delta_time = (double)frame_time;
+                uint8_t tag = (uint8_t)__record_tag::Frame;
+                __write(&tag, 1);
+                __write(&delta_time, sizeof(delta_time));
+                SDL_RWwrite(InputRecorder::__file, InputRecorder::__buffer.data(), 1, InputRecorder::__buffer.size());
+                InputRecorder::__buffer.clear();
+                InputRecorder::__frame_count++;
+                return frame_time;
+            }
+            if (!InputRecorder::__is_replaying) return frame_time;
+
+            InputRecorder::__frame_times.push_back((double)frame_time);
+            double delta_time = 0.0;
+            if (!__read_tag(__record_tag::Frame) || !__read(&delta_time, sizeof(delta_time))) {
+                __finish_replay();
+                return frame_time;
+            }
+            InputRecorder::__frame_count++;
+            InputRecorder::__is_queue_flushed = false;
+            if (InputRecorder::__replay_cursor >= InputRecorder::__replay_size) __finish_replay();
+            return delta_time;
+        }
+    };
+}
+
+SDL_RWops* Engine::InputRecorder::__file = nullptr;
+std::vector<uint8_t> Engine::InputRecorder::__buffer = std::vector<uint8_t>();
+
+uint8_t* Engine::InputRecorder::__replay_data = nullptr;
+size_t Engine::InputRecorder::__replay_size = 0;
+size_t Engine::InputRecorder::__replay_cursor = 0;
+bool Engine::InputRecorder::__is_replaying = false;
+bool Engine::InputRecorder::__is_headless = false;
+bool Engine::InputRecorder::__is_queue_flushed = false;
+std::vector<double> Engine::InputRecorder::__frame_times = std::vector<double>();
+
+size_t Engine::InputRecorder::__frame_count = 0;
+
+SDL_RWops* Engine::InputRecorder::__pending_file = nullptr;
+uint8_t* Engine::InputRecorder::__pending_replay_data = nullptr;
+size_t Engine::InputRecorder::__pending_replay_size = 0;
+bool Engine::InputRecorder::__is_pending_headless = false;
+bool Engine::InputRecorder::__is_stop_recording_requested = false;
+bool Engine::InputRecorder::__is_stop_replay_requested = false;
+
+bool Engine::InputRecorder::StopOnReplayEnd = false;
+Engine::GlobalEventCaller<Engine::EventArgs> Engine::InputRecorder::ReplayFinishedEvent = Engine::GlobalEventCaller<Engine::EventArgs>();
+
+#endif // __ENGINE_INPUTRECORDER_H__
\ No newline at end of file
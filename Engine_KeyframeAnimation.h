@@ -0,0 +1,334 @@
+#ifndef __ENGINE_KEYFRAMEANIMATION_H__
+#define __ENGINE_KEYFRAMEANIMATION_H__
+
+#include "Engine_Animation.h"
+#include "Engine_Math.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace Engine {
+    /// @brief The Animation Track Target, use to define which property of the Game Object an Animation Track animate.
+    enum class AnimationTrackTarget {
+        /// @brief The Position of the Game Object (2 channels, X and Y).
+        Position = 0,
+        /// @brief The Size of the Game Object (2 channels, Width and Height).
+        Size = 1,
+        /// @brief The BackgroundColor of the Game Object (4 channels, Red, Green, Blue and Alpha).
+        BackgroundColor = 2,
+        /// @brief The Rotation of the Game Object (1 channel, in degrees).
+        Rotation = 3,
+        /// @brief A custom float value (1 channel), read from the player or bound to a float variable.
+        Custom = 4
+    };
+
+    /// @brief The Animation Track class, provide a sorted list of keyframes for one property. The segment between two
+    /// consecutive keys use the Interpolation Function of the first key.
+    class AnimationTrack {
+    private:
+        AnimationTrackTarget __target = AnimationTrackTarget::Custom;
+        std::string __name = "";
+        size_t __channels = 1;
+
+        std::vector<double> __times;
+        std::vector<float> __values;
+        std::vector<InterpolationFunction> __functions;
+
+        bool __add_key(double time, const float* values, InterpolationFunction function) {
+            // Insert after the keys with the same time, so the order of adding is kept.
+            size_t index = (size_t)(std::upper_bound(__times.begin(), __times.end(), time) - __times.begin());
+            __times.insert(__times.begin() + index, time);
+            __functions.insert(__functions.begin() + index, function);
+            __values.insert(__values.begin() + index * __channels, values, values + __channels);
+            return true;
+        }
+    public:
+        /// @brief Create a new Animation Track.
+        /// @param Target The property that the track animate.
+        /// @param Name The name of the track, use to find Custom tracks. Default is an empty string.
+        AnimationTrack(AnimationTrackTarget Target, const std::string& Name = "") : __target(Target), __name(Name) {
+            switch (Target)
+            {
+            case AnimationTrackTarget::Position:
+            case AnimationTrackTarget::Size: __channels = 2; break;
+            case AnimationTrackTarget::BackgroundColor: __channels = 4; break;
+            default: __channels = 1; break;
+            }
+        }
+
+        /// @brief Get the property that the Animation Track animate.
+        /// @return The target of the track.
+        AnimationTrackTarget GetTarget() const { return __target; }
+        /// @brief Get the name of the Animation Track.
+        /// @return The name of the track.
+        const std::string& GetName() const { return __name; }
+        /// @brief Get the number of channels (values per key) of the Animation Track.
+        /// @return The number of channels.
+        size_t GetChannelCount() const { return __channels; }
+        /// @brief Get the number of keys of the Animation Track.
+        /// @return The number of keys.
+        size_t GetKeyCount() const { return __times.size(); }
+        /// @brief Get the time of the given key.
+        /// @param Index The index of the key.
+        /// @return The time of the key in seconds, or 0 on invalid index.
+        double GetKeyTime(size_t Index) const { return Index < __times.size() ? __times[Index] : 0.0; }
+        /// @brief Get the duration of the Animation Track (the time of the last key).
+        /// @return The duration in seconds, or 0 if there's no key.
+        double GetDuration() const { return __times.empty() ? 0.0 : __times.back(); }
+
+        /// @brief Add a key to a 1 channel track (Rotation or Custom).
+        /// @param Time The time of the key in seconds.
+        /// @param Value The value of the key.
+        /// @param Function The Interpolation Function of the segment start from this key. Default is Linear.
+        /// @return true on success, false on failed (the track doesn't have 1 channel).
+        bool AddKey(double Time, float Value, InterpolationFunction Function = InterpolationFunction::Linear) {
+            if (__channels != 1) return false;
+            return __add_key(Time, &Value, Function);
+        }
+        /// @brief Add a key to a Position track.
+        /// @param Time The time of the key in seconds.
+        /// @param Value The position of the key.
+        /// @param Function The Interpolation Function of the segment start from this key. Default is Linear.
+        /// @return true on success, false on failed (the track isn't a Position track).
+        bool AddKey(double Time, const Point& Value, InterpolationFunction Function = InterpolationFunction::Linear) {
+            if (__target != AnimationTrackTarget::Position) return false;
+            float values[2] = { (float)Value.X, (float)Value.Y };
+            return __add_key(Time, values, Function);
+        }
+        /// @brief Add a key to a Size track.
+        /// @param Time The time of the key in seconds.
+        /// @param Value The size of the key.
+        /// @param Function The Interpolation Function of the segment start from this key. Default is Linear.
+        /// @return true on success, false on failed (the track isn't a Size track).
+        bool AddKey(double Time, const Engine::Size& Value, InterpolationFunction Function = InterpolationFunction::Linear) {
+            if (__target != AnimationTrackTarget::Size) return false;
+            float values[2] = { (float)Value.Width, (float)Value.Height };
+            return __add_key(Time, values, Function);
+        }
+        /// @brief Add a key to a BackgroundColor track.
+        /// @param Time The time of the key in seconds.
+        /// @param Value The color of the key.
+        /// @param Function The Interpolation Function of the segment start from this key. Default is Linear.
+        /// @return true on success, false on failed (the track isn't a BackgroundColor track).
+        bool AddKey(double Time, const Engine::Color& Value, InterpolationFunction Function = InterpolationFunction::Linear) {
+            if (__target != AnimationTrackTarget::BackgroundColor) return false;
+            float values[4] = { (float)Value.Red, (float)Value.Green, (float)Value.Blue, (float)Value.Alpha };
+            return __add_key(Time, values, Function);
+        }
+        /// @brief Remove all keys of the Animation Track.
+        void ClearKeys() { __times.clear(); __values.clear(); __functions.clear(); }
+
+        /// @brief Find the segment that contain the given time, starting from the given cursor. For forward playback the
+        /// segment is the cursor or one of the next few, otherwise (e.g. seeking backward) a binary search is used.
+        /// @param Time The time to find.
+        /// @param Cursor The segment found by the last call, use as the hint.
+        /// @return The index of the first key of the segment.
+        size_t FindSegment(double Time, size_t Cursor) const {
+            size_t count = __times.size();
+            if (count < 2) return 0;
+            if (Cursor > count - 2) Cursor = count - 2;
+            if (Time >= __times[Cursor]) {
+                for (int step = 0; step < 4; step++) {
+                    if (Cursor == count - 2 || Time < __times[Cursor + 1]) return Cursor;
+                    Cursor++;
+                }
+            }
+            size_t index = (size_t)(std::upper_bound(__times.begin(), __times.end(), Time) - __times.begin());
+            return index == 0 ? 0 : ENGINE_MIN(index - 1, count - 2);
+        }
+        /// @brief Evaluate the Animation Track at the given time.
+        /// @param Time The time to evaluate, the values are held before the first key and after the last key.
+        /// @param Cursor The cursor of the track, updated to the segment of the given time.
+        /// @param Values The output values, must hold GetChannelCount() values. Not written if there's no key.
+        void Evaluate(double Time, size_t& Cursor, float* Values) const {
+            size_t count = __times.size();
+            if (count == 0) return;
+            if (count == 1 || Time <= __times[0]) { std::copy(__values.begin(), __values.begin() + __channels, Values); return; }
+            if (Time >= __times[count - 1]) { std::copy(__values.end() - __channels, __values.end(), Values); return; }
+
+            Cursor = FindSegment(Time, Cursor);
+            double span = __times[Cursor + 1] - __times[Cursor];
+            double t = span > 0 ? (Time - __times[Cursor]) / span : 1.0;
+            const float* a = __values.data() + Cursor * __channels;
+            const float* b = a + __channels;
+            for (size_t c = 0; c < __channels; c++)
+                Values[c] = (float)Interpolation::FromInterpolationFunction(__functions[Cursor], a[c], b[c], t);
+        }
+    };
+
+    /// @brief The Animation Clip class, provide a bundle of Animation Tracks. A clip is immutable while playing and can be
+    /// shared by any number of Clip Animation Scripts, each of them only keep a pointer to the clip and its own cursors.
+    class AnimationClip {
+    private:
+        std::vector<AnimationTrack> __tracks;
+
+        static bool __is_destroy_all;
+        static std::unordered_set<AnimationClip*> __created_clips;
+    public:
+        /// @brief The name of the Animation Clip. Default is "Animation Clip".
+        std::string Name = "Animation Clip";
+
+        /// @brief Create a new empty Animation Clip, should be created with 'new' keyword (new AnimationClip()).
+        AnimationClip() { AnimationClip::__created_clips.insert(this); }
+        virtual ~AnimationClip() {
+            if (!AnimationClip::__is_destroy_all)
+                AnimationClip::__created_clips.erase(this);
+        }
+
+        ENGINE_NOT_COPYABLE(AnimationClip)
+        ENGINE_NOT_ASSIGNABLE(AnimationClip)
+
+        /// @brief Add a new track to the Animation Clip.
+        /// @param Target The property that the track animate.
+        /// @param Name The name of the track, use to find Custom tracks. Default is an empty string.
+        /// @return The index of the new track.
+        size_t AddTrack(AnimationTrackTarget Target, const std::string& Name = "") {
+            __tracks.emplace_back(Target, Name);
+            return __tracks.size() - 1;
+        }
+        /// @brief Get the track at the given index. The pointer is invalidated by AddTrack().
+        /// @param Index The index of the track.
+        /// @return The track, or nullptr on invalid index.
+        AnimationTrack* GetTrack(size_t Index) { return Index < __tracks.size() ? &__tracks[Index] : nullptr; }
+        /// @brief Get the track at the given index.
+        /// @param Index The index of the track.
+        /// @return The track, or nullptr on invalid index.
+        const AnimationTrack* GetTrack(size_t Index) const { return Index < __tracks.size() ? &__tracks[Index] : nullptr; }
+        /// @brief Find the first track with the given name.
+        /// @param Name The name to find.
+        /// @return The index of the track, or -1 if not found.
+        int FindTrack(const std::string& Name) const {
+            for (size_t i = 0; i < __tracks.size(); i++)
+                if (__tracks[i].GetName() == Name) return (int)i;
+            return -1;
+        }
+        /// @brief Get the number of tracks of the Animation Clip.
+        /// @return The number of tracks.
+        size_t GetTrackCount() const { return __tracks.size(); }
+        /// @brief Get the duration of the Animation Clip (the time of the last key of all tracks).
+        /// @return The duration in seconds.
+        double GetDuration() const {
+            double duration = 0.0;
+            for (const AnimationTrack& track : __tracks) duration = ENGINE_MAX(duration, track.GetDuration());
+            return duration;
+        }
+
+        /// @brief Destroy all created Animation Clips. This will be called on Engine::Deinitialize().
+        static void DestroyAllCreatedClips() {
+            AnimationClip::__is_destroy_all = true;
+            for (AnimationClip* clip : AnimationClip::__created_clips)
+                if (clip) delete clip;
+            AnimationClip::__created_clips.clear();
+            AnimationClip::__is_destroy_all = false;
+        }
+    };
+
+    /// @brief The Clip Animation Script, provide an Animation Script that play an Animation Clip on the target Game Object.
+    /// The duration of the script is the duration of the clip. Custom tracks are not applied to the Game Object, their
+    /// values can be read with GetCustomValue() or written to a variable with BindCustomValue().
+    class ClipAnimationScript : public AnimationScript {
+    private:
+        const AnimationClip* __clip = nullptr;
+        std::vector<size_t> __cursors;
+        std::vector<float> __custom_values;
+        std::vector<float*> __custom_bindings;
+
+        void __prepare() {
+            size_t count = __clip ? __clip->GetTrackCount() : 0;
+            __cursors.resize(count, 0);
+            __custom_values.resize(count, 0.0f);
+            __custom_bindings.resize(count, nullptr);
+        }
+    protected:
+        void OnStartAnimation(GameObject* Target) override {
+            __prepare();
+            if (__clip) SetDuration(__clip->GetDuration());
+        }
+        void OnUpdateAnimation(GameObject* Target, double AnimationTime) override {
+            if (!__clip || !Target) return;
+            __prepare();
+            double time = AnimationTime * GetDuration();
+            for (size_t i = 0; i < __cursors.size(); i++) {
+                const AnimationTrack* track = __clip->GetTrack(i);
+                if (track->GetKeyCount() == 0) continue;
+                float values[4];
+                track->Evaluate(time, __cursors[i], values);
+                switch (track->GetTarget())
+                {
+                case AnimationTrackTarget::Position:
+                    Target->SetPrecisePosition(Vec2f(values[0], values[1]));
+                    break;
+                case AnimationTrackTarget::Size:
+                    Target->Size.Width = (int)std::floor(values[0] + 0.5f);
+                    Target->Size.Height = (int)std::floor(values[1] + 0.5f);
+                    break;
+                case AnimationTrackTarget::BackgroundColor:
+                    Target->BackgroundColor.Red = (uint8_t)ENGINE_FAST_CLAMP(0.0f, 255.0f, values[0] + 0.5f);
+                    Target->BackgroundColor.Green = (uint8_t)ENGINE_FAST_CLAMP(0.0f, 255.0f, values[1] + 0.5f);
+                    Target->BackgroundColor.Blue = (uint8_t)ENGINE_FAST_CLAMP(0.0f, 255.0f, values[2] + 0.5f);
+                    Target->BackgroundColor.Alpha = (uint8_t)ENGINE_FAST_CLAMP(0.0f, 255.0f, values[3] + 0.5f);
+                    break;
+                case AnimationTrackTarget::Rotation:
+                    Target->Rotation = values[0];
+                    break;
+                default:
+                    __custom_values[i] = values[0];
+                    if (__custom_bindings[i]) *__custom_bindings[i] = values[0];
+                    break;
+                }
+            }
+        }
+    public:
+        /// @brief Create a new Clip Animation Script, should be created with 'new' keyword.
+        /// @param Clip The Animation Clip to play. Default is nullptr mean there's no clip.
+        ClipAnimationScript(const AnimationClip* Clip = nullptr) { SetClip(Clip); }
+        virtual ~ClipAnimationScript() {}
+
+        ENGINE_NOT_COPYABLE(ClipAnimationScript)
+        ENGINE_NOT_ASSIGNABLE(ClipAnimationScript)
+
+        /// @brief Set the Animation Clip to play, this will reset the cursors and the custom value bindings.
+        /// @param Clip The Animation Clip to set, can be nullptr.
+        void SetClip(const AnimationClip* Clip) {
+            __clip = Clip;
+            __cursors.clear(); __custom_values.clear(); __custom_bindings.clear();
+            __prepare();
+            if (__clip) SetDuration(__clip->GetDuration());
+        }
+        /// @brief Get the Animation Clip of the Clip Animation Script.
+        /// @return The Animation Clip, or nullptr if there's none.
+        const AnimationClip* GetClip() const { return __clip; }
+
+        /// @brief Get the current value of the given Custom track.
+        /// @param TrackIndex The index of the track in the clip.
+        /// @return The current value, or 0 on invalid index.
+        float GetCustomValue(size_t TrackIndex) const { return TrackIndex < __custom_values.size() ? __custom_values[TrackIndex] : 0.0f; }
+        /// @brief Get the current value of the first Custom track with the given name.
+        /// @param Name The name of the track.
+        /// @return The current value, or 0 if not found.
+        float GetCustomValue(const std::string& Name) const {
+            int index = __clip ? __clip->FindTrack(Name) : -1;
+            return index < 0 ? 0.0f : GetCustomValue((size_t)index);
+        }
+        /// @brief Bind a variable to the first Custom track with the given name, the variable is written on each update.
+        /// @param Name The name of the track.
+        /// @param Variable The variable to write, nullptr to unbind. Must outlive the binding.
+        /// @return true on success, false if the track is not found.
+        bool BindCustomValue(const std::string& Name, float* Variable) {
+            int index = __clip ? __clip->FindTrack(Name) : -1;
+            if (index < 0) return false;
+            __prepare();
+            __custom_bindings[index] = Variable;
+            return true;
+        }
+    };
+}
+
+bool Engine::AnimationClip::__is_destroy_all = false;
+std::unordered_set<Engine::AnimationClip*> Engine::AnimationClip::__created_clips = std::unordered_set<Engine::AnimationClip*>();
+
+#endif // __ENGINE_KEYFRAMEANIMATION_H__
\ No newline at end of file
@@ -2,8 +2,19 @@
 #define __ENGINE_MATH_H__
 
 #include "Engine_Define.h"
+#include "Engine_Structure.h"
 
 #include <math.h>
+#include <stddef.h>
+#include <utility>
+#if __has_include(<span>)
+#include <span>
+#endif
+
+// The number of Interpolation Functions.
+#define ENGINE_INTERPOLATION_FUNCTION_COUNT 27
+// The number of segments of the lookup table of each expensive easing curve.
+#define ENGINE_EASING_LUT_SIZE 256
 
 namespace Engine {
     /// @brief The Interpolation Function, use to define the type of the interpolation function.
@@ -12,7 +23,296 @@ namespace Engine {
         Smoothstep = 1,
         Smootherstep = 2,
         EaseIn = 3,
-        EaseOut = 4
+        EaseOut = 4,
+        EaseInOut = 5,
+
+        CubicIn = EaseIn,
+        CubicOut = EaseOut,
+        CubicInOut = EaseInOut,
+        QuadIn = 6,
+        QuadOut = 7,
+        QuadInOut = 8,
+        QuartIn = 9,
+        QuartOut = 10,
+        QuartInOut = 11,
+        ExpoIn = 12,
+        ExpoOut = 13,
+        ExpoInOut = 14,
+        SineIn = 15,
+        SineOut = 16,
+        SineInOut = 17,
+        BackIn = 18,
+        BackOut = 19,
+        BackInOut = 20,
+        ElasticIn = 21,
+        ElasticOut = 22,
+        ElasticInOut = 23,
+        BounceIn = 24,
+        BounceOut = 25,
+        BounceInOut = 26
+    };
+
+    /// @brief The Easing class, provide the easing curves of the Interpolation Functions, mapping t in [0, 1] to the eased
+    /// value (0 at t = 0 and 1 at t = 1, may overshoot for Back and Elastic). The curves that need transcendental functions
+    /// (Expo, Sine and Elastic) also have lookup tables generated at compile time, evaluated with linear interpolation when
+    /// UseLookupTable is true. The batch Evaluate() resolve the function once and run a tight loop over the values.
+    class Easing final {
+    private:
+        struct __table { double values[ENGINE_EASING_LUT_SIZE + 1]; };
+
+        static constexpr double __pi = 3.14159265358979323846;
+
+        // Compile-time versions of sin and exp2, only used to generate the lookup tables.
+        static constexpr double __constexpr_sin(double x) {
+            long long k = (long long)(x / (2.0 * __pi) + (x >= 0 ? 0.5 : -0.5));
+            x -= (double)k * 2.0 * __pi;
+            double term = x, sum = x;
+            for (int n = 1; n < 14; n++) {
+                term *= -x * x / (double)((2 * n) * (2 * n + 1));
+                sum += term;
+            }
+            return sum;
+        }
+        static constexpr double __constexpr_exp2(double x) {
+            long long n = (long long)x;
+            if ((double)n > x) n--;
+            double f = (x - (double)n) * 0.69314718055994530942;
+            double term = 1.0, sum = 1.0;
+            for (int i = 1; i < 20; i++) {
+                term *= f / (double)i;
+                sum += term;
+            }
+            for (; n > 0; n--) sum *= 2.0;
+            for (; n < 0; n++) sum *= 0.5;
+            return sum;
+        }
+        template <bool IsConstexpr> static constexpr double __sin(double x) { return IsConstexpr ? __constexpr_sin(x) : ::sin(x); }
+        template <bool IsConstexpr> static constexpr double __cos(double x) { return IsConstexpr ? __constexpr_sin(x + __pi / 2.0) : ::cos(x); }
+        template <bool IsConstexpr> static constexpr double __exp2(double x) { return IsConstexpr ? __constexpr_exp2(x) : ::exp2(x); }
+
+        static constexpr double __bounce_out(double t) {
+            const double n1 = 7.5625, d1 = 2.75;
+            if (t < 1.0 / d1) return n1 * t * t;
+            if (t < 2.0 / d1) { t -= 1.5 / d1; return n1 * t * t + 0.75; }
+            if (t < 2.5 / d1) { t -= 2.25 / d1; return n1 * t * t + 0.9375; }
+            t -= 2.625 / d1;
+            return n1 * t * t + 0.984375;
+        }
+        /// @brief The definition of all easing curves, t must be in [0, 1].
+        template <bool IsConstexpr> static constexpr double __evaluate(InterpolationFunction function, double t) {
+            const double c1 = 1.70158, c2 = c1 * 1.525, c3 = c1 + 1.0;
+            const double c4 = 2.0 * __pi / 3.0, c5 = 2.0 * __pi / 4.5;
+            double u = 1.0 - t;
+            switch (function)
+            {
+            case InterpolationFunction::Smoothstep: return t * t * (3.0 - 2.0 * t);
+            case InterpolationFunction::Smootherstep: return t * t * t * (t * (6.0 * t - 15.0) + 10.0);
+            case InterpolationFunction::EaseIn: return t * t * t;
+            case InterpolationFunction::EaseOut: return 1.0 - u * u * u;
+            case InterpolationFunction::EaseInOut: return t < 0.5 ? 4.0 * t * t * t : 1.0 - 4.0 * u * u * u;
+            case InterpolationFunction::QuadIn: return t * t;
+            case InterpolationFunction::QuadOut: return 1.0 - u * u;
+            case InterpolationFunction::QuadInOut: return t < 0.5 ? 2.0 * t * t : 1.0 - 2.0 * u * u;
+            case InterpolationFunction::QuartIn: return t * t * t * t;
+            case InterpolationFunction::QuartOut: return 1.0 - u * u * u * u;
+            case InterpolationFunction::QuartInOut: return t < 0.5 ? 8.0 * t * t * t * t : 1.0 - 8.0 * u * u * u * u;
+            case InterpolationFunction::ExpoIn: return t <= 0.0 ? 0.0 : __exp2<IsConstexpr>(10.0 * t - 10.0);
+            case InterpolationFunction::ExpoOut: return t >= 1.0 ? 1.0 : 1.0 - __exp2<IsConstexpr>(-10.0 * t);
+            case InterpolationFunction::ExpoInOut:
+                if (t <= 0.0 || t >= 1.0) return t;
+                return t < 0.5 ? __exp2<IsConstexpr>(20.0 * t - 10.0) / 2.0 : (2.0 - __exp2<IsConstexpr>(10.0 - 20.0 * t)) / 2.0;
+            case InterpolationFunction::SineIn: return 1.0 - __cos<IsConstexpr>(t * __pi / 2.0);
+            case InterpolationFunction::SineOut: return __sin<IsConstexpr>(t * __pi / 2.0);
+            case InterpolationFunction::SineInOut: return (1.0 - __cos<IsConstexpr>(t * __pi)) / 2.0;
+            case InterpolationFunction::BackIn: return c3 * t * t * t - c1 * t * t;
+            case InterpolationFunction::BackOut: return 1.0 - c3 * u * u * u + c1 * u * u;
+            case InterpolationFunction::BackInOut:
+                return t < 0.5 ? (4.0 * t * t * ((c2 + 1.0) * 2.0 * t - c2)) / 2.0
+                               : ((2.0 * t - 2.0) * (2.0 * t - 2.0) * ((c2 + 1.0) * (2.0 * t - 2.0) + c2) + 2.0) / 2.0;
+            case InterpolationFunction::ElasticIn:
+                if (t <= 0.0 || t >= 1.0) return t;
+                return -__exp2<IsConstexpr>(10.0 * t - 10.0) * __sin<IsConstexpr>((t * 10.0 - 10.75) * c4);
+            case InterpolationFunction::ElasticOut:
+                if (t <= 0.0 || t >= 1.0) return t;
+                return __exp2<IsConstexpr>(-10.0 * t) * __sin<IsConstexpr>((t * 10.0 - 0.75) * c4) + 1.0;
+            case InterpolationFunction::ElasticInOut:
+                if (t <= 0.0 || t >= 1.0) return t;
+                return t < 0.5 ? -(__exp2<IsConstexpr>(20.0 * t - 10.0) * __sin<IsConstexpr>((20.0 * t - 11.125) * c5)) / 2.0
+                               : (__exp2<IsConstexpr>(10.0 - 20.0 * t) * __sin<IsConstexpr>((20.0 * t - 11.125) * c5)) / 2.0 + 1.0;
+            case InterpolationFunction::BounceIn: return 1.0 - __bounce_out(u);
+            case InterpolationFunction::BounceOut: return __bounce_out(t);
+            case InterpolationFunction::BounceInOut:
+                return t < 0.5 ? (1.0 - __bounce_out(1.0 - 2.0 * t)) / 2.0 : (1.0 + __bounce_out(2.0 * t - 1.0)) / 2.0;
+            default: return t;
+            }
+        }
+
+        /// @brief Get the index of the lookup table of the given function, or -1 if the function doesn't have one.
+        static constexpr int __table_index(InterpolationFunction function) {
+            int index = (int)function - (int)InterpolationFunction::ExpoIn;
+            if (index >= 0 && index < 6) return index;
+            index = (int)function - (int)InterpolationFunction::ElasticIn;
+            if (index >= 0 && index < 3) return 6 + index;
+            return -1;
+        }
+        static constexpr __table __make_table(InterpolationFunction function) {
+            __table table = {};
+            for (int i = 0; i <= ENGINE_EASING_LUT_SIZE; i++)
+                table.values[i] = __evaluate<true>(function, (double)i / ENGINE_EASING_LUT_SIZE);
+            return table;
+        }
+        static const __table __tables[9];
+
+        static double __lookup(const __table& table, double t) {
+            double x = t * ENGINE_EASING_LUT_SIZE;
+            int k = (int)x;
+            if (k >= ENGINE_EASING_LUT_SIZE) k = ENGINE_EASING_LUT_SIZE - 1;
+            return table.values[k] + (table.values[k + 1] - table.values[k]) * (x - k);
+        }
+        template <int F> static double __single(double t) { return __evaluate<false>((InterpolationFunction)F, t); }
+        template <int F, typename T> static void __batch(T* values, size_t count) {
+            for (size_t i = 0; i < count; i++) {
+                double t = ENGINE_FAST_CLAMP(0.0, 1.0, (double)values[i]);
+                values[i] = (T)__evaluate<false>((InterpolationFunction)F, t);
+            }
+        }
+        template <typename T> static void __batch_lookup(const __table& table, T* values, size_t count) {
+            for (size_t i = 0; i < count; i++) {
+                double t = ENGINE_FAST_CLAMP(0.0, 1.0, (double)values[i]);
+                values[i] = (T)__lookup(table, t);
+            }
+        }
+        template <int... F> static double (*__get_single(int function, std::integer_sequence<int, F...>))(double) {
+            static double (*const functions[])(double) = { &__single<F>... };
+            return functions[function];
+        }
+        template <typename T, int... F> static void (*__get_batch(int function, std::integer_sequence<int, F...>))(T*, size_t) {
+            static void (*const functions[])(T*, size_t) = { &__batch<F, T>... };
+            return functions[function];
+        }
+        template <typename T> static void __evaluate_batch(InterpolationFunction function, T* values, size_t count) {
+            if (!values) return;
+            int index = (int)function;
+            if (index < 0 || index >= ENGINE_INTERPOLATION_FUNCTION_COUNT) index = 0;
+            int table = __table_index((InterpolationFunction)index);
+            if (UseLookupTable && table >= 0) { __batch_lookup(__tables[table], values, count); return; }
+            __get_batch<T>(index, std::make_integer_sequence<int, ENGINE_INTERPOLATION_FUNCTION_COUNT>())(values, count);
+        }
+    public:
+        /// @brief If this true, the curves that need transcendental functions (Expo, Sine and Elastic) are evaluated from
+        /// their lookup tables with linear interpolation (the error is below 1e-3). Default is true.
+        static bool UseLookupTable;
+
+        /// @brief Evaluate the easing curve of the given function at compile time (or without the standard math library).
+        /// @param function The Interpolation Function.
+        /// @param t The time of the curve (will clamp to be between 0 and 1).
+        /// @return The eased value.
+        static constexpr double EvaluateConstant(InterpolationFunction function, double t) {
+            return __evaluate<true>(function, ENGINE_FAST_CLAMP(0.0, 1.0, t));
+        }
+        /// @brief Evaluate the easing curve of the given function exactly (never use the lookup table).
+        /// @param function The Interpolation Function. Will use Linear on invalid.
+        /// @param t The time of the curve (will clamp to be between 0 and 1).
+        /// @return The eased value.
+        static double EvaluateExact(InterpolationFunction function, double t) {
+            int index = (int)function;
+            if (index < 0 || index >= ENGINE_INTERPOLATION_FUNCTION_COUNT) index = 0;
+            t = ENGINE_FAST_CLAMP(0.0, 1.0, t);
+            return __get_single(index, std::make_integer_sequence<int, ENGINE_INTERPOLATION_FUNCTION_COUNT>())(t);
+        }
+        /// @brief Evaluate the easing curve of the given function.
+        /// @param function The Interpolation Function. Will use Linear on invalid.
+        /// @param t The time of the curve (will clamp to be between 0 and 1).
+        /// @return The eased value.
+        static double Evaluate(InterpolationFunction function, double t) {
+            int table = __table_index(function);
+            if (UseLookupTable && table >= 0) return __lookup(__tables[table], ENGINE_FAST_CLAMP(0.0, 1.0, t));
+            return EvaluateExact(function, t);
+        }
+        /// @brief Evaluate the easing curve of the given function for each of the given values, in place.
+        /// @param function The Interpolation Function. Will use Linear on invalid.
+        /// @param values The times of the curve (will clamp to be between 0 and 1), replaced with the eased values.
+        /// @param count The number of values.
+        static void Evaluate(InterpolationFunction function, double* values, size_t count) { __evaluate_batch(function, values, count); }
+        /// @brief Evaluate the easing curve of the given function for each of the given values, in place.
+        /// @param function The Interpolation Function. Will use Linear on invalid.
+        /// @param values The times of the curve (will clamp to be between 0 and 1), replaced with the eased values.
+        /// @param count The number of values.
+        static void Evaluate(InterpolationFunction function, float* values, size_t count) { __evaluate_batch(function, values, count); }
+#if defined(__cpp_lib_span)
+        /// @brief Evaluate the easing curve of the given function for each of the given values, in place.
+        /// @param function The Interpolation Function. Will use Linear on invalid.
+        /// @param values The times of the curve (will clamp to be between 0 and 1), replaced with the eased values.
+        static void Evaluate(InterpolationFunction function, std::span<double> values) { __evaluate_batch(function, values.data(), values.size()); }
+        /// @brief Evaluate the easing curve of the given function for each of the given values, in place.
+        /// @param function The Interpolation Function. Will use Linear on invalid.
+        /// @param values The times of the curve (will clamp to be between 0 and 1), replaced with the eased values.
+        static void Evaluate(InterpolationFunction function, std::span<float> values) { __evaluate_batch(function, values.data(), values.size()); }
+#endif
+    };
+
+    /// @brief The Cubic Bezier struct, provide a CSS-like cubic Bézier easing curve from (0, 0) to (1, 1) with the two
+    /// given control points. The x of the control points are clamped to [0, 1] so the curve is a function of x.
+    struct CubicBezier {
+    private:
+        double __ax = 0, __bx = 0, __cx = 0, __ay = 0, __by = 0, __cy = 0;
+
+        constexpr double __x(double t) const { return ((__ax * t + __bx) * t + __cx) * t; }
+        constexpr double __y(double t) const { return ((__ay * t + __by) * t + __cy) * t; }
+        constexpr double __dx(double t) const { return (3.0 * __ax * t + 2.0 * __bx) * t + __cx; }
+        /// @brief Solve the curve parameter for the given x, with Newton's method and bisection as the fallback.
+        constexpr double __solve(double x) const {
+            double t = x;
+            for (int i = 0; i < 8; i++) {
+                double error = __x(t) - x;
+                if (error < 1e-7 && error > -1e-7) return t;
+                double d = __dx(t);
+                if (d < 1e-6 && d > -1e-6) break;
+                t -= error / d;
+            }
+            double low = 0.0, high = 1.0;
+            t = x;
+            for (int i = 0; i < 40; i++) {
+                double value = __x(t);
+                if (value - x < 1e-7 && value - x > -1e-7) return t;
+                if (value < x) low = t; else high = t;
+                t = (low + high) / 2.0;
+            }
+            return t;
+        }
+    public:
+        /// @brief The first control point.
+        double X1 = 0, Y1 = 0;
+        /// @brief The second control point.
+        double X2 = 1, Y2 = 1;
+
+        /// @brief Create a new Cubic Bezier curve with the given control points (same as CSS cubic-bezier(x1, y1, x2, y2)).
+        constexpr CubicBezier(double x1, double y1, double x2, double y2)
+            : X1(ENGINE_FAST_CLAMP(0.0, 1.0, x1)), Y1(y1), X2(ENGINE_FAST_CLAMP(0.0, 1.0, x2)), Y2(y2) {
+            __cx = 3.0 * X1; __bx = 3.0 * (X2 - X1) - __cx; __ax = 1.0 - __cx - __bx;
+            __cy = 3.0 * Y1; __by = 3.0 * (Y2 - Y1) - __cy; __ay = 1.0 - __cy - __by;
+        }
+
+        /// @brief Evaluate the curve at the given x.
+        /// @param x The time of the curve (will clamp to be between 0 and 1).
+        /// @return The eased value.
+        constexpr double Evaluate(double x) const {
+            x = ENGINE_FAST_CLAMP(0.0, 1.0, x);
+            if (x <= 0.0 || x >= 1.0) return x;
+            return __y(__solve(x));
+        }
+        /// @brief Evaluate the curve for each of the given values, in place.
+        /// @param values The times of the curve (will clamp to be between 0 and 1), replaced with the eased values.
+        /// @param count The number of values.
+        void Evaluate(double* values, size_t count) const {
+            if (!values) return;
+            for (size_t i = 0; i < count; i++) values[i] = Evaluate(values[i]);
+        }
+#if defined(__cpp_lib_span)
+        /// @brief Evaluate the curve for each of the given values, in place.
+        /// @param values The times of the curve (will clamp to be between 0 and 1), replaced with the eased values.
+        void Evaluate(std::span<double> values) const { Evaluate(values.data(), values.size()); }
+#endif
     };
 
     /// @brief The Interpolation class, provide static basic interpolation function.
@@ -87,21 +387,281 @@ namespace Engine {
         /// @param t The interpolation value (will clamp to be between 0 and 1).
         /// @return The result of the interpolation.
         static double FromInterpolationFunction(InterpolationFunction function, double start, double end, double t) {
-            switch (function)
-            {
-            case Engine::InterpolationFunction::Smoothstep:
-                return Smoothstep(start, end, t);
-            case Engine::InterpolationFunction::Smootherstep:
-                return Smootherstep(start, end, t);
-            case Engine::InterpolationFunction::EaseIn:
-                return EaseIn(start, end, t);
-            case Engine::InterpolationFunction::EaseOut:
-                return Smoothstep(start, end, t);
-            default:
-                return Linear(start, end, t);
+            return start + (end - start) * Easing::Evaluate(function, t);
+        }
+        /// @brief Interpolation between start and end with the given Cubic Bezier curve.
+        /// @param curve The Cubic Bezier curve.
+        /// @param start The start value of the interpolation (when t = 0).
+        /// @param end The end value of the interpolation (when t = 1).
+        /// @param t The interpolation value (will clamp to be between 0 and 1).
+        /// @return The result of the interpolation.
+        static double FromCubicBezier(const CubicBezier& curve, double start, double end, double t) {
+            return start + (end - start) * curve.Evaluate(t);
+        }
+    };
+
+    /// @brief The Vec2f struct, represent a two-dimensional float vector (x, y). Use for sub-pixel positions, directions
+    /// and scales. The layout is two packed floats, so arrays of Vec2f can be processed with SIMD.
+    struct alignas(8) Vec2f {
+    public:
+        /// @brief The x value of the vector.
+        float X = 0.0f;
+        /// @brief The y value of the vector.
+        float Y = 0.0f;
+
+        static const Vec2f Zero;
+        static const Vec2f One;
+
+        /// @brief Create a new Vec2f, and set all value to 0.
+        constexpr Vec2f() = default;
+        /// @brief Create a new Vec2f.
+        /// @param X The x value of the vector.
+        /// @param Y The y value of the vector.
+        constexpr Vec2f(float X, float Y) : X(X), Y(Y) {}
+        /// @brief Create a new Vec2f from the given Point.
+        /// @param p The Point to convert.
+        explicit Vec2f(const Point& p) : X((float)p.X), Y((float)p.Y) {}
+        /// @brief Create a new Vec2f from the width and height of the given Size.
+        /// @param s The Size to convert.
+        explicit Vec2f(const Engine::Size& s) : X((float)s.Width), Y((float)s.Height) {}
+
+        /// @brief Convert the vector to a Point, rounded to the nearest integer.
+        /// @return The converted Point.
+        Point ToPoint() const { return Point((int)floorf(X + 0.5f), (int)floorf(Y + 0.5f)); }
+
+        constexpr Vec2f operator-() const { return {-X, -Y}; }
+        constexpr Vec2f operator+(const Vec2f& v) const { return {X + v.X, Y + v.Y}; }
+        constexpr Vec2f operator-(const Vec2f& v) const { return {X - v.X, Y - v.Y}; }
+        constexpr Vec2f operator*(const Vec2f& v) const { return {X * v.X, Y * v.Y}; }
+        constexpr Vec2f operator/(const Vec2f& v) const { return {X / v.X, Y / v.Y}; }
+        constexpr Vec2f operator*(float s) const { return {X * s, Y * s}; }
+        constexpr Vec2f operator/(float s) const { return {X / s, Y / s}; }
+        friend constexpr Vec2f operator*(float s, const Vec2f& v) { return {s * v.X, s * v.Y}; }
+
+        Vec2f& operator+=(const Vec2f& v) { X += v.X; Y += v.Y; return *this; }
+        Vec2f& operator-=(const Vec2f& v) { X -= v.X; Y -= v.Y; return *this; }
+        Vec2f& operator*=(const Vec2f& v) { X *= v.X; Y *= v.Y; return *this; }
+        Vec2f& operator*=(float s) { X *= s; Y *= s; return *this; }
+        Vec2f& operator/=(float s) { X /= s; Y /= s; return *this; }
+
+        constexpr bool operator==(const Vec2f& v) const { return X == v.X && Y == v.Y; }
+        constexpr bool operator!=(const Vec2f& v) const { return !(*this == v); }
+
+        /// @brief Get the dot product of this vector and the given vector.
+        constexpr float Dot(const Vec2f& v) const { return X * v.X + Y * v.Y; }
+        /// @brief Get the z value of the cross product of this vector and the given vector.
+        constexpr float Cross(const Vec2f& v) const { return X * v.Y - Y * v.X; }
+        /// @brief Get the squared length of the vector.
+        constexpr float LengthSquared() const { return X * X + Y * Y; }
+        /// @brief Get the length of the vector.
+        float Length() const { return sqrtf(LengthSquared()); }
+        /// @brief Get the vector with the same direction and length 1.
+        /// @return The normalized vector, or Vec2f::Zero if the length is 0.
+        Vec2f Normalized() const {
+            float length = Length();
+            return length > 0.0f ? Vec2f(X / length, Y / length) : Vec2f(0.0f, 0.0f);
+        }
+        /// @brief Linear interpolation between two vectors.
+        /// @param a The start vector (when t = 0).
+        /// @param b The end vector (when t = 1).
+        /// @param t The interpolation value (not clamped).
+        /// @return The result of the interpolation.
+        static constexpr Vec2f Lerp(const Vec2f& a, const Vec2f& b, float t) { return {a.X + (b.X - a.X) * t, a.Y + (b.Y - a.Y) * t}; }
+    };
+
+    /// @brief The RectF struct, represent a float rectangle with the top-left corner and the size.
+    struct RectF {
+    public:
+        /// @brief The x value of the top-left corner.
+        float X = 0.0f;
+        /// @brief The y value of the top-left corner.
+        float Y = 0.0f;
+        /// @brief The width of the rectangle.
+        float Width = 0.0f;
+        /// @brief The height of the rectangle.
+        float Height = 0.0f;
+
+        /// @brief Create a new empty RectF.
+        constexpr RectF() = default;
+        /// @brief Create a new RectF.
+        constexpr RectF(float X, float Y, float Width, float Height) : X(X), Y(Y), Width(Width), Height(Height) {}
+        /// @brief Create a new RectF from the given top-left corner and size.
+        constexpr RectF(const Vec2f& Position, const Vec2f& Size) : X(Position.X), Y(Position.Y), Width(Size.X), Height(Size.Y) {}
+        /// @brief Create a new RectF from the given Rectangle.
+        /// @param r The Rectangle to convert.
+        explicit RectF(const Rectangle& r) : X((float)r.X), Y((float)r.Y), Width((float)r.Width), Height((float)r.Height) {}
+
+        /// @brief Convert the RectF to a Rectangle, the edges are rounded to the nearest integer.
+        /// @return The converted Rectangle.
+        Rectangle ToRectangle() const {
+            int left = (int)floorf(X + 0.5f), top = (int)floorf(Y + 0.5f);
+            return Rectangle(left, top, (int)floorf(X + Width + 0.5f) - left, (int)floorf(Y + Height + 0.5f) - top);
+        }
+
+        constexpr float Left() const { return X; }
+        constexpr float Top() const { return Y; }
+        constexpr float Right() const { return X + Width; }
+        constexpr float Bottom() const { return Y + Height; }
+        constexpr Vec2f TopLeft() const { return {X, Y}; }
+        constexpr Vec2f BottomRight() const { return {X + Width, Y + Height}; }
+        constexpr Vec2f Center() const { return {X + Width * 0.5f, Y + Height * 0.5f}; }
+        constexpr Vec2f GetSize() const { return {Width, Height}; }
+        constexpr bool IsEmpty() const { return Width <= 0.0f || Height <= 0.0f; }
+
+        constexpr bool operator==(const RectF& r) const { return X == r.X && Y == r.Y && Width == r.Width && Height == r.Height; }
+        constexpr bool operator!=(const RectF& r) const { return !(*this == r); }
+
+        /// @brief Check if the given point is inside the rectangle (the right and bottom edges are excluded).
+        constexpr bool Contains(const Vec2f& p) const { return p.X >= X && p.Y >= Y && p.X < X + Width && p.Y < Y + Height; }
+        /// @brief Check if the rectangle overlap the given rectangle.
+        constexpr bool Intersects(const RectF& r) const { return X < r.X + r.Width && r.X < X + Width && Y < r.Y + r.Height && r.Y < Y + Height; }
+        /// @brief Get the overlapped area of this rectangle and the given rectangle.
+        /// @return The overlapped area, or an empty RectF if not overlapped.
+        constexpr RectF Intersection(const RectF& r) const {
+            float left = ENGINE_MAX(X, r.X), top = ENGINE_MAX(Y, r.Y);
+            float right = ENGINE_MIN(X + Width, r.X + r.Width), bottom = ENGINE_MIN(Y + Height, r.Y + r.Height);
+            return (right > left && bottom > top) ? RectF(left, top, right - left, bottom - top) : RectF();
+        }
+        /// @brief Get the smallest rectangle that contain both this rectangle and the given rectangle.
+        constexpr RectF Union(const RectF& r) const {
+            float left = ENGINE_MIN(X, r.X), top = ENGINE_MIN(Y, r.Y);
+            float right = ENGINE_MAX(X + Width, r.X + r.Width), bottom = ENGINE_MAX(Y + Height, r.Y + r.Height);
+            return RectF(left, top, right - left, bottom - top);
+        }
+        /// @brief Get the rectangle moved by the given offset.
+        constexpr RectF Offset(const Vec2f& v) const { return RectF(X + v.X, Y + v.Y, Width, Height); }
+        /// @brief Get the rectangle expanded by the given amount on each side.
+        constexpr RectF Inflate(float x, float y) const { return RectF(X - x, Y - y, Width + 2.0f * x, Height + 2.0f * y); }
+    };
+
+    /// @brief The Mat3x2f struct, represent a 2D affine transform as a 3x2 matrix, in the row-vector convention
+    /// (x' = x * M11 + y * M21 + M31, y' = x * M12 + y * M22 + M32). The product A * B apply A then B.
+    /// Rotations are in degrees, clockwise on the screen (where the y-axis point down), same as the Renderer.
+    struct Mat3x2f {
+    public:
+        float M11 = 1.0f, M12 = 0.0f;
+        float M21 = 0.0f, M22 = 1.0f;
+        float M31 = 0.0f, M32 = 0.0f;
+
+        /// @brief Create a new identity matrix.
+        constexpr Mat3x2f() = default;
+        /// @brief Create a new matrix from the given elements.
+        constexpr Mat3x2f(float m11, float m12, float m21, float m22, float m31, float m32)
+            : M11(m11), M12(m12), M21(m21), M22(m22), M31(m31), M32(m32) {}
+
+        /// @brief Get the identity matrix.
+        static constexpr Mat3x2f Identity() { return Mat3x2f(); }
+        /// @brief Get a translation matrix.
+        static constexpr Mat3x2f Translation(const Vec2f& v) { return Mat3x2f(1.0f, 0.0f, 0.0f, 1.0f, v.X, v.Y); }
+        /// @brief Get a scale matrix around the origin.
+        static constexpr Mat3x2f Scale(const Vec2f& s) { return Mat3x2f(s.X, 0.0f, 0.0f, s.Y, 0.0f, 0.0f); }
+        /// @brief Get a scale matrix around the given center.
+        static constexpr Mat3x2f Scale(const Vec2f& s, const Vec2f& center) {
+            return Mat3x2f(s.X, 0.0f, 0.0f, s.Y, center.X - center.X * s.X, center.Y - center.Y * s.Y);
+        }
+        /// @brief Get a rotation matrix around the origin.
+        /// @param degrees The angle in degrees, clockwise on the screen.
+        static Mat3x2f Rotation(float degrees) {
+            float radians = degrees * 0.017453292519943295f;
+            float c = cosf(radians), s = sinf(radians);
+            return Mat3x2f(c, s, -s, c, 0.0f, 0.0f);
+        }
+        /// @brief Get a rotation matrix around the given center.
+        /// @param degrees The angle in degrees, clockwise on the screen.
+        /// @param center The center of the rotation.
+        static Mat3x2f Rotation(float degrees, const Vec2f& center) {
+            return Translation(-center) * Rotation(degrees) * Translation(center);
+        }
+
+        constexpr Mat3x2f operator*(const Mat3x2f& m) const {
+            return Mat3x2f(
+                M11 * m.M11 + M12 * m.M21, M11 * m.M12 + M12 * m.M22,
+                M21 * m.M11 + M22 * m.M21, M21 * m.M12 + M22 * m.M22,
+                M31 * m.M11 + M32 * m.M21 + m.M31, M31 * m.M12 + M32 * m.M22 + m.M32);
+        }
+        constexpr bool operator==(const Mat3x2f& m) const {
+            return M11 == m.M11 && M12 == m.M12 && M21 == m.M21 && M22 == m.M22 && M31 == m.M31 && M32 == m.M32;
+        }
+        constexpr bool operator!=(const Mat3x2f& m) const { return !(*this == m); }
+
+        /// @brief Transform the given point (apply the translation).
+        constexpr Vec2f TransformPoint(const Vec2f& p) const { return {p.X * M11 + p.Y * M21 + M31, p.X * M12 + p.Y * M22 + M32}; }
+        /// @brief Transform the given vector (without the translation).
+        constexpr Vec2f TransformVector(const Vec2f& v) const { return {v.X * M11 + v.Y * M21, v.X * M12 + v.Y * M22}; }
+        /// @brief Get the axis-aligned bounding box of the given rectangle after transformed.
+        RectF TransformBounds(const RectF& r) const {
+            Vec2f a = TransformPoint(r.TopLeft()), b = TransformPoint(Vec2f(r.Right(), r.Y));
+            Vec2f c = TransformPoint(Vec2f(r.X, r.Bottom())), d = TransformPoint(r.BottomRight());
+            float left = ENGINE_MIN(ENGINE_MIN(a.X, b.X), ENGINE_MIN(c.X, d.X)), right = ENGINE_MAX(ENGINE_MAX(a.X, b.X), ENGINE_MAX(c.X, d.X));
+            float top = ENGINE_MIN(ENGINE_MIN(a.Y, b.Y), ENGINE_MIN(c.Y, d.Y)), bottom = ENGINE_MAX(ENGINE_MAX(a.Y, b.Y), ENGINE_MAX(c.Y, d.Y));
+            return RectF(left, top, right - left, bottom - top);
+        }
+        /// @brief Transform an array of points.
+        /// @param points The points to transform.
+        /// @param result The output points, can be the same as the input.
+        /// @param count The number of points.
+        void TransformPoints(const Vec2f* points, Vec2f* result, size_t count) const {
+            for (size_t i = 0; i < count; i++) {
+                float x = points[i].X, y = points[i].Y;
+                result[i].X = x * M11 + y * M21 + M31;
+                result[i].Y = x * M12 + y * M22 + M32;
+            }
+        }
+        /// @brief Transform an array of points stored as separated x and y arrays (SoA).
+        /// @param xs The x values of the points.
+        /// @param ys The y values of the points.
+        /// @param result_xs The output x values, can be the same as the input.
+        /// @param result_ys The output y values, can be the same as the input.
+        /// @param count The number of points.
+        void TransformPoints(const float* xs, const float* ys, float* result_xs, float* result_ys, size_t count) const {
+            for (size_t i = 0; i < count; i++) {
+                float x = xs[i], y = ys[i];
+                result_xs[i] = x * M11 + y * M21 + M31;
+                result_ys[i] = x * M12 + y * M22 + M32;
             }
         }
+
+        /// @brief Get the determinant of the matrix (negative if the transform flip).
+        constexpr float Determinant() const { return M11 * M22 - M12 * M21; }
+        /// @brief Get the inverse of the matrix.
+        /// @param result The output inverse matrix.
+        /// @return true on success, false if the matrix is not invertible.
+        constexpr bool Invert(Mat3x2f& result) const {
+            float det = Determinant();
+            if (det == 0.0f) return false;
+            float inv = 1.0f / det;
+            result = Mat3x2f(M22 * inv, -M12 * inv, -M21 * inv, M11 * inv,
+                             (M21 * M32 - M22 * M31) * inv, (M12 * M31 - M11 * M32) * inv);
+            return true;
+        }
+        /// @brief Get the translation of the matrix.
+        constexpr Vec2f GetTranslation() const { return {M31, M32}; }
+        /// @brief Get the rotation of the matrix in degrees (assuming there's no skew).
+        float GetRotation() const { return atan2f(M12, M11) * 57.29577951308232f; }
+        /// @brief Get the scale of the matrix (assuming there's no skew), the y scale is negative if the transform flip.
+        Vec2f GetScale() const {
+            float sx = sqrtf(M11 * M11 + M12 * M12);
+            return Vec2f(sx, sx > 0.0f ? Determinant() / sx : 0.0f);
+        }
+        /// @brief Check if the matrix only translate (no rotation, scale or skew).
+        constexpr bool IsTranslation() const { return M11 == 1.0f && M12 == 0.0f && M21 == 0.0f && M22 == 1.0f; }
     };
 }
 
+constexpr Engine::Vec2f Engine::Vec2f::Zero = Engine::Vec2f(0.0f, 0.0f);
+constexpr Engine::Vec2f Engine::Vec2f::One = Engine::Vec2f(1.0f, 1.0f);
+
+bool Engine::Easing::UseLookupTable = true;
+constexpr Engine::Easing::__table Engine::Easing::__tables[9] = {
+    Engine::Easing::__make_table(Engine::InterpolationFunction::ExpoIn),
+    Engine::Easing::__make_table(Engine::InterpolationFunction::ExpoOut),
+    Engine::Easing::__make_table(Engine::InterpolationFunction::ExpoInOut),
+    Engine::Easing::__make_table(Engine::InterpolationFunction::SineIn),
+    Engine::Easing::__make_table(Engine::InterpolationFunction::SineOut),
+    Engine::Easing::__make_table(Engine::InterpolationFunction::SineInOut),
+    Engine::Easing::__make_table(Engine::InterpolationFunction::ElasticIn),
+    Engine::Easing::__make_table(Engine::InterpolationFunction::ElasticOut),
+    Engine::Easing::__make_table(Engine::InterpolationFunction::ElasticInOut)
+};
+
 #endif // __ENGINE_MATH_H__
\ No newline at end of file
@@ -0,0 +1,421 @@
+#ifndef __ENGINE_MUSICPLAYLIST_H__
+#define __ENGINE_MUSICPLAYLIST_H__
+
+#define ENGINE_MUSIC_PLAYLIST_DECKS 2
+#define ENGINE_MUSIC_PLAYLIST_CROSSFADE_SEGMENT 64
+
+#include "Engine_AudioDevice.h"
+#include "Engine_SoundMixer.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+
+namespace Engine {
+    /// @brief The Crossfade Curve enum, contain the gain curves of the Music Playlist crossfade.
+    enum class CrossfadeCurve {
+        /// @brief The gains change linearly, the loudness dip at the middle of the crossfade.
+        Linear,
+        /// @brief The gains follow a quarter sine, keep the total power constant (for uncorrelated tracks).
+        EqualPower,
+        /// @brief The gains follow a smoothstep, for a soft start and end of the crossfade.
+        SCurve
+    };
+
+    /// @brief The Music Playlist class, provide a gapless playlist player with crossfading on the Sound Mixer. The next
+    /// track is opened and decoded on a background thread while the current one is playing, and the switch is done on the
+    /// audio thread at the exact frame that the current track end (or the crossfade start).
+    /// The tracks are decoded into PCM in the Audio Device format (like Sound), so only the playing track and the next one
+    /// are kept in memory. The Music Playlist require the Sound Mixer, and is independent of Music::Play().
+    /// @note All the functions of the Music Playlist must be called on the main thread.
+    class MusicPlaylist final {
+    private:
+        enum class __deck_state : int { Empty, Loading, Ready, Playing, Retired };
+
+        struct __deck {
+            // Empty, Loading and Retired decks are owned by the worker thread, Ready and Playing decks by the audio thread.
+            std::atomic<int> state{(int)__deck_state::Empty};
+            std::atomic<unsigned> generation{0};
+            Mix_Chunk* chunk = nullptr;
+            uint32_t frame_count = 0;
+            int track = -1;
+            // Audio thread only.
+            uint32_t position = 0;
+        };
+
+        static __deck __decks[ENGINE_MUSIC_PLAYLIST_DECKS];
+
+        // Shared between the main thread and the worker thread, guarded by the mutex.
+        static std::mutex __mutex;
+        static std::condition_variable __condition;
+        static std::thread __worker;
+        static bool __is_worker_running;
+        static bool __is_playing, __is_looping;
+        static size_t __next_track;
+        static std::vector<std::string> __tracks;
+
+        // Written by the main thread, read by the audio thread.
+        static std::atomic<unsigned> __generation;
+        static std::atomic<bool> __skip_requested;
+        static std::atomic<float> __gain;
+        static std::atomic<uint32_t> __crossfade_frames;
+        static std::atomic<int> __crossfade_curve;
+        // Written by the audio thread, read by the main thread.
+        static std::atomic<int> __current_track;
+
+        // Audio thread only.
+        static unsigned __applied_generation;
+        static int __current_deck, __fading_deck;
+        static uint32_t __fade_position, __fade_length;
+
+        // Main thread only.
+        static bool __is_source_added;
+        static double __crossfade_duration;
+
+        /// @brief Evaluate the given crossfade curve, from 0 (silent) to 1 (full gain).
+        static float __evaluate_curve(int curve, float t) {
+            t = ENGINE_FAST_CLAMP(0.0f, 1.0f, t);
+            switch ((CrossfadeCurve)curve) {
+                case CrossfadeCurve::EqualPower: return std::sin(t * 1.57079632679f);
+                case CrossfadeCurve::SCurve: return t * t * (3.0f - 2.0f * t);
+                default: return t;
+            }
+        }
+        /// @brief Take the Ready deck of the given generation and start playing it (audio thread).
+        /// @return The index of the deck, or -1 if there's no Ready deck.
+        static int __take_ready_deck(unsigned generation) {
+            for (int i = 0; i < ENGINE_MUSIC_PLAYLIST_DECKS; i++) {
+                __deck& deck = MusicPlaylist::__decks[i];
+                int state = (int)__deck_state::Ready;
+                if (deck.state.load(std::memory_order_acquire) != state) continue;
+                if (deck.generation.load(std::memory_order_relaxed) != generation) continue;
+                if (!deck.state.compare_exchange_strong(state, (int)__deck_state::Playing, std::memory_order_acq_rel)) continue;
+                deck.position = 0;
+                return i;
+            }
+            return -1;
+        }
+        /// @brief Hand the given deck back to the worker thread to be freed (audio thread).
+        static void __retire_deck(int index) {
+            if (index < 0) return;
+            MusicPlaylist::__decks[index].state.store((int)__deck_state::Retired, std::memory_order_release);
+        }
+        /// @brief Accumulate frames of the given deck into the mix buffer, with gain ramping from the start to the end gain.
+        static void __mix_deck(__deck& deck, float* mix, int frames, float start_gain, float end_gain) {
+            float step = (end_gain - start_gain) / frames;
+            const uint8_t* src = deck.chunk->abuf + (size_t)deck.position * SoundMixer::__frame_size;
+            if (SoundMixer::__format == AUDIO_F32SYS)
+                SoundMixer::__mix_f32(mix, (const float*)src, frames, start_gain, start_gain, step, step);
+            else
+                SoundMixer::__mix_s16(mix, (const int16_t*)src, frames, start_gain, start_gain, step, step);
+            deck.position += frames;
+        }
+        /// @brief The Sound Mixer source callback, play the current deck and crossfade into the next one (audio thread).
+        static void __mix(float* buffer, int frames) {
+            unsigned generation = MusicPlaylist::__generation.load(std::memory_order_acquire);
+            if (generation != MusicPlaylist::__applied_generation) {
+                // Play() or Stop() is called, drop the playing decks.
+                __retire_deck(MusicPlaylist::__current_deck);
+                __retire_deck(MusicPlaylist::__fading_deck);
+                MusicPlaylist::__current_deck = -1;
+                MusicPlaylist::__fading_deck = -1;
+                MusicPlaylist::__current_track.store(-1, std::memory_order_relaxed);
+                MusicPlaylist::__applied_generation = generation;
+            }
+            float gain = MusicPlaylist::__gain.load(std::memory_order_relaxed);
+            uint32_t crossfade_frames = MusicPlaylist::__crossfade_frames.load(std::memory_order_relaxed);
+            int curve = MusicPlaylist::__crossfade_curve.load(std::memory_order_relaxed);
+            bool is_skipping = MusicPlaylist::__skip_requested.exchange(false, std::memory_order_relaxed);
+
+            int done = 0;
+            while (done < frames) {
+                if (MusicPlaylist::__current_deck < 0) {
+                    MusicPlaylist::__current_deck = __take_ready_deck(generation);
+                    if (MusicPlaylist::__current_deck < 0) break;
+                    MusicPlaylist::__current_track.store(MusicPlaylist::__decks[MusicPlaylist::__current_deck].track, std::memory_order_relaxed);
+                }
+                __deck& current = MusicPlaylist::__decks[MusicPlaylist::__current_deck];
+
+                uint32_t remaining = current.frame_count - current.position;
+                if (MusicPlaylist::__fading_deck < 0 && (is_skipping || (crossfade_frames > 0 && remaining <= crossfade_frames))) {
+                    int next = __take_ready_deck(generation);
+                    if (next >= 0) {
+                        is_skipping = false;
+                        if (crossfade_frames > 0) {
+                            MusicPlaylist::__fading_deck = MusicPlaylist::__current_deck;
+                            MusicPlaylist::__fade_position = 0;
+                            MusicPlaylist::__fade_length = ENGINE_MIN(remaining, crossfade_frames);
+                        }
+                        else __retire_deck(MusicPlaylist::__current_deck);
+                        MusicPlaylist::__current_deck = next;
+                        MusicPlaylist::__current_track.store(MusicPlaylist::__decks[next].track, std::memory_order_relaxed);
+                        continue;
+                    }
+                }
+
+                int count = (int)ENGINE_MIN((uint32_t)(frames - done), remaining);
+                if (MusicPlaylist::__fading_deck >= 0) {
+                    __deck& fading = MusicPlaylist::__decks[MusicPlaylist::__fading_deck];
+                    // The gains are evaluated on short segments and ramped linearly in between.
+                    count = ENGINE_MIN(count, ENGINE_MUSIC_PLAYLIST_CROSSFADE_SEGMENT);
+                    count = (int)ENGINE_MIN((uint32_t)count, MusicPlaylist::__fade_length - MusicPlaylist::__fade_position);
+                    count = (int)ENGINE_MIN((uint32_t)count, fading.frame_count - fading.position);
+                    float t0 = (float)MusicPlaylist::__fade_position / MusicPlaylist::__fade_length;
+                    float t1 = (float)(MusicPlaylist::__fade_position + count) / MusicPlaylist::__fade_length;
+                    __mix_deck(fading, buffer + done * 2, count, gain * __evaluate_curve(curve, 1.0f - t0), gain * __evaluate_curve(curve, 1.0f - t1));
+                    __mix_deck(current, buffer + done * 2, count, gain * __evaluate_curve(curve, t0), gain * __evaluate_curve(curve, t1));
+                    MusicPlaylist::__fade_position += count;
+                    if (MusicPlaylist::__fade_position >= MusicPlaylist::__fade_length || fading.position >= fading.frame_count) {
+                        __retire_deck(MusicPlaylist::__fading_deck);
+                        MusicPlaylist::__fading_deck = -1;
+                    }
+                }
+                else if (count > 0) __mix_deck(current, buffer + done * 2, count, gain, gain);
+                done += count;
+
+                if (current.position >= current.frame_count) {
+                    // The next Ready deck (if any) is started on the next iteration, at the exact following frame.
+                    __retire_deck(MusicPlaylist::__current_deck);
+                    __retire_deck(MusicPlaylist::__fading_deck);
+                    MusicPlaylist::__current_deck = -1;
+                    MusicPlaylist::__fading_deck = -1;
+                    MusicPlaylist::__current_track.store(-1, std::memory_order_relaxed);
+                }
+            }
+            // Keep the skip request until the next track is decoded.
+            if (is_skipping) MusicPlaylist::__skip_requested.store(true, std::memory_order_relaxed);
+        }
+        /// @brief The worker thread, free the finished decks and decode the next track ahead of the playing one.
+        static void __worker_main() {
+            std::unique_lock<std::mutex> lock(MusicPlaylist::__mutex);
+            while (MusicPlaylist::__is_worker_running) {
+                unsigned generation = MusicPlaylist::__generation.load(std::memory_order_acquire);
+                bool is_pending = false;
+                __deck* empty = nullptr;
+                for (__deck& deck : MusicPlaylist::__decks) {
+                    int state = deck.state.load(std::memory_order_acquire);
+                    // A Ready deck decoded for a previous Play() is never played, so take it back.
+                    if (state == (int)__deck_state::Ready && deck.generation.load(std::memory_order_relaxed) != generation)
+                        if (deck.state.compare_exchange_strong(state, (int)__deck_state::Retired, std::memory_order_acq_rel))
+                            state = (int)__deck_state::Retired;
+                    if (state == (int)__deck_state::Retired) {
+                        Mix_Chunk* chunk = deck.chunk;
+                        deck.chunk = nullptr;
+                        lock.unlock();
+                        if (chunk) Mix_FreeChunk(chunk);
+                        lock.lock();
+                        deck.state.store((int)__deck_state::Empty, std::memory_order_release);
+                        state = (int)__deck_state::Empty;
+                    }
+                    if (state == (int)__deck_state::Empty) { if (!empty) empty = &deck; }
+                    else if (state == (int)__deck_state::Ready) is_pending = true;
+                }
+
+                // Decode one track ahead of the playing one.
+                if (MusicPlaylist::__is_playing && empty && !is_pending && MusicPlaylist::__next_track < MusicPlaylist::__tracks.size()) {
+                    size_t track = MusicPlaylist::__next_track;
+                    std::string path = MusicPlaylist::__tracks[track];
+                    MusicPlaylist::__next_track = track + 1;
+                    if (MusicPlaylist::__next_track >= MusicPlaylist::__tracks.size() && MusicPlaylist::__is_looping)
+                        MusicPlaylist::__next_track = 0;
+                    empty->state.store((int)__deck_state::Loading, std::memory_order_relaxed);
+
+                    lock.unlock();
+                    Mix_Chunk* chunk = Mix_LoadWAV_RW(SDL_RWFromFile(path.c_str(), "rb"), 1);
+                    lock.lock();
+
+                    uint32_t frame_count = chunk ? chunk->alen / SoundMixer::__frame_size : 0;
+                    if (frame_count == 0) {
+                        // Skip the track that can't be decoded.
+                        if (chunk) Mix_FreeChunk(chunk);
+                        empty->state.store((int)__deck_state::Empty, std::memory_order_relaxed);
+                        continue;
+                    }
+                    empty->chunk = chunk;
+                    empty->frame_count = frame_count;
+                    empty->track = (int)track;
+                    empty->generation.store(generation, std::memory_order_relaxed);
+                    empty->state.store((int)__deck_state::Ready, std::memory_order_release);
+                    continue;
+                }
+                // The audio thread don't signal the worker, so the finished decks are polled.
+                MusicPlaylist::__condition.wait_for(lock, std::chrono::milliseconds(10));
+            }
+        }
+    public:
+        /// @brief Deinitialize the Music Playlist, stop playing and join the worker thread. All tracks are removed. This is
+        /// called on Engine::Deinitialize().
+        static void Deinitialize() {
+            if (MusicPlaylist::__worker.joinable()) {
+                {
+                    std::lock_guard<std::mutex> guard(MusicPlaylist::__mutex);
+                    MusicPlaylist::__is_worker_running = false;
+                }
+                MusicPlaylist::__condition.notify_all();
+                MusicPlaylist::__worker.join();
+            }
+            if (MusicPlaylist::__is_source_added) {
+                // Removing the source also wait for the running audio callback to finish.
+                SoundMixer::RemoveSource(&MusicPlaylist::__mix);
+                MusicPlaylist::__is_source_added = false;
+            }
+            for (__deck& deck : MusicPlaylist::__decks) {
+                if (deck.chunk) Mix_FreeChunk(deck.chunk);
+                deck.chunk = nullptr;
+                deck.state.store((int)__deck_state::Empty, std::memory_order_release);
+            }
+            MusicPlaylist::__current_deck = -1;
+            MusicPlaylist::__fading_deck = -1;
+            MusicPlaylist::__current_track.store(-1, std::memory_order_relaxed);
+            MusicPlaylist::__is_playing = false;
+            MusicPlaylist::__next_track = 0;
+            MusicPlaylist::__tracks.clear();
+        }
+
+        /// @brief Add a track to the end of the Music Playlist.
+        /// @param file_path The file path of the sound file (any format that Sound can load).
+        static void AddTrack(const std::string& file_path) {
+            std::lock_guard<std::mutex> guard(MusicPlaylist::__mutex);
+            MusicPlaylist::__tracks.push_back(file_path);
+        }
+        /// @brief Remove all tracks of the Music Playlist. The playing track and the decoded next track are still played.
+        static void ClearTracks() {
+            std::lock_guard<std::mutex> guard(MusicPlaylist::__mutex);
+            MusicPlaylist::__tracks.clear();
+            MusicPlaylist::__next_track = 0;
+        }
+        /// @brief Get the number of tracks of the Music Playlist.
+        /// @return The number of tracks.
+        static size_t GetTrackCount() {
+            std::lock_guard<std::mutex> guard(MusicPlaylist::__mutex);
+            return MusicPlaylist::__tracks.size();
+        }
+        /// @brief Get the file path of the given track.
+        /// @param index The index of the track.
+        /// @return The file path of the track, or empty string if the index is out of range.
+        static std::string GetTrack(size_t index) {
+            std::lock_guard<std::mutex> guard(MusicPlaylist::__mutex);
+            return index < MusicPlaylist::__tracks.size() ? MusicPlaylist::__tracks[index] : std::string();
+        }
+
+        /// @brief Start playing the Music Playlist from the given track, the playing track is stopped. The track is decoded on
+        /// the background thread, so it start playing shortly after this return.
+        /// @param index The index of the track to start from. Default is 0.
+        /// @param bus The Sound Bus that the Music Playlist is mixed into, or nullptr (default) for the master bus.
+        /// @return true on success, false on failed (the Sound Mixer is not initialized, or the index is out of range).
+        static bool Play(size_t index = 0, SoundBus* bus = nullptr) {
+            if (!SoundMixer::IsInitialized()) return false;
+            {
+                std::lock_guard<std::mutex> guard(MusicPlaylist::__mutex);
+                if (index >= MusicPlaylist::__tracks.size()) return false;
+                MusicPlaylist::__next_track = index;
+                MusicPlaylist::__is_playing = true;
+                MusicPlaylist::__generation.fetch_add(1, std::memory_order_release);
+                MusicPlaylist::__skip_requested.store(false, std::memory_order_relaxed);
+                if (!MusicPlaylist::__is_worker_running) {
+                    MusicPlaylist::__is_worker_running = true;
+                    MusicPlaylist::__worker = std::thread(&MusicPlaylist::__worker_main);
+                }
+            }
+            MusicPlaylist::__condition.notify_all();
+
+            if (MusicPlaylist::__is_source_added) SoundMixer::SetSourceBus(&MusicPlaylist::__mix, bus);
+            else MusicPlaylist::__is_source_added = SoundMixer::AddSource(&MusicPlaylist::__mix, bus);
+            return MusicPlaylist::__is_source_added;
+        }
+        /// @brief Stop playing the Music Playlist.
+        static void Stop() {
+            {
+                std::lock_guard<std::mutex> guard(MusicPlaylist::__mutex);
+                MusicPlaylist::__is_playing = false;
+                MusicPlaylist::__generation.fetch_add(1, std::memory_order_release);
+            }
+            MusicPlaylist::__condition.notify_all();
+        }
+        /// @brief Skip to the next track, with crossfade if enabled. If the next track is still decoding, the skip happen as
+        /// soon as it ready.
+        static void Next() { MusicPlaylist::__skip_requested.store(true, std::memory_order_relaxed); }
+        /// @brief Check if the Music Playlist is playing a track.
+        /// @return true if a track is playing, false otherwise.
+        static bool IsPlaying() { return MusicPlaylist::__current_track.load(std::memory_order_relaxed) >= 0; }
+        /// @brief Get the index of the playing track. When crossfading, this is the incoming track.
+        /// @return The index of the playing track, or -1 if not playing.
+        static int GetCurrentTrack() { return MusicPlaylist::__current_track.load(std::memory_order_relaxed); }
+
+        /// @brief Check if the Music Playlist is looping.
+        /// @return true if the Music Playlist start over after the last track, false otherwise. Default is false.
+        static bool IsLooping() {
+            std::lock_guard<std::mutex> guard(MusicPlaylist::__mutex);
+            return MusicPlaylist::__is_looping;
+        }
+        /// @brief Set if the Music Playlist is looping.
+        /// @param looping If true, the Music Playlist start over after the last track (also gapless).
+        static void SetLooping(bool looping) {
+            {
+                std::lock_guard<std::mutex> guard(MusicPlaylist::__mutex);
+                MusicPlaylist::__is_looping = looping;
+                if (looping && MusicPlaylist::__next_track >= MusicPlaylist::__tracks.size()) MusicPlaylist::__next_track = 0;
+            }
+            MusicPlaylist::__condition.notify_all();
+        }
+
+        /// @brief Set the crossfade between tracks.
+        /// @param duration The crossfade duration in seconds, or 0 for gapless playback without crossfade. Default is 0.
+        /// @param curve The crossfade curve. Default is CrossfadeCurve::EqualPower.
+        static void SetCrossfade(double duration, CrossfadeCurve curve = CrossfadeCurve::EqualPower) {
+            MusicPlaylist::__crossfade_duration = duration < 0.0 ? 0.0 : duration;
+            uint32_t frames = (uint32_t)(MusicPlaylist::__crossfade_duration * AudioDevice::GetFrequency());
+            MusicPlaylist::__crossfade_frames.store(frames, std::memory_order_relaxed);
+            MusicPlaylist::__crossfade_curve.store((int)curve, std::memory_order_relaxed);
+        }
+        /// @brief Get the crossfade duration.
+        /// @return The crossfade duration in seconds.
+        static double GetCrossfadeDuration() { return MusicPlaylist::__crossfade_duration; }
+        /// @brief Get the crossfade curve.
+        /// @return The crossfade curve.
+        static CrossfadeCurve GetCrossfadeCurve() { return (CrossfadeCurve)MusicPlaylist::__crossfade_curve.load(std::memory_order_relaxed); }
+
+        /// @brief Get the gain of the Music Playlist.
+        /// @return The gain of the Music Playlist. Default is 1.
+        static float GetGain() { return MusicPlaylist::__gain.load(std::memory_order_relaxed); }
+        /// @brief Set the gain of the Music Playlist.
+        /// @param gain The gain to set, will be clamped to be at least 0.
+        static void SetGain(float gain) { MusicPlaylist::__gain.store(gain < 0.0f ? 0.0f : gain, std::memory_order_relaxed); }
+    };
+}
+
+Engine::MusicPlaylist::__deck Engine::MusicPlaylist::__decks[ENGINE_MUSIC_PLAYLIST_DECKS];
+
+std::mutex Engine::MusicPlaylist::__mutex;
+std::condition_variable Engine::MusicPlaylist::__condition;
+std::thread Engine::MusicPlaylist::__worker;
+bool Engine::MusicPlaylist::__is_worker_running = false;
+bool Engine::MusicPlaylist::__is_playing = false;
+bool Engine::MusicPlaylist::__is_looping = false;
+size_t Engine::MusicPlaylist::__next_track = 0;
+std::vector<std::string> Engine::MusicPlaylist::__tracks;
+
+std::atomic<unsigned> Engine::MusicPlaylist::__generation{0};
+std::atomic<bool> Engine::MusicPlaylist::__skip_requested{false};
+std::atomic<float> Engine::MusicPlaylist::__gain{1.0f};
+std::atomic<uint32_t> Engine::MusicPlaylist::__crossfade_frames{0};
+std::atomic<int> Engine::MusicPlaylist::__crossfade_curve{(int)Engine::CrossfadeCurve::EqualPower};
+std::atomic<int> Engine::MusicPlaylist::__current_track{-1};
+
+unsigned Engine::MusicPlaylist::__applied_generation = 0;
+int Engine::MusicPlaylist::__current_deck = -1;
+int Engine::MusicPlaylist::__fading_deck = -1;
+uint32_t Engine::MusicPlaylist::__fade_position = 0;
+uint32_t Engine::MusicPlaylist::__fade_length = 0;
+
+bool Engine::MusicPlaylist::__is_source_added = false;
+double Engine::MusicPlaylist::__crossfade_duration = 0.0;
+
+#endif // __ENGINE_MUSICPLAYLIST_H__
\ No newline at end of file
@@ -0,0 +1,351 @@
+#ifndef __ENGINE_PARTICLESYSTEM_H__
+#define __ENGINE_PARTICLESYSTEM_H__
+
+#include "Engine_Define.h"
+#include "Engine_Application.h"
+#include "Engine_Color.h"
+#include "Engine_GameObject.h"
+#include "Engine_Imaging.h"
+#include "Engine_Math.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENGINE_PARTICLE_SYSTEM_SSE2
+#endif
+
+#if defined(ENGINE_PARTICLE_SYSTEM_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace Engine {
+    /// @brief The Particle Emission Shape enum, define where the particles are emitted around the emission origin.
+    enum class ParticleEmissionShape {
+        /// @brief Emit at the emission origin.
+        Point = 0,
+        /// @brief Emit inside an ellipse with the radius of ShapeSize.
+        Circle = 1,
+        /// @brief Emit on the edge of an ellipse with the radius of ShapeSize.
+        Ring = 2,
+        /// @brief Emit inside a rectangle with the size of ShapeSize, centered at the emission origin.
+        Rectangle = 3,
+        /// @brief Emit on a horizontal line with the length of ShapeSize.X, centered at the emission origin.
+        Line = 4
+    };
+
+    /// @brief The Particle Curve struct, define a value over the life of the particles (from Start at birth to End at
+    /// death, eased by the Function).
+    struct ParticleCurve {
+        /// @brief The value at birth. Default is 1.
+        float Start = 1.0f;
+        /// @brief The value at death. Default is 1.
+        float End = 1.0f;
+        /// @brief The Interpolation Function from Start to End. Default is Linear.
+        InterpolationFunction Function = InterpolationFunction::Linear;
+
+        ParticleCurve() = default;
+        ParticleCurve(float start, float end, InterpolationFunction function = InterpolationFunction::Linear)
+            : Start(start), End(end), Function(function) {}
+
+        /// @brief Evaluate the curve at the given life progress.
+        /// @param t The life progress from 0 (birth) to 1 (death).
+        /// @return The value of the curve.
+        float Evaluate(float t) const { return Start + (End - Start) * (float)Easing::Evaluate(Function, t); }
+    };
+    /// @brief The Particle Color Curve struct, define a color over the life of the particles.
+    struct ParticleColorCurve {
+        /// @brief The color at birth. Default is KnownColor::White.
+        Color Start = Engine::KnownColor::White;
+        /// @brief The color at death. Default is KnownColor::White.
+        Color End = Engine::KnownColor::White;
+        /// @brief The Interpolation Function from Start to End. Default is Linear.
+        InterpolationFunction Function = InterpolationFunction::Linear;
+
+        ParticleColorCurve() = default;
+        ParticleColorCurve(const Color& start, const Color& end, InterpolationFunction function = InterpolationFunction::Linear)
+            : Start(start), End(end), Function(function) {}
+    };
+
+    /// @brief The Particle Emitter Game Object class, simulate and render a large number of particles as one Game Object.
+    /// The particles are stored in a fixed-capacity pool with one array per attribute, updated in tight loops over
+    /// the arrays and drawn as one geometry batch per emitter. The particles are not Game Objects, so they have no
+    /// events or scripts.
+    class ParticleEmitterGameObject : public GameObject {
+    private:
+        size_t __capacity = 0, __count = 0;
+        std::vector<float> __x, __y, __velocity_x, __velocity_y;
+        std::vector<float> __age, __inverse_lifetime, __start_size;
+        std::vector<float> __size, __progress;
+        std::vector<SDL_Color> __color;
+        std::vector<SDL_Vertex> __vertices;
+        std::vector<int> __indices;
+        double __emit_accumulator = 0;
+        uint32_t __random_state = 0x9E3779B9u;
+
+        /// @brief Get the next random value from 0 to 1 (xorshift32).
+        float __random() {
+            uint32_t x = __random_state;
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            __random_state = x;
+            return (float)(x >> 8) * (1.0f / 16777216.0f);
+        }
+        /// @brief Get the next random value in the given range.
+        float __random(float min, float max) { return min + (max - min) * __random(); }
+        /// @brief Get a random point of the emission shape, relative to the emission origin.
+        Vec2f __sample_shape() {
+            switch (Shape)
+            {
+            case ParticleEmissionShape::Circle: {
+                float angle = __random() * 6.28318530718f, radius = sqrtf(__random());
+                return Vec2f(cosf(angle) * radius * ShapeSize.X, sinf(angle) * radius * ShapeSize.Y);
+            }
+            case ParticleEmissionShape::Ring: {
+                float angle = __random() * 6.28318530718f;
+                return Vec2f(cosf(angle) * ShapeSize.X, sinf(angle) * ShapeSize.Y);
+            }
+            case ParticleEmissionShape::Rectangle:
+                return Vec2f((__random() - 0.5f) * ShapeSize.X, (__random() - 0.5f) * ShapeSize.Y);
+            case ParticleEmissionShape::Line:
+                return Vec2f((__random() - 0.5f) * ShapeSize.X, 0.0f);
+            default:
+                return Vec2f::Zero;
+            }
+        }
+        /// @brief Remove the particle at the given index by moving the last particle into it.
+        void __remove(size_t i) {
+            size_t last = --__count;
+            if (i == last) return;
+            __x[i] = __x[last]; __y[i] = __y[last];
+            __velocity_x[i] = __velocity_x[last]; __velocity_y[i] = __velocity_y[last];
+            __age[i] = __age[last]; __inverse_lifetime[i] = __inverse_lifetime[last];
+            __start_size[i] = __start_size[last];
+        }
+        /// @brief Evaluate the size and color curves of all particles.
+        void __evaluate_curves() {
+            const size_t count = __count;
+            float* progress = __progress.data();
+            float* size = __size.data();
+            const float* age = __age.data();
+            const float* start_size = __start_size.data();
+
+            for (size_t i = 0; i < count; i++) progress[i] = age[i];
+            Easing::Evaluate(SizeOverLife.Function, progress, count);
+            const float size_start = SizeOverLife.Start, size_delta = SizeOverLife.End - SizeOverLife.Start;
+            for (size_t i = 0; i < count; i++) size[i] = start_size[i] * (size_start + size_delta * progress[i]);
+
+            for (size_t i = 0; i < count; i++) progress[i] = age[i];
+            Easing::Evaluate(ColorOverLife.Function, progress, count);
+            const Color& start = ColorOverLife.Start, & end = ColorOverLife.End;
+            const float r = start.Red + 0.5f, g = start.Green + 0.5f, b = start.Blue + 0.5f, a = start.Alpha + 0.5f;
+            const float dr = (float)end.Red - start.Red, dg = (float)end.Green - start.Green;
+            const float db = (float)end.Blue - start.Blue, da = (float)end.Alpha - start.Alpha;
+            SDL_Color* color = __color.data();
+            for (size_t i = 0; i < count; i++) {
+                float t = ENGINE_FAST_CLAMP(0.0f, 1.0f, progress[i]);
+                color[i].r = (uint8_t)(r + dr * t);
+                color[i].g = (uint8_t)(g + dg * t);
+                color[i].b = (uint8_t)(b + db * t);
+                color[i].a = (uint8_t)(a + da * t);
+            }
+        }
+    protected:
+        void OnUpdate() override { Simulate((double)Application::GetDeltaTime()); }
+        void OnRender(RenderEventArgs* args) override {
+            GameObject::OnRender(args);
+            if (!__count) return;
+
+            // In parent space, the particles are relative to the parent, as the Position.
+            Mat3x2f transform = LocalSpace ? args->Transform :
+                Mat3x2f::Translation(Vec2f(args->TargetArea.TopLeft()) - Vec2f(Position)) * args->ParentTransform;
+            const Vec2f axis_x = transform.TransformVector(Vec2f(0.5f, 0.0f));
+            const Vec2f axis_y = transform.TransformVector(Vec2f(0.0f, 0.5f));
+
+            const size_t count = __count;
+            const float* x = __x.data(); const float* y = __y.data();
+            const float* size = __size.data();
+            const SDL_Color* color = __color.data();
+            SDL_Vertex* vertex = __vertices.data();
+            for (size_t i = 0; i < count; i++, vertex += 4) {
+                float cx = x[i] * transform.M11 + y[i] * transform.M21 + transform.M31;
+                float cy = x[i] * transform.M12 + y[i] * transform.M22 + transform.M32;
+                float hx_x = axis_x.X * size[i], hx_y = axis_x.Y * size[i];
+                float hy_x = axis_y.X * size[i], hy_y = axis_y.Y * size[i];
+                vertex[0].position.x = cx - hx_x - hy_x; vertex[0].position.y = cy - hx_y - hy_y;
+                vertex[1].position.x = cx + hx_x - hy_x; vertex[1].position.y = cy + hx_y - hy_y;
+                vertex[2].position.x = cx - hx_x + hy_x; vertex[2].position.y = cy - hx_y + hy_y;
+                vertex[3].position.x = cx + hx_x + hy_x; vertex[3].position.y = cy + hx_y + hy_y;
+                vertex[0].color = vertex[1].color = vertex[2].color = vertex[3].color = color[i];
+            }
+            Renderer::DrawGeometry(ParticleTexture, __vertices.data(), (int)(count * 4), __indices.data(), (int)(count * 6));
+        }
+    public:
+        /// @brief If this false, no new particles are emitted by the EmissionRate (the alive particles are still
+        /// simulated, and Emit() still work). Default is true.
+        bool Emitting = true;
+        /// @brief The number of particles emitted per second. Default is 100.
+        float EmissionRate = 100.0f;
+        /// @brief The emission origin, relative to the Size ((0, 0) is the top-left corner and (1, 1) is the bottom-right
+        /// corner). Default is (0.5, 0.5).
+        Vec2f EmissionOrigin = Vec2f(0.5f, 0.5f);
+        /// @brief The shape of the emission around the emission origin. Default is ParticleEmissionShape::Point.
+        ParticleEmissionShape Shape = ParticleEmissionShape::Point;
+        /// @brief The size of the emission shape (radius for Circle and Ring, size for Rectangle and length for Line).
+        /// Default is (0, 0).
+        Vec2f ShapeSize = Vec2f::Zero;
+        /// @brief If this true, the particles are simulated in the local space of the emitter and move with it. Otherwise,
+        /// the particles are simulated in the space of the parent and stay where they emitted. Default is true.
+        bool LocalSpace = true;
+
+        /// @brief The direction of the emission in degrees (clockwise, 0 is right and 270 is up). Default is 270.
+        float Direction = 270.0f;
+        /// @brief The spread of the emission direction in degrees, the particles are emitted from Direction - Spread / 2
+        /// to Direction + Spread / 2. Default is 30.
+        float Spread = 30.0f;
+        /// @brief The minimum start speed of the particles in pixels per second. Default is 50.
+        float MinSpeed = 50.0f;
+        /// @brief The maximum start speed of the particles in pixels per second. Default is 100.
+        float MaxSpeed = 100.0f;
+        /// @brief The minimum lifetime of the particles in seconds. Default is 1.
+        float MinLifetime = 1.0f;
+        /// @brief The maximum lifetime of the particles in seconds. Default is 2.
+        float MaxLifetime = 2.0f;
+        /// @brief The minimum start size of the particles in pixels. Default is 4.
+        float MinSize = 4.0f;
+        /// @brief The maximum start size of the particles in pixels. Default is 8.
+        float MaxSize = 8.0f;
+        /// @brief The acceleration applied to all particles in pixels per second squared. Default is Vec2f::Zero.
+        Vec2f Gravity = Vec2f::Zero;
+        /// @brief The fraction of the velocity lost per second (0 mean no drag). Default is 0.
+        float Drag = 0.0f;
+
+        /// @brief The size multiplier of the particles over their life. Default is 1 to 1.
+        ParticleCurve SizeOverLife;
+        /// @brief The color of the particles over their life. Default is white to white.
+        ParticleColorCurve ColorOverLife;
+        /// @brief The texture of the particles, stretched over each particle. Default is nullptr mean the particles are
+        /// drawn as solid squares.
+        Texture* ParticleTexture = nullptr;
+
+        /// @brief Create a new Particle Emitter Game Object.
+        /// @param Capacity The maximum number of alive particles. Default is 1000.
+        ParticleEmitterGameObject(size_t Capacity = 1000) {
+            RenderBackground = false;
+            SetCapacity(Capacity);
+        }
+        virtual ~ParticleEmitterGameObject() {}
+
+        ENGINE_NOT_COPYABLE(ParticleEmitterGameObject);
+        ENGINE_NOT_ASSIGNABLE(ParticleEmitterGameObject);
+
+        /// @brief Get the maximum number of alive particles.
+        /// @return The capacity of the particle pool.
+        size_t GetCapacity() const { return __capacity; }
+        /// @brief Set the maximum number of alive particles. All alive particles are cleared.
+        /// @param Capacity The capacity of the particle pool.
+        void SetCapacity(size_t Capacity) {
+            __capacity = Capacity; __count = 0;
+            for (std::vector<float>* array : { &__x, &__y, &__velocity_x, &__velocity_y, &__age, &__inverse_lifetime,
+                                               &__start_size, &__size, &__progress })
+                array->assign(Capacity, 0.0f);
+            __color.assign(Capacity, SDL_Color{ 255, 255, 255, 255 });
+
+            // The texture coordinates and indices never change, only the positions and colors are written per frame.
+            __vertices.resize(Capacity * 4);
+            __indices.resize(Capacity * 6);
+            for (size_t i = 0; i < Capacity; i++) {
+                __vertices[i * 4 + 0].tex_coord = SDL_FPoint{ 0.0f, 0.0f };
+                __vertices[i * 4 + 1].tex_coord = SDL_FPoint{ 1.0f, 0.0f };
+                __vertices[i * 4 + 2].tex_coord = SDL_FPoint{ 0.0f, 1.0f };
+                __vertices[i * 4 + 3].tex_coord = SDL_FPoint{ 1.0f, 1.0f };
+                int base = (int)(i * 4);
+                int* index = &__indices[i * 6];
+                index[0] = base; index[1] = base + 1; index[2] = base + 2;
+                index[3] = base + 2; index[4] = base + 1; index[5] = base + 3;
+            }
+        }
+        /// @brief Get the number of alive particles.
+        /// @return The number of alive particles.
+        size_t GetParticleCount() const { return __count; }
+        /// @brief Set the seed of the random generator of the emitter, for reproducible emission.
+        /// @param Seed The seed to set.
+        void SetSeed(uint32_t Seed) { __random_state = Seed ? Seed : 0x9E3779B9u; }
+
+        /// @brief Emit the given number of particles immediately, limited by the capacity.
+        /// @param Count The number of particles to emit.
+        /// @return The number of particles emitted.
+        size_t Emit(size_t Count) {
+            Count = ENGINE_MIN(Count, __capacity - __count);
+            Vec2f origin = Vec2f(Size) * EmissionOrigin;
+            if (!LocalSpace) origin = origin + GetPrecisePosition();
+            const float min_angle = Direction - Spread * 0.5f;
+            for (size_t n = 0; n < Count; n++) {
+                size_t i = __count++;
+                Vec2f position = origin + __sample_shape();
+                float angle = (min_angle + Spread * __random()) * 0.0174532925199f;
+                float speed = __random(MinSpeed, MaxSpeed);
+                __x[i] = position.X; __y[i] = position.Y;
+                __velocity_x[i] = cosf(angle) * speed; __velocity_y[i] = sinf(angle) * speed;
+                __age[i] = 0.0f;
+                __inverse_lifetime[i] = 1.0f / ENGINE_MAX(0.001f, __random(MinLifetime, MaxLifetime));
+                __start_size[i] = __random(MinSize, MaxSize);
+                __size[i] = __start_size[i] * SizeOverLife.Start;
+                __color[i] = SDL_Color{ ColorOverLife.Start.Red, ColorOverLife.Start.Green, ColorOverLife.Start.Blue, ColorOverLife.Start.Alpha };
+            }
+            return Count;
+        }
+        /// @brief Remove all alive particles.
+        void Clear() { __count = 0; __emit_accumulator = 0; }
+        /// @brief Simulate the particles for the given time, this is called by OnUpdate() with the delta time of the frame.
+        /// @param DeltaTime The time to simulate in seconds.
+        void Simulate(double DeltaTime) {
+            if (DeltaTime <= 0) return;
+            const float dt = (float)DeltaTime;
+
+            // Integrate 4 particles at a time with SSE2, the rest (or all, without SSE2) one at a time.
+            const size_t count = __count;
+            float* x = __x.data(); float* y = __y.data();
+            float* velocity_x = __velocity_x.data(); float* velocity_y = __velocity_y.data();
+            float* age = __age.data();
+            const float* inverse_lifetime = __inverse_lifetime.data();
+            const float damping = ENGINE_MAX(0.0f, 1.0f - Drag * dt);
+            const float gravity_x = Gravity.X * dt, gravity_y = Gravity.Y * dt;
+            size_t i = 0;
+#if defined(ENGINE_PARTICLE_SYSTEM_SSE2)
+            const __m128 damping_4 = _mm_set1_ps(damping), dt_4 = _mm_set1_ps(dt);
+            const __m128 gravity_x_4 = _mm_set1_ps(gravity_x), gravity_y_4 = _mm_set1_ps(gravity_y);
+            for (; i + 4 <= count; i += 4) {
+                __m128 vx = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(velocity_x + i), damping_4), gravity_x_4);
+                __m128 vy = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(velocity_y + i), damping_4), gravity_y_4);
+                _mm_storeu_ps(velocity_x + i, vx);
+                _mm_storeu_ps(velocity_y + i, vy);
+                _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(vx, dt_4)));
+                _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(vy, dt_4)));
+                _mm_storeu_ps(age + i, _mm_add_ps(_mm_loadu_ps(age + i), _mm_mul_ps(_mm_loadu_ps(inverse_lifetime + i), dt_4)));
+            }
+#endif
+            for (; i < count; i++) {
+                velocity_x[i] = velocity_x[i] * damping + gravity_x;
+                velocity_y[i] = velocity_y[i] * damping + gravity_y;
+                x[i] += velocity_x[i] * dt;
+                y[i] += velocity_y[i] * dt;
+                age[i] += inverse_lifetime[i] * dt;
+            }
+
+            for (i = 0; i < __count;) {
+                if (__age[i] >= 1.0f) __remove(i);
+                else i++;
+            }
+            if (Emitting && EmissionRate > 0) {
+                __emit_accumulator += DeltaTime * EmissionRate;
+                size_t emit_count = (size_t)__emit_accumulator;
+                __emit_accumulator -= (double)emit_count;
+                Emit(emit_count);
+            }
+            __evaluate_curves();
+        }
+    };
+}
+
+#endif // __ENGINE_PARTICLESYSTEM_H__
\ No newline at end of file
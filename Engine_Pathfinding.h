@@ -0,0 +1,626 @@
+#ifndef __ENGINE_PATHFINDING_H__
+#define __ENGINE_PATHFINDING_H__
+
+#include "Engine_Define.h"
+#include "Engine_Math.h"
+#include "Engine_Structure.h"
+#include "Engine_Tilemap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace Engine {
+    class PathGrid;
+
+    /// @brief The Flow Field class, store the distance and the direction to a goal for every cell of a Path Grid, so any
+    /// number of units can move to the same goal by reading their cell. A Flow Field is created and kept up to date by
+    /// PathGrid::GetFlowField(), and recomputed only around the cells that changed.
+    class FlowField {
+        friend class PathGrid;
+    private:
+        // The directions, the even ones are straight and the odd ones are diagonal.
+        static constexpr int __dx[8] = { 1, 1, 0, -1, -1, -1, 0, 1 };
+        static constexpr int __dy[8] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+
+        struct __node {
+            float distance;
+            uint32_t index;
+            bool operator<(const __node& node) const { return distance > node.distance; }
+        };
+
+        const PathGrid* __grid = nullptr;
+        Point __goal = Point::Zero;
+        std::vector<float> __distance;
+        std::vector<int8_t> __next;
+        std::vector<uint32_t> __changes;
+        std::vector<__node> __heap;
+        std::vector<uint32_t> __stack;
+        std::vector<uint8_t> __mark;
+        uint64_t __last_used = 0;
+
+        FlowField(const PathGrid* grid, const Point& goal) : __grid(grid), __goal(goal) {}
+
+        bool __can_move(const uint8_t* walkable, int width, int height, int x, int y, int direction) const;
+        void __compute();
+        void __update();
+        void __relax(const uint8_t* walkable, int width, int height);
+        /// @brief Find the best distance of the given cell from its neighbors.
+        bool __reseed(const uint8_t* walkable, int width, int height, uint32_t index);
+    public:
+        ENGINE_NOT_COPYABLE(FlowField)
+        ENGINE_NOT_ASSIGNABLE(FlowField)
+
+        /// @brief Get the goal of the Flow Field.
+        /// @return The goal cell.
+        Point GetGoal() const { return __goal; }
+        /// @brief Check if the goal can be reached from the given cell.
+        /// @param X The column of the cell.
+        /// @param Y The row of the cell.
+        /// @return true if the goal is reachable, false otherwise (or out of range).
+        bool IsReachable(int X, int Y) const { return GetDistance(X, Y) < INFINITY; }
+        /// @brief Get the distance from the given cell to the goal, in cells (a diagonal step is sqrt(2)).
+        /// @param X The column of the cell.
+        /// @param Y The row of the cell.
+        /// @return The distance, or INFINITY if unreachable or out of range.
+        float GetDistance(int X, int Y) const;
+        /// @brief Get the next cell to move to from the given cell.
+        /// @param X The column of the cell.
+        /// @param Y The row of the cell.
+        /// @return The next cell, or the given cell if it's the goal or the goal is unreachable.
+        Point GetNextCell(int X, int Y) const;
+        /// @brief Get the direction to move from the given cell.
+        /// @param X The column of the cell.
+        /// @param Y The row of the cell.
+        /// @return The normalized direction, or Vec2f::Zero if it's the goal or the goal is unreachable.
+        Vec2f GetDirection(int X, int Y) const {
+            Point next = GetNextCell(X, Y);
+            return Vec2f((float)(next.X - X), (float)(next.Y - Y)).Normalized();
+        }
+    };
+
+    /// @brief The Path Grid class, a grid of walkable and blocked cells for pathfinding. A unit can move to the 8
+    /// neighbor cells, but not diagonally past a blocked cell. Paths are found with Jump Point Search (FindPath(), or
+    /// Pathfinding::FindPathAsync() on the worker threads), and the Flow Fields to shared goals are cached.
+    class PathGrid {
+        friend class FlowField;
+        friend class Pathfinding;
+    private:
+        /// @brief The scratch data of a Jump Point Search, one per thread.
+        struct __search {
+            struct __node {
+                float f;
+                uint32_t index;
+                bool operator<(const __node& node) const { return f > node.f; }
+            };
+            std::vector<float> g;
+            std::vector<uint32_t> parent;
+            std::vector<uint32_t> stamp;
+            std::vector<uint8_t> closed;
+            std::vector<__node> open;
+            uint32_t generation = 0;
+
+            const uint8_t* walkable = nullptr;
+            int width = 0, height = 0, goal_x = 0, goal_y = 0;
+
+            bool is_walkable(int x, int y) const {
+                return x >= 0 && y >= 0 && x < width && y < height && walkable[(size_t)y * width + x];
+            }
+            /// @brief Jump straight from the given cell in the given direction.
+            bool jump_straight(int x, int y, int dx, int dy, int& jump_x, int& jump_y) const {
+                while (true) {
+                    x += dx; y += dy;
+                    if (!is_walkable(x, y)) return false;
+                    if (x == goal_x && y == goal_y) break;
+                    // A forced neighbor: a side that opens after being blocked.
+                    if (dx) {
+                        if ((is_walkable(x, y - 1) && !is_walkable(x - dx, y - 1)) ||
+                            (is_walkable(x, y + 1) && !is_walkable(x - dx, y + 1))) break;
+                    }
+                    else if ((is_walkable(x - 1, y) && !is_walkable(x - 1, y - dy)) ||
+                             (is_walkable(x + 1, y) && !is_walkable(x + 1, y - dy))) break;
+                }
+                jump_x = x; jump_y = y;
+                return true;
+            }
+            /// @brief Jump from the given cell in the given direction (straight or diagonal).
+            bool jump(int x, int y, int dx, int dy, int& jump_x, int& jump_y) const {
+                if (!dx || !dy) return jump_straight(x, y, dx, dy, jump_x, jump_y);
+                while (true) {
+                    // No moving diagonally past a blocked cell.
+                    if (!is_walkable(x + dx, y) || !is_walkable(x, y + dy)) return false;
+                    x += dx; y += dy;
+                    if (!is_walkable(x, y)) return false;
+                    int unused_x, unused_y;
+                    if ((x == goal_x && y == goal_y) ||
+                        jump_straight(x, y, dx, 0, unused_x, unused_y) || jump_straight(x, y, 0, dy, unused_x, unused_y)) break;
+                }
+                jump_x = x; jump_y = y;
+                return true;
+            }
+            static float octile(int dx, int dy) {
+                dx = std::abs(dx); dy = std::abs(dy);
+                return (float)ENGINE_MAX(dx, dy) + 0.41421356f * (float)ENGINE_MIN(dx, dy);
+            }
+            bool find(const uint8_t* walkable_cells, int grid_width, int grid_height, const Point& start, const Point& goal,
+                      std::vector<Point>& path) {
+                path.clear();
+                walkable = walkable_cells; width = grid_width; height = grid_height;
+                goal_x = goal.X; goal_y = goal.Y;
+                if (!is_walkable(start.X, start.Y) || !is_walkable(goal.X, goal.Y)) return false;
+                if (start == goal) { path.push_back(start); return true; }
+
+                const size_t count = (size_t)width * height;
+                if (stamp.size() != count) {
+                    g.assign(count, 0.0f); parent.assign(count, 0); stamp.assign(count, 0); closed.assign(count, 0);
+                    generation = 0;
+                }
+                // The stamp mark the cells touched by this search, so nothing is cleared between searches.
+                if (++generation == 0) { std::fill(stamp.begin(), stamp.end(), 0); generation = 1; }
+                open.clear();
+
+                const uint32_t start_index = (uint32_t)start.Y * width + start.X, goal_index = (uint32_t)goal.Y * width + goal.X;
+                auto touch = [this](uint32_t index) {
+                    if (stamp[index] == generation) return;
+                    stamp[index] = generation; g[index] = INFINITY; closed[index] = 0;
+                };
+                touch(start_index);
+                g[start_index] = 0.0f; parent[start_index] = start_index;
+                open.push_back(__node{ octile(goal.X - start.X, goal.Y - start.Y), start_index });
+
+                while (!open.empty()) {
+                    std::pop_heap(open.begin(), open.end());
+                    uint32_t index = open.back().index;
+                    open.pop_back();
+                    if (closed[index]) continue;
+                    closed[index] = 1;
+                    if (index == goal_index) break;
+
+                    int x = (int)(index % width), y = (int)(index / width);
+                    // Prune the neighbors by the direction from the parent.
+                    int directions[8][2], direction_count = 0;
+                    auto add = [&directions, &direction_count](int dx, int dy) {
+                        directions[direction_count][0] = dx; directions[direction_count][1] = dy; direction_count++;
+                    };
+                    if (parent[index] == index) {
+                        for (int dy = -1; dy <= 1; dy++)
+                            for (int dx = -1; dx <= 1; dx++)
+                                if (dx || dy) add(dx, dy);
+                    }
+                    else {
+                        int parent_x = (int)(parent[index] % width), parent_y = (int)(parent[index] / width);
+                        int dx = (x > parent_x) - (x < parent_x), dy = (y > parent_y) - (y < parent_y);
+                        if (dx && dy) { add(dx, 0); add(0, dy); add(dx, dy); }
+                        else if (dx) {
+                            add(dx, 0);
+                            if (is_walkable(x, y + 1)) { add(dx, 1); add(0, 1); }
+                            if (is_walkable(x, y - 1)) { add(dx, -1); add(0, -1); }
+                        }
+                        else {
+                            add(0, dy);
+                            if (is_walkable(x + 1, y)) { add(1, dy); add(1, 0); }
+                            if (is_walkable(x - 1, y)) { add(-1, dy); add(-1, 0); }
+                        }
+                    }
+
+                    for (int i = 0; i < direction_count; i++) {
+                        int jump_x, jump_y;
+                        if (!jump(x, y, directions[i][0], directions[i][1], jump_x, jump_y)) continue;
+                        uint32_t jump_index = (uint32_t)jump_y * width + jump_x;
+                        touch(jump_index);
+                        if (closed[jump_index]) continue;
+                        float cost = g[index] + octile(jump_x - x, jump_y - y);
+                        if (cost >= g[jump_index]) continue;
+                        g[jump_index] = cost; parent[jump_index] = index;
+                        open.push_back(__node{ cost + octile(goal.X - jump_x, goal.Y - jump_y), jump_index });
+                        std::push_heap(open.begin(), open.end());
+                    }
+                }
+                if (stamp[goal_index] != generation || !closed[goal_index]) return false;
+                for (uint32_t index = goal_index; ; index = parent[index]) {
+                    path.push_back(Point((int)(index % width), (int)(index / width)));
+                    if (index == start_index) break;
+                }
+                std::reverse(path.begin(), path.end());
+                return true;
+            }
+        };
+
+        int __width = 0, __height = 0;
+        // Shared with the async queries, copied before changed while any query use it.
+        std::shared_ptr<std::vector<uint8_t>> __walkable;
+        std::vector<std::unique_ptr<FlowField>> __flow_fields;
+        uint64_t __flow_field_counter = 0;
+        __search __sync_search;
+
+        void __detach() {
+            if (__walkable.use_count() > 1) __walkable = std::make_shared<std::vector<uint8_t>>(*__walkable);
+        }
+    public:
+        /// @brief The maximum number of Flow Fields kept, the least recently used is released first. Default is 8.
+        size_t MaxFlowFields = 8;
+
+        /// @brief Create a new Path Grid with all cells walkable.
+        /// @param Width The width of the grid in cells. Default is 0.
+        /// @param Height The height of the grid in cells. Default is 0.
+        PathGrid(int Width = 0, int Height = 0) { SetSize(Width, Height); }
+        virtual ~PathGrid() {}
+
+        ENGINE_NOT_COPYABLE(PathGrid)
+        ENGINE_NOT_ASSIGNABLE(PathGrid)
+
+        /// @brief Get the size of the grid.
+        /// @return The size of the grid in cells.
+        Size GetSize() const { return Size(__width, __height); }
+        /// @brief Set the size of the grid, all cells are set walkable and the Flow Fields are released.
+        /// @param Width The width of the grid in cells.
+        /// @param Height The height of the grid in cells.
+        void SetSize(int Width, int Height) {
+            __width = ENGINE_MAX(0, Width); __height = ENGINE_MAX(0, Height);
+            __walkable = std::make_shared<std::vector<uint8_t>>((size_t)__width * __height, (uint8_t)1);
+            __flow_fields.clear();
+        }
+        /// @brief Check if the given cell is walkable.
+        /// @param X The column of the cell.
+        /// @param Y The row of the cell.
+        /// @return true if the cell is walkable, false otherwise (or out of range).
+        bool IsWalkable(int X, int Y) const {
+            return X >= 0 && Y >= 0 && X < __width && Y < __height && (*__walkable)[(size_t)Y * __width + X];
+        }
+        /// @brief Set the given cell to be walkable or blocked. The Flow Fields are updated on their next GetFlowField().
+        /// @param X The column of the cell, will not set if out of range.
+        /// @param Y The row of the cell, will not set if out of range.
+        /// @param Walkable true to set the cell walkable, false to block it.
+        void SetWalkable(int X, int Y, bool Walkable) {
+            if (X < 0 || Y < 0 || X >= __width || Y >= __height) return;
+            size_t index = (size_t)Y * __width + X;
+            if ((bool)(*__walkable)[index] == Walkable) return;
+            __detach();
+            (*__walkable)[index] = Walkable;
+            for (auto& field : __flow_fields) field->__changes.push_back((uint32_t)index);
+        }
+        /// @brief Set the size and the cells of the grid from the tiles of the given Tilemap.
+        /// @param Map The Tilemap to set from.
+        /// @param IsWalkableTile The predicate that check if a tile number (0 is empty) is walkable.
+        void SetFromTilemap(const TilemapGameObject* Map, const std::function<bool(int)>& IsWalkableTile) {
+            if (!Map || !IsWalkableTile) return;
+            Size map_size = Map->GetMapSize();
+            SetSize(map_size.Width, map_size.Height);
+            for (int y = 0; y < __height; y++)
+                for (int x = 0; x < __width; x++)
+                    (*__walkable)[(size_t)y * __width + x] = IsWalkableTile(Map->GetTile(x, y));
+        }
+
+        /// @brief Find a path between the given cells with Jump Point Search, on the calling thread.
+        /// @param Start The start cell.
+        /// @param Goal The goal cell.
+        /// @param Path The vector to store the path to, as the cells where the path turn (from Start to Goal). The cells
+        /// between two of them are on a straight or diagonal line.
+        /// @return true if a path is found, false otherwise.
+        bool FindPath(const Point& Start, const Point& Goal, std::vector<Point>& Path) {
+            return __sync_search.find(__walkable->data(), __width, __height, Start, Goal, Path);
+        }
+        /// @brief Get the Flow Field to the given goal, created if not cached and updated with the changed cells.
+        /// @param Goal The goal cell.
+        /// @return The Flow Field, or nullptr if the goal is out of range. It's valid until the grid is resized, or the
+        /// Flow Field is released by MaxFlowFields.
+        FlowField* GetFlowField(const Point& Goal) {
+            if (Goal.X < 0 || Goal.Y < 0 || Goal.X >= __width || Goal.Y >= __height) return nullptr;
+            FlowField* result = nullptr;
+            for (auto& field : __flow_fields)
+                if (field->__goal == Goal) { result = field.get(); break; }
+            if (!result) {
+                if (__flow_fields.size() >= ENGINE_MAX((size_t)1, MaxFlowFields)) {
+                    auto oldest = std::min_element(__flow_fields.begin(), __flow_fields.end(),
+                        [](const std::unique_ptr<FlowField>& a, const std::unique_ptr<FlowField>& b) { return a->__last_used < b->__last_used; });
+                    __flow_fields.erase(oldest);
+                }
+                __flow_fields.emplace_back(new FlowField(this, Goal));
+                result = __flow_fields.back().get();
+                result->__compute();
+            }
+            else result->__update();
+            result->__last_used = ++__flow_field_counter;
+            return result;
+        }
+    };
+
+    /// @brief The Path Request ID, identify an async path query. 0 is invalid.
+    typedef uint64_t PathRequestID;
+    /// @brief The Path Result struct, the result of an async path query.
+    struct PathResult {
+        /// @brief The ID of the query.
+        PathRequestID ID = 0;
+        /// @brief The start cell of the query.
+        Point Start = Point::Zero;
+        /// @brief The goal cell of the query.
+        Point Goal = Point::Zero;
+        /// @brief true if a path is found, false otherwise.
+        bool Found = false;
+        /// @brief The path, as the cells where the path turn (see PathGrid::FindPath()).
+        std::vector<Point> Path;
+    };
+    /// @brief The Path Callback, called with the result of an async path query.
+    typedef std::function<void(const PathResult&)> PathCallback;
+
+    /// @brief The Pathfinding class, run path queries on worker threads. The queries see the grid as it was when they
+    /// were requested, and the results are delivered by Update() on the main thread, on the frame after they are done
+    /// (at least the next frame).
+    class Pathfinding final {
+    private:
+        struct __request {
+            PathRequestID id;
+            std::shared_ptr<const std::vector<uint8_t>> walkable;
+            int width, height;
+            Point start, goal;
+            PathCallback callback;
+        };
+        struct __done {
+            PathResult result;
+            PathCallback callback;
+        };
+
+        static std::vector<std::thread> __workers;
+        static std::mutex __mutex;
+        static std::condition_variable __condition;
+        static std::deque<__request> __requests;
+        static std::vector<__done> __done_results, __delivering;
+        // The IDs of the queries being searched, and those of them that canceled (their results are dropped by the worker).
+        static std::unordered_set<PathRequestID> __running, __canceled;
+        static PathRequestID __next_id;
+        static bool __is_stopping;
+
+        static void __worker() {
+            PathGrid::__search search;
+            while (true) {
+                __request request;
+                {
+                    std::unique_lock<std::mutex> lock(__mutex);
+                    __condition.wait(lock, []() { return __is_stopping || !__requests.empty(); });
+                    if (__is_stopping) return;
+                    request = std::move(__requests.front());
+                    __requests.pop_front();
+                    __running.insert(request.id);
+                }
+                __done done;
+                done.result.ID = request.id;
+                done.result.Start = request.start; done.result.Goal = request.goal;
+                done.result.Found = search.find(request.walkable->data(), request.width, request.height,
+                    request.start, request.goal, done.result.Path);
+                done.callback = std::move(request.callback);
+                request.walkable.reset();
+
+                std::lock_guard<std::mutex> lock(__mutex);
+                __running.erase(request.id);
+                if (__canceled.erase(request.id) == 0) __done_results.push_back(std::move(done));
+            }
+        }
+        static void __start_workers() {
+            unsigned int count = ENGINE_MAX(1u, ThreadCount);
+            while (__workers.size() < count) __workers.emplace_back(__worker);
+        }
+    public:
+        /// @brief The number of worker threads, used when the first query is requested. Default is 2.
+        static unsigned int ThreadCount;
+
+        /// @brief Request a path between the given cells of the given grid, found on a worker thread.
+        /// @param Grid The grid to find on, the query use the cells as they are now.
+        /// @param Start The start cell.
+        /// @param Goal The goal cell.
+        /// @param Callback The callback to call with the result, on the main thread.
+        /// @return The ID of the query, or 0 on failed (the grid is null).
+        static PathRequestID FindPathAsync(PathGrid* Grid, const Point& Start, const Point& Goal, const PathCallback& Callback) {
+            if (!Grid) return 0;
+            std::lock_guard<std::mutex> lock(__mutex);
+            __start_workers();
+            __request request;
+            request.id = ++__next_id;
+            request.walkable = Grid->__walkable;
+            request.width = Grid->__width; request.height = Grid->__height;
+            request.start = Start; request.goal = Goal;
+            request.callback = Callback;
+            __requests.push_back(std::move(request));
+            __condition.notify_one();
+            return __next_id;
+        }
+        /// @brief Cancel the given query, its callback will not be called. Should be called on the main thread.
+        /// @param ID The ID of the query, nothing happen if it's unknown or delivered already.
+        static void Cancel(PathRequestID ID) {
+            if (!ID) return;
+            std::lock_guard<std::mutex> lock(__mutex);
+            for (auto it = __requests.begin(); it != __requests.end(); ++it)
+                if (it->id == ID) { __requests.erase(it); return; }
+            if (__running.count(ID) != 0) { __canceled.insert(ID); return; }
+            for (auto it = __done_results.begin(); it != __done_results.end(); ++it)
+                if (it->result.ID == ID) { __done_results.erase(it); return; }
+            // Delivering by Update() (canceled from a callback).
+            for (__done& done : __delivering)
+                if (done.result.ID == ID) { done.callback = nullptr; return; }
+        }
+        /// @brief Get the number of queries that not delivered yet.
+        /// @return The number of pending queries.
+        static size_t GetPendingCount() {
+            std::lock_guard<std::mutex> lock(__mutex);
+            return __requests.size() + __running.size() + __done_results.size();
+        }
+        /// @brief Deliver the results of the done queries. This is called by Application::Start() on every frame, before
+        /// updating the Game Scene.
+        static void Update() {
+            {
+                std::lock_guard<std::mutex> lock(__mutex);
+                if (__done_results.empty()) return;
+                __delivering.swap(__done_results);
+            }
+            for (__done& done : __delivering) {
+                // Taken out first, the callback may cancel its own query.
+                PathCallback callback = std::move(done.callback);
+                done.callback = nullptr;
+                if (callback) callback(done.result);
+            }
+            __delivering.clear();
+        }
+        /// @brief Stop the worker threads and drop all queries. This is called by Deinitialize().
+        static void Deinitialize() {
+            {
+                std::lock_guard<std::mutex> lock(__mutex);
+                __is_stopping = true;
+                __requests.clear();
+            }
+            __condition.notify_all();
+            for (std::thread& worker : __workers) worker.join();
+            __workers.clear();
+            __done_results.clear(); __running.clear(); __canceled.clear();
+            __is_stopping = false;
+        }
+    };
+}
+
+constexpr int Engine::FlowField::__dx[8];
+constexpr int Engine::FlowField::__dy[8];
+
+bool Engine::FlowField::__can_move(const uint8_t* walkable, int width, int height, int x, int y, int direction) const {
+    int to_x = x + __dx[direction], to_y = y + __dy[direction];
+    if (to_x < 0 || to_y < 0 || to_x >= width || to_y >= height) return false;
+    if (!walkable[(size_t)to_y * width + to_x]) return false;
+    if (!(direction & 1)) return true;
+    return walkable[(size_t)y * width + to_x] && walkable[(size_t)to_y * width + x];
+}
+void Engine::FlowField::__relax(const uint8_t* walkable, int width, int height) {
+    while (!__heap.empty()) {
+        std::pop_heap(__heap.begin(), __heap.end());
+        __node node = __heap.back();
+        __heap.pop_back();
+        if (node.distance > __distance[node.index]) continue;
+        int x = (int)(node.index % width), y = (int)(node.index / width);
+        for (int direction = 0; direction < 8; direction++) {
+            if (!__can_move(walkable, width, height, x, y, direction)) continue;
+            uint32_t neighbor = (uint32_t)((y + __dy[direction]) * width + x + __dx[direction]);
+            float distance = node.distance + ((direction & 1) ? 1.41421356f : 1.0f);
+            if (distance >= __distance[neighbor]) continue;
+            __distance[neighbor] = distance;
+            __next[neighbor] = (int8_t)((direction + 4) & 7);
+            __heap.push_back(__node{ distance, neighbor });
+            std::push_heap(__heap.begin(), __heap.end());
+        }
+    }
+}
+bool Engine::FlowField::__reseed(const uint8_t* walkable, int width, int height, uint32_t index) {
+    if (!walkable[index] || __distance[index] == 0.0f) return false;
+    int x = (int)(index % width), y = (int)(index / width);
+    float best = __distance[index];
+    int8_t best_direction = __next[index];
+    for (int direction = 0; direction < 8; direction++) {
+        if (!__can_move(walkable, width, height, x, y, direction)) continue;
+        uint32_t neighbor = (uint32_t)((y + __dy[direction]) * width + x + __dx[direction]);
+        float distance = __distance[neighbor] + ((direction & 1) ? 1.41421356f : 1.0f);
+        if (distance < best) { best = distance; best_direction = (int8_t)direction; }
+    }
+    if (best >= __distance[index]) return false;
+    __distance[index] = best; __next[index] = best_direction;
+    return true;
+}
+void Engine::FlowField::__compute() {
+    const int width = __grid->__width, height = __grid->__height;
+    const uint8_t* walkable = __grid->__walkable->data();
+    __distance.assign((size_t)width * height, INFINITY);
+    __next.assign((size_t)width * height, -1);
+    __changes.clear(); __heap.clear();
+    uint32_t goal = (uint32_t)(__goal.Y * width + __goal.X);
+    if (!walkable[goal]) return;
+    __distance[goal] = 0.0f;
+    __heap.push_back(__node{ 0.0f, goal });
+    __relax(walkable, width, height);
+}
+void Engine::FlowField::__update() {
+    if (__changes.empty()) return;
+    const int width = __grid->__width, height = __grid->__height;
+    const uint8_t* walkable = __grid->__walkable->data();
+    uint32_t goal = (uint32_t)(__goal.Y * width + __goal.X);
+    // Many changes, or the goal changed, are cheaper to compute again.
+    bool is_goal_changed = std::find(__changes.begin(), __changes.end(), goal) != __changes.end();
+    if (is_goal_changed || __changes.size() * 16 > __distance.size()) { __compute(); return; }
+
+    // Invalidate the blocked cells, the cells that move through or diagonally past them, and all cells that move
+    // through those (found by following the next directions backward).
+    __mark.assign(__distance.size(), 0);
+    __stack.clear();
+    std::vector<uint32_t> seeds;
+    auto invalidate = [this](uint32_t index) {
+        if (__mark[index]) return;
+        __mark[index] = 1; __stack.push_back(index);
+    };
+    for (uint32_t index : __changes) {
+        int x = (int)(index % width), y = (int)(index / width);
+        seeds.push_back(index);
+        for (int direction = 0; direction < 8; direction++) {
+            int nx = x + __dx[direction], ny = y + __dy[direction];
+            if (nx < 0 || ny < 0 || nx >= width || ny >= height) continue;
+            uint32_t neighbor = (uint32_t)(ny * width + nx);
+            seeds.push_back(neighbor);
+            if (walkable[index]) continue;
+            int next = __next[neighbor];
+            if (next < 0) continue;
+            int to_x = nx + __dx[next], to_y = ny + __dy[next];
+            bool is_through = to_x == x && to_y == y;
+            bool is_past = (next & 1) && ((to_x == x && ny == y) || (nx == x && to_y == y));
+            if (is_through || is_past) invalidate(neighbor);
+        }
+        if (!walkable[index]) invalidate(index);
+    }
+    for (size_t i = 0; i < __stack.size(); i++) {
+        uint32_t index = __stack[i];
+        int x = (int)(index % width), y = (int)(index / width);
+        for (int direction = 0; direction < 8; direction++) {
+            int nx = x + __dx[direction], ny = y + __dy[direction];
+            if (nx < 0 || ny < 0 || nx >= width || ny >= height) continue;
+            uint32_t neighbor = (uint32_t)(ny * width + nx);
+            if (__next[neighbor] == (int8_t)((direction + 4) & 7)) invalidate(neighbor);
+        }
+    }
+    for (uint32_t index : __stack) { __distance[index] = INFINITY; __next[index] = -1; }
+
+    // Seed the invalidated cells and the cells around the changes from their neighbors, then spread.
+    __heap.clear();
+    for (uint32_t index : __stack) seeds.push_back(index);
+    for (uint32_t index : seeds)
+        if (__reseed(walkable, width, height, index)) __heap.push_back(__node{ __distance[index], index });
+    // The cells around a cell that became walkable can spread through it too.
+    for (uint32_t index : __changes)
+        if (walkable[index] && __distance[index] < INFINITY) __heap.push_back(__node{ __distance[index], index });
+    std::make_heap(__heap.begin(), __heap.end());
+    __relax(walkable, width, height);
+    __changes.clear();
+}
+float Engine::FlowField::GetDistance(int X, int Y) const {
+    const int width = __grid->__width, height = __grid->__height;
+    if (X < 0 || Y < 0 || X >= width || Y >= height || __distance.size() != (size_t)width * height) return INFINITY;
+    return __distance[(size_t)Y * width + X];
+}
+Engine::Point Engine::FlowField::GetNextCell(int X, int Y) const {
+    const int width = __grid->__width, height = __grid->__height;
+    if (X < 0 || Y < 0 || X >= width || Y >= height || __next.size() != (size_t)width * height) return Point(X, Y);
+    int next = __next[(size_t)Y * width + X];
+    return next < 0 ? Point(X, Y) : Point(X + __dx[next], Y + __dy[next]);
+}
+
+std::vector<std::thread> Engine::Pathfinding::__workers = std::vector<std::thread>();
+std::mutex Engine::Pathfinding::__mutex;
+std::condition_variable Engine::Pathfinding::__condition;
+std::deque<Engine::Pathfinding::__request> Engine::Pathfinding::__requests = std::deque<Engine::Pathfinding::__request>();
+std::vector<Engine::Pathfinding::__done> Engine::Pathfinding::__done_results = std::vector<Engine::Pathfinding::__done>();
+std::vector<Engine::Pathfinding::__done> Engine::Pathfinding::__delivering = std::vector<Engine::Pathfinding::__done>();
+std::unordered_set<Engine::PathRequestID> Engine::Pathfinding::__running = std::unordered_set<Engine::PathRequestID>();
+std::unordered_set<Engine::PathRequestID> Engine::Pathfinding::__canceled = std::unordered_set<Engine::PathRequestID>();
+Engine::PathRequestID Engine::Pathfinding::__next_id = 0;
+bool Engine::Pathfinding::__is_stopping = false;
+unsigned int Engine::Pathfinding::ThreadCount = 2;
+
+#endif // __ENGINE_PATHFINDING_H__
\ No newline at end of file
@@ -0,0 +1,499 @@
+#ifndef __ENGINE_PHYSICS_H__
+#define __ENGINE_PHYSICS_H__
+
+#include "Engine_Define.h"
+#include "Engine_Collision.h"
+#include "Engine_GameObject.h"
+#include "Engine_Math.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Engine {
+    /// @brief The Rigid Body Type enum, define how a rigid body is simulated.
+    enum class RigidBodyType {
+        /// @brief Moved by the velocity, forces and contacts.
+        Dynamic = 0,
+        /// @brief Moved by the velocity only, and push the dynamic bodies as if it had infinite mass.
+        Kinematic = 1,
+        /// @brief Never moved.
+        Static = 2
+    };
+
+    /// @brief The Rigid Body Script class, attach a rigid body to the Game Object (with AddScript<RigidBodyScript>()).
+    /// The body collide with the ColliderScript of the same Game Object (without it, the body is only moved by its
+    /// velocity). The body is simulated by Physics at a fixed time step, and write the precise position of the Game
+    /// Object. The bodies do not rotate.
+    class RigidBodyScript : public GameScript {
+        friend class Physics;
+    private:
+        GameObject* __target = nullptr;
+        uint32_t __index = UINT32_MAX;
+        ColliderScript* __collider = nullptr;
+        Vec2f __force = Vec2f::Zero;
+        float __sleep_time = 0.0f;
+        bool __is_awake = true;
+    protected:
+        void OnStart(GameObject* Target) override;
+        void OnStop(GameObject* Target) override;
+    public:
+        /// @brief The type of the body. Default is RigidBodyType::Dynamic.
+        RigidBodyType Type = RigidBodyType::Dynamic;
+        /// @brief The velocity of the body in pixels per second. Call WakeUp() after changing it on a sleeping body.
+        /// Default is Vec2f::Zero.
+        Vec2f Velocity = Vec2f::Zero;
+        /// @brief The mass of the Dynamic body, should be greater than 0. Default is 1.
+        float Mass = 1.0f;
+        /// @brief The restitution (bounciness) from 0 to 1, the greater of the two bodies is used. Default is 0.
+        float Restitution = 0.0f;
+        /// @brief The friction coefficient, the geometric mean of the two bodies is used. Default is 0.5.
+        float Friction = 0.5f;
+        /// @brief The multiplier of Physics::Gravity for the body. Default is 1.
+        float GravityScale = 1.0f;
+        /// @brief The fraction of the velocity lost per second. Default is 0.
+        float LinearDamping = 0.0f;
+        /// @brief If this false, the body never sleep. Default is true.
+        bool AllowSleep = true;
+
+        RigidBodyScript() = default;
+        virtual ~RigidBodyScript();
+
+        /// @brief Get the Game Object of the body.
+        /// @return The Game Object, or nullptr if not attached.
+        GameObject* GetTarget() const { return __target; }
+        /// @brief Get the inverse mass of the body.
+        /// @return The inverse mass, or 0 if the body is not Dynamic.
+        float GetInverseMass() const { return (Type == RigidBodyType::Dynamic && Mass > 0.0f) ? 1.0f / Mass : 0.0f; }
+        /// @brief Add a force to the body for the next step, and wake it up.
+        /// @param Force The force to add.
+        void ApplyForce(const Vec2f& Force) { __force = __force + Force; WakeUp(); }
+        /// @brief Change the velocity of the body by the given impulse, and wake it up.
+        /// @param Impulse The impulse to apply.
+        void ApplyImpulse(const Vec2f& Impulse) { Velocity = Velocity + Impulse * GetInverseMass(); WakeUp(); }
+        /// @brief Check if the body is awake. A sleeping body is not simulated until woken up by a contact or WakeUp().
+        /// @return true if the body is awake, false otherwise.
+        bool IsAwake() const { return __is_awake; }
+        /// @brief Wake up the body.
+        void WakeUp() { __is_awake = true; __sleep_time = 0.0f; }
+        /// @brief Put the body to sleep, and stop it.
+        void Sleep() { __is_awake = false; __sleep_time = 0.0f; Velocity = Vec2f::Zero; }
+    };
+
+    /// @brief The Physics class, simulate all rigid bodies at a fixed time step. Each step detects the contacts with
+    /// Collision, groups the bodies that touch each other into islands, and solves each island with sequential impulses.
+    /// The islands are independent, so they are solved in parallel by the worker threads, and the result does not
+    /// depend on the number of threads (only on the order of the bodies and the contacts).
+    class Physics final {
+        friend class RigidBodyScript;
+    private:
+        struct __contact {
+            RigidBodyScript* a;
+            RigidBodyScript* b;
+            Vec2f normal;
+            float depth, friction, restitution;
+            float normal_mass, bias;
+            float normal_impulse, tangent_impulse;
+        };
+
+        static std::vector<RigidBodyScript*> __bodies;
+        static uint32_t __collision_version;
+        static bool __is_linked;
+        static double __accumulator;
+
+        // The islands, as ranges of bodies and contacts.
+        static std::vector<uint32_t> __parents;
+        static std::vector<uint32_t> __island_of_root;
+        static std::vector<uint32_t> __island_bodies, __island_body_offsets;
+        static std::vector<__contact> __contacts;
+        static std::vector<__contact> __island_contacts;
+        static std::vector<uint32_t> __island_contact_offsets;
+        static std::vector<uint8_t> __island_awake;
+
+        // The worker threads.
+        static std::vector<std::thread> __workers;
+        static std::mutex __mutex;
+        static std::condition_variable __work_condition, __done_condition;
+        static uint64_t __job;
+        static uint32_t __busy_workers;
+        static bool __is_stopping;
+        static std::atomic<uint32_t> __next_island;
+        static float __step_time;
+
+        static void __add(RigidBodyScript* body) {
+            if (body->__index != UINT32_MAX) return;
+            body->__index = (uint32_t)__bodies.size();
+            __bodies.push_back(body);
+            __is_linked = false;
+        }
+        static void __remove(RigidBodyScript* body) {
+            uint32_t index = body->__index;
+            if (index == UINT32_MAX) return;
+            if (body->__collider) body->__collider->__body = nullptr;
+            body->__collider = nullptr;
+            // Keep the order of the others, so the result stays the same.
+            __bodies.erase(__bodies.begin() + index);
+            for (uint32_t i = index; i < __bodies.size(); i++) __bodies[i]->__index = i;
+            body->__index = UINT32_MAX;
+            __is_linked = false;
+        }
+        /// @brief Link the bodies with the colliders of their Game Objects, after any of them added or removed.
+        static void __link() {
+            if (__is_linked && __collision_version == Collision::__version) return;
+            for (ColliderScript* collider : Collision::__colliders)
+                if (collider) collider->__body = nullptr;
+            for (RigidBodyScript* body : __bodies) {
+                GameObject* target = body->GetTarget();
+                body->__collider = target ? target->GetScript<ColliderScript>() : nullptr;
+                if (body->__collider) body->__collider->__body = body;
+            }
+            __collision_version = Collision::__version;
+            __is_linked = true;
+        }
+        static uint32_t __find(uint32_t i) {
+            while (__parents[i] != i) { __parents[i] = __parents[__parents[i]]; i = __parents[i]; }
+            return i;
+        }
+        /// @brief Build the solver contacts and the islands from the contacts of Collision.
+        static void __build_islands() {
+            const uint32_t body_count = (uint32_t)__bodies.size();
+            __parents.resize(body_count);
+            for (uint32_t i = 0; i < body_count; i++) __parents[i] = i;
+
+            __contacts.clear();
+            for (const Contact& contact : Collision::GetContacts()) {
+                if (contact.A->IsTrigger || contact.B->IsTrigger) continue;
+                RigidBodyScript* a = contact.A->__body, * b = contact.B->__body;
+                bool is_dynamic_a = a && a->Type == RigidBodyType::Dynamic;
+                bool is_dynamic_b = b && b->Type == RigidBodyType::Dynamic;
+                if (!is_dynamic_a && !is_dynamic_b) continue;
+
+                __contact solver_contact = {};
+                solver_contact.a = a; solver_contact.b = b;
+                solver_contact.normal = contact.Normal;
+                solver_contact.depth = contact.Depth;
+                float friction_a = a ? a->Friction : 0.5f, friction_b = b ? b->Friction : 0.5f;
+                solver_contact.friction = sqrtf(ENGINE_MAX(0.0f, friction_a * friction_b));
+                solver_contact.restitution = ENGINE_MAX(a ? a->Restitution : 0.0f, b ? b->Restitution : 0.0f);
+                __contacts.push_back(solver_contact);
+
+                if (is_dynamic_a && is_dynamic_b) {
+                    uint32_t root_a = __find(a->__index), root_b = __find(b->__index);
+                    // Always keep the smaller root, so the islands do not depend on the union order.
+                    if (root_a < root_b) __parents[root_b] = root_a;
+                    else if (root_b < root_a) __parents[root_a] = root_b;
+                    // A touching sleeping body is woken up.
+                    if (a->__is_awake != b->__is_awake) { a->WakeUp(); b->WakeUp(); }
+                }
+                else {
+                    // A moving kinematic body wake up the dynamic body it touch.
+                    RigidBodyScript* other = is_dynamic_a ? b : a;
+                    RigidBodyScript* dynamic = is_dynamic_a ? a : b;
+                    if (other && other->Velocity != Vec2f::Zero) dynamic->WakeUp();
+                }
+            }
+
+            // Number the islands by their first body, and group the bodies and the contacts by island in order.
+            const uint32_t none = UINT32_MAX;
+            __island_of_root.assign(body_count, none);
+            uint32_t island_count = 0;
+            for (uint32_t i = 0; i < body_count; i++) {
+                if (__bodies[i]->Type != RigidBodyType::Dynamic) continue;
+                uint32_t root = __find(i);
+                if (__island_of_root[root] == none) __island_of_root[root] = island_count++;
+            }
+            __island_body_offsets.assign(island_count + 1, 0);
+            __island_contact_offsets.assign(island_count + 1, 0);
+            __island_awake.assign(island_count, 0);
+            for (uint32_t i = 0; i < body_count; i++) {
+                if (__bodies[i]->Type != RigidBodyType::Dynamic) continue;
+                uint32_t island = __island_of_root[__find(i)];
+                __island_body_offsets[island + 1]++;
+                if (__bodies[i]->__is_awake) __island_awake[island] = 1;
+            }
+            auto island_of_contact = [](const __contact& contact) {
+                RigidBodyScript* body = (contact.a && contact.a->Type == RigidBodyType::Dynamic) ? contact.a : contact.b;
+                return __island_of_root[__find(body->__index)];
+            };
+            for (const __contact& contact : __contacts) __island_contact_offsets[island_of_contact(contact) + 1]++;
+            for (uint32_t island = 0; island < island_count; island++) {
+                __island_body_offsets[island + 1] += __island_body_offsets[island];
+                __island_contact_offsets[island + 1] += __island_contact_offsets[island];
+            }
+
+            std::vector<uint32_t> cursors(__island_body_offsets.begin(), __island_body_offsets.end() - 1);
+            __island_bodies.resize(__island_body_offsets[island_count]);
+            for (uint32_t i = 0; i < body_count; i++) {
+                if (__bodies[i]->Type != RigidBodyType::Dynamic) continue;
+                uint32_t island = __island_of_root[__find(i)];
+                __island_bodies[cursors[island]++] = i;
+            }
+            cursors.assign(__island_contact_offsets.begin(), __island_contact_offsets.end() - 1);
+            __island_contacts.resize(__contacts.size());
+            for (const __contact& contact : __contacts)
+                __island_contacts[cursors[island_of_contact(contact)]++] = contact;
+        }
+        /// @brief Simulate the island at the given index for the given time.
+        static void __solve_island(uint32_t island, float dt) {
+            RigidBodyScript* const* bodies = __bodies.data();
+            const uint32_t* body_begin = __island_bodies.data() + __island_body_offsets[island];
+            const uint32_t* body_end = __island_bodies.data() + __island_body_offsets[island + 1];
+            __contact* contact_begin = __island_contacts.data() + __island_contact_offsets[island];
+            __contact* contact_end = __island_contacts.data() + __island_contact_offsets[island + 1];
+
+            if (!__island_awake[island]) return;
+            for (const uint32_t* i = body_begin; i != body_end; i++) bodies[*i]->__is_awake = true;
+
+            // Integrate the velocities.
+            for (const uint32_t* i = body_begin; i != body_end; i++) {
+                RigidBodyScript* body = bodies[*i];
+                Vec2f acceleration = Physics::Gravity * body->GravityScale + body->__force * body->GetInverseMass();
+                body->Velocity = (body->Velocity + acceleration * dt) * (1.0f / (1.0f + body->LinearDamping * dt));
+                body->__force = Vec2f::Zero;
+            }
+
+            // Prepare the contacts, the bias push the bodies apart and bounce them.
+            for (__contact* contact = contact_begin; contact != contact_end; contact++) {
+                float inverse_mass = (contact->a ? contact->a->GetInverseMass() : 0.0f) + (contact->b ? contact->b->GetInverseMass() : 0.0f);
+                contact->normal_mass = inverse_mass > 0.0f ? 1.0f / inverse_mass : 0.0f;
+                Vec2f velocity_a = contact->a ? contact->a->Velocity : Vec2f::Zero;
+                Vec2f velocity_b = contact->b ? contact->b->Velocity : Vec2f::Zero;
+                float normal_velocity = (velocity_b - velocity_a).Dot(contact->normal);
+                float bounce = normal_velocity < -Physics::RestitutionThreshold ? -contact->restitution * normal_velocity : 0.0f;
+                float push = Physics::PositionCorrection / dt * ENGINE_MAX(0.0f, contact->depth - Physics::PenetrationSlop);
+                contact->bias = ENGINE_MAX(bounce, push);
+                contact->normal_impulse = contact->tangent_impulse = 0.0f;
+            }
+
+            // Solve the velocities.
+            for (int iteration = 0; iteration < Physics::VelocityIterations; iteration++) {
+                for (__contact* contact = contact_begin; contact != contact_end; contact++) {
+                    RigidBodyScript* a = contact->a, * b = contact->b;
+                    float inverse_mass_a = a ? a->GetInverseMass() : 0.0f, inverse_mass_b = b ? b->GetInverseMass() : 0.0f;
+                    Vec2f velocity_a = a ? a->Velocity : Vec2f::Zero, velocity_b = b ? b->Velocity : Vec2f::Zero;
+                    Vec2f normal = contact->normal, tangent = Vec2f(-normal.Y, normal.X);
+
+                    float normal_velocity = (velocity_b - velocity_a).Dot(normal);
+                    float impulse = contact->normal_mass * (contact->bias - normal_velocity);
+                    float total = ENGINE_MAX(0.0f, contact->normal_impulse + impulse);
+                    impulse = total - contact->normal_impulse;
+                    contact->normal_impulse = total;
+                    velocity_a = velocity_a - normal * (impulse * inverse_mass_a);
+                    velocity_b = velocity_b + normal * (impulse * inverse_mass_b);
+
+                    float tangent_velocity = (velocity_b - velocity_a).Dot(tangent);
+                    float max_friction = contact->friction * contact->normal_impulse;
+                    impulse = -contact->normal_mass * tangent_velocity;
+                    total = ENGINE_FAST_CLAMP(-max_friction, max_friction, contact->tangent_impulse + impulse);
+                    impulse = total - contact->tangent_impulse;
+                    contact->tangent_impulse = total;
+                    velocity_a = velocity_a - tangent * (impulse * inverse_mass_a);
+                    velocity_b = velocity_b + tangent * (impulse * inverse_mass_b);
+
+                    if (a && a->Type == RigidBodyType::Dynamic) a->Velocity = velocity_a;
+                    if (b && b->Type == RigidBodyType::Dynamic) b->Velocity = velocity_b;
+                }
+            }
+
+            // Integrate the positions, and put the island to sleep if all its bodies rest long enough.
+            bool can_sleep = true;
+            const float sleep_velocity_squared = Physics::SleepVelocity * Physics::SleepVelocity;
+            for (const uint32_t* i = body_begin; i != body_end; i++) {
+                RigidBodyScript* body = bodies[*i];
+                GameObject* target = body->GetTarget();
+                if (target) target->SetPrecisePosition(target->GetPrecisePosition() + body->Velocity * dt);
+                if (!body->AllowSleep || body->Velocity.LengthSquared() > sleep_velocity_squared) body->__sleep_time = 0.0f;
+                else body->__sleep_time += dt;
+                if (body->__sleep_time < Physics::TimeToSleep) can_sleep = false;
+            }
+            if (can_sleep)
+                for (const uint32_t* i = body_begin; i != body_end; i++) bodies[*i]->Sleep();
+        }
+        /// @brief Solve the islands that not taken yet, until all are taken.
+        static void __solve_islands() {
+            const uint32_t island_count = (uint32_t)__island_awake.size();
+            for (uint32_t island = __next_island++; island < island_count; island = __next_island++)
+                __solve_island(island, __step_time);
+        }
+        /// @brief The loop of a worker thread.
+        /// @param last_job The job current when the worker is created, so it only pick up the jobs after it.
+        static void __worker(uint64_t last_job) {
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> lock(__mutex);
+                    __work_condition.wait(lock, [&last_job]() { return __is_stopping || __job != last_job; });
+                    if (__is_stopping) return;
+                    last_job = __job;
+                }
+                __solve_islands();
+                std::lock_guard<std::mutex> lock(__mutex);
+                if (--__busy_workers == 0) __done_condition.notify_one();
+            }
+        }
+        static void __stop_workers() {
+            {
+                std::lock_guard<std::mutex> lock(__mutex);
+                __is_stopping = true;
+            }
+            __work_condition.notify_all();
+            for (std::thread& worker : __workers) worker.join();
+            __workers.clear();
+            __is_stopping = false;
+        }
+        /// @brief Get the number of the threads to use (including the calling thread).
+        static unsigned int __get_thread_count() {
+            unsigned int count = Physics::ThreadCount ? Physics::ThreadCount : std::thread::hardware_concurrency();
+            return ENGINE_MAX(1u, count);
+        }
+    public:
+        /// @brief The gravity in pixels per second squared. Default is (0, 980).
+        static Vec2f Gravity;
+        /// @brief The fixed time step of the simulation in seconds. Default is 1 / 60.
+        static double FixedTimeStep;
+        /// @brief The maximum number of steps per Update(), the time left is dropped if a full step is still due. Default is 4.
+        static int MaxStepsPerUpdate;
+        /// @brief The number of velocity iterations per step, more is more accurate for stacking. Default is 8.
+        static int VelocityIterations;
+        /// @brief The fraction of the penetration corrected per step. Default is 0.2.
+        static float PositionCorrection;
+        /// @brief The penetration allowed without correction, to keep the contacts stable. Default is 0.5.
+        static float PenetrationSlop;
+        /// @brief The relative velocity below which the bodies do not bounce. Default is 30.
+        static float RestitutionThreshold;
+        /// @brief The velocity below which the bodies are considered resting. Default is 5.
+        static float SleepVelocity;
+        /// @brief The time in seconds that all bodies of an island must rest before the island sleep. Default is 0.5.
+        static float TimeToSleep;
+        /// @brief The number of threads to solve the islands with, including the calling thread. Default is 0 mean the
+        /// number of hardware threads.
+        static unsigned int ThreadCount;
+        /// @brief The minimum number of islands to solve in parallel, fewer islands are solved on the calling thread.
+        /// Default is 16.
+        static unsigned int MinParallelIslands;
+
+        /// @brief Simulate one step of the given time.
+        /// @param DeltaTime The time of the step in seconds.
+        static void Step(double DeltaTime) {
+            if (DeltaTime <= 0 || __bodies.empty()) return;
+            __link();
+            // Collision::Update() reuse these contacts on this frame.
+            Collision::Detect();
+            __build_islands();
+
+            // Kinematic bodies are moved by their velocity only.
+            const float dt = (float)DeltaTime;
+            for (RigidBodyScript* body : __bodies) {
+                if (body->Type != RigidBodyType::Kinematic || body->Velocity == Vec2f::Zero) continue;
+                GameObject* target = body->GetTarget();
+                if (target) target->SetPrecisePosition(target->GetPrecisePosition() + body->Velocity * dt);
+            }
+
+            __step_time = dt;
+            __next_island = 0;
+            const uint32_t island_count = (uint32_t)__island_awake.size();
+            unsigned int thread_count = __get_thread_count();
+            if (thread_count < 2 || island_count < ENGINE_MAX(2u, Physics::MinParallelIslands)) {
+                __solve_islands();
+                return;
+            }
+            if (__workers.size() != thread_count - 1) {
+                __stop_workers();
+                for (unsigned int i = 1; i < thread_count; i++) __workers.emplace_back(__worker, __job);
+            }
+            {
+                std::lock_guard<std::mutex> lock(__mutex);
+                __busy_workers = (uint32_t)__workers.size();
+                __job++;
+            }
+            __work_condition.notify_all();
+            __solve_islands();
+            std::unique_lock<std::mutex> lock(__mutex);
+            __done_condition.wait(lock, []() { return __busy_workers == 0; });
+        }
+        /// @brief Advance the simulation by the given time in fixed steps. This is called by Application::Start() before
+        /// updating the Game Scene.
+        /// @param DeltaTime The time of the frame in seconds.
+        static void Update(double DeltaTime) {
+            if (__bodies.empty()) { __accumulator = 0; return; }
+            __accumulator += DeltaTime;
+            double step = ENGINE_MAX(1e-4, FixedTimeStep);
+            int steps = 0;
+            while (__accumulator >= step && steps < MaxStepsPerUpdate) {
+                Step(step);
+                __accumulator -= step;
+                steps++;
+            }
+            // Still behind after the maximum steps, drop the time so it doesn't spiral.
+            if (__accumulator >= step) __accumulator = 0;
+        }
+
+        /// @brief Get the number of rigid bodies.
+        /// @return The number of attached rigid bodies.
+        static size_t GetBodyCount() { return __bodies.size(); }
+        /// @brief Get the number of islands of the last step.
+        /// @return The number of islands.
+        static size_t GetIslandCount() { return __island_awake.size(); }
+        /// @brief Remove all rigid bodies and stop the worker threads. This is called by Deinitialize().
+        static void Deinitialize() {
+            __stop_workers();
+            for (RigidBodyScript* body : __bodies)
+                if (body) { body->__index = UINT32_MAX; body->__collider = nullptr; }
+            __bodies.clear();
+            __contacts.clear(); __island_contacts.clear();
+            __island_awake.clear();
+            __accumulator = 0;
+            __is_linked = false;
+        }
+    };
+}
+
+void Engine::RigidBodyScript::OnStart(GameObject* Target) {
+    __target = Target;
+    Physics::__add(this);
+}
+void Engine::RigidBodyScript::OnStop(GameObject* Target) {
+    Physics::__remove(this);
+    __target = nullptr;
+}
+Engine::RigidBodyScript::~RigidBodyScript() { Physics::__remove(this); }
+
+std::vector<Engine::RigidBodyScript*> Engine::Physics::__bodies = std::vector<Engine::RigidBodyScript*>();
+uint32_t Engine::Physics::__collision_version = 0;
+bool Engine::Physics::__is_linked = false;
+double Engine::Physics::__accumulator = 0;
+std::vector<uint32_t> Engine::Physics::__parents = std::vector<uint32_t>();
+std::vector<uint32_t> Engine::Physics::__island_of_root = std::vector<uint32_t>();
+std::vector<uint32_t> Engine::Physics::__island_bodies = std::vector<uint32_t>();
+std::vector<uint32_t> Engine::Physics::__island_body_offsets = std::vector<uint32_t>();
+std::vector<Engine::Physics::__contact> Engine::Physics::__contacts = std::vector<Engine::Physics::__contact>();
+std::vector<Engine::Physics::__contact> Engine::Physics::__island_contacts = std::vector<Engine::Physics::__contact>();
+std::vector<uint32_t> Engine::Physics::__island_contact_offsets = std::vector<uint32_t>();
+std::vector<uint8_t> Engine::Physics::__island_awake = std::vector<uint8_t>();
+std::vector<std::thread> Engine::Physics::__workers = std::vector<std::thread>();
+std::mutex Engine::Physics::__mutex;
+std::condition_variable Engine::Physics::__work_condition;
+std::condition_variable Engine::Physics::__done_condition;
+uint64_t Engine::Physics::__job = 0;
+uint32_t Engine::Physics::__busy_workers = 0;
+bool Engine::Physics::__is_stopping = false;
+std::atomic<uint32_t> Engine::Physics::__next_island(0);
+float Engine::Physics::__step_time = 0.0f;
+
+Engine::Vec2f Engine::Physics::Gravity = Engine::Vec2f(0.0f, 980.0f);
+double Engine::Physics::FixedTimeStep = 1.0 / 60.0;
+int Engine::Physics::MaxStepsPerUpdate = 4;
+int Engine::Physics::VelocityIterations = 8;
+float Engine::Physics::PositionCorrection = 0.2f;
+float Engine::Physics::PenetrationSlop = 0.5f;
+float Engine::Physics::RestitutionThreshold = 30.0f;
+float Engine::Physics::SleepVelocity = 5.0f;
+float Engine::Physics::TimeToSleep = 0.5f;
+unsigned int Engine::Physics::ThreadCount = 0;
+unsigned int Engine::Physics::MinParallelIslands = 16;
+
+#endif // __ENGINE_PHYSICS_H__
\ No newline at end of file
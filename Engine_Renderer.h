@@ -3,6 +3,7 @@
 
 #include "Engine_Window.h"
 #include "Engine_Color.h"
+#include "Engine_Math.h"
 
 #include <SDL2/SDL2_gfxPrimitives.h>
 
@@ -166,6 +167,31 @@ namespace Engine {
         /// @param Width The width of the Rectangle (along the x direction), will not draw if this value is 0.
         /// @param Height The height of the Rectangle (along the y direction), will not draw if this value is 0.
         static void FillRectangle(int X, int Y, int Width, int Height) { FillRectangle(Rectangle(X, Y, Width, Height)); }
+        /// @brief Fill a rectangle to the drawing area with sub-pixel precision.
+        /// @param Area The area to fill, will not fill if the area is empty.
+        static void FillRectangle(const RectF& Area) {
+            if (!Renderer::__renderer) return;
+            SDL_FRect tmp = { ENGINE_MIN(Area.X, Area.X + Area.Width), ENGINE_MIN(Area.Y, Area.Y + Area.Height), fabsf(Area.Width), fabsf(Area.Height) };
+            SDL_RenderFillRectF(Renderer::__renderer, &tmp);
+        }
+        /// @brief Fill a rectangle transformed by the given transform to the drawing area. The rectangle is filled as a
+        /// quad if the transform rotate or skew.
+        /// @param Transform The transform to apply.
+        /// @param Area The area to fill, before transformed.
+        static void FillRectangle(const Mat3x2f& Transform, const RectF& Area) {
+            if (!Renderer::__renderer) return;
+            if (Transform.M12 == 0.0f && Transform.M21 == 0.0f) { FillRectangle(Transform.TransformBounds(Area)); return; }
+
+            Color color = GetDrawColor();
+            SDL_Color sdl_color = { color.Red, color.Green, color.Blue, color.Alpha };
+            Vec2f corners[4] = { Area.TopLeft(), Vec2f(Area.Right(), Area.Y), Vec2f(Area.X, Area.Bottom()), Area.BottomRight() };
+            Transform.TransformPoints(corners, corners, 4);
+            SDL_Vertex vertices[4];
+            for (int i = 0; i < 4; i++)
+                vertices[i] = SDL_Vertex{ SDL_FPoint{ corners[i].X, corners[i].Y }, sdl_color, SDL_FPoint{ 0.0f, 0.0f } };
+            static const int indices[6] = { 0, 1, 2, 2, 1, 3 };
+            SDL_RenderGeometry(Renderer::__renderer, nullptr, vertices, 4, indices, 6);
+        }
 
         /// @brief Fill a rounded-corner rectangle to the drawing area.
         /// @param Rectangle The Rectangle to fill, will not fill if the area is empty.
@@ -313,6 +339,43 @@ namespace Engine {
         /// @param Alignment The alignment of the texture when drawing. Default is TopLeft.
         static void DrawTextureUnscaled(const Rectangle& Area, Engine::Texture* Texture, const Point& Center, double RotationAngle = 0,
             bool HorizontalFlip = false, bool VerticalFlip = false, RectangleAlignment Alignment = RectangleAlignment::TopLeft);
+        /// @brief Draw a Texture to the drawing area with sub-pixel precision.
+        /// @param Area The target area to draw (will scaled the Texture to fit).
+        /// @param Texture The texture to draw.
+        /// @param RotationAngle The angle to rotate the texture around the center of the area, in degrees. Default is 0.
+        /// @param HorizontalFlip If this true, will flipped output texture horizontally when drawing. Default is false.
+        /// @param VerticalFlip If this true, will flipped output texture vertically when drawing. Default is false.
+        static void DrawTexture(const RectF& Area, Engine::Texture* Texture, double RotationAngle = 0,
+            bool HorizontalFlip = false, bool VerticalFlip = false);
+        /// @brief Draw a Texture to the given area transformed by the given transform (translation, rotation, scale and
+        /// flip, the skew is ignored).
+        /// @param Transform The transform to apply.
+        /// @param Area The target area to draw, before transformed.
+        /// @param Texture The texture to draw.
+        static void DrawTexture(const Mat3x2f& Transform, const RectF& Area, Engine::Texture* Texture);
+        /// @brief Set the texture to draw to, instead of the window.
+        /// @param Target The texture to draw to (must be created with Texture::Create()), or nullptr to draw to the window.
+        /// @return true on success, false on failed.
+        static bool SetTarget(Engine::Texture* Target);
+        /// @brief Draw to the window again, after SetTarget().
+        static void ResetTarget() { if (Renderer::__renderer) SDL_SetRenderTarget(Renderer::__renderer, nullptr); }
+        /// @brief Get the SDL texture currently drawn to, use to restore it after drawing to another target.
+        /// @return The SDL texture drawn to, or nullptr if drawing to the window.
+        static SDL_Texture* GetSDLTarget() { return Renderer::__renderer ? SDL_GetRenderTarget(Renderer::__renderer) : nullptr; }
+        /// @brief Set the SDL texture to draw to, as returned by GetSDLTarget().
+        /// @param Target The SDL texture to draw to, or nullptr to draw to the window.
+        /// @return true on success, false on failed.
+        static bool SetSDLTarget(SDL_Texture* Target) {
+            return Renderer::__renderer && SDL_SetRenderTarget(Renderer::__renderer, Target) == 0;
+        }
+        /// @brief Draw a batch of triangles to the drawing area, in one draw call.
+        /// @param Texture The texture to map onto the triangles, or nullptr for solid triangles.
+        /// @param Vertices The vertices of the triangles.
+        /// @param VertexCount The number of vertices.
+        /// @param Indices The indices of the vertices of each triangle, or nullptr to use the vertices in order.
+        /// @param IndexCount The number of indices.
+        static void DrawGeometry(Engine::Texture* Texture, const SDL_Vertex* Vertices, int VertexCount,
+            const int* Indices = nullptr, int IndexCount = 0);
 
         /// @brief Check if the Renderer is initialized successfully (notice that the Renderer will only usable
         /// if both the Renderer and Window have initialized successfully).
@@ -350,6 +413,17 @@ namespace Engine {
     public:
         /// @brief The target area of the rendering event.
         Rectangle TargetArea = Rectangle::Empty;
+        /// @brief The transform from the local space of the Game Object (where (0, 0) is the top-left corner of the
+        /// TargetArea) to the drawing area, include the PositionOffset, Rotation and Scale of the Game Object and its
+        /// parents. This is set by GameObject::RaiseRenderEvent().
+        Mat3x2f Transform = Mat3x2f::Identity();
+        /// @brief The transform from the space of the TargetArea to the drawing area, given by the parent Game Object.
+        /// Default is identity (the TargetArea is in the drawing area).
+        Mat3x2f ParentTransform = Mat3x2f::Identity();
+
+        /// @brief Get the area of the Game Object in its local space (the space of Transform).
+        /// @return The local area, at (0, 0) with the size of the TargetArea.
+        RectF GetLocalArea() const { return RectF(0.0f, 0.0f, (float)TargetArea.Width, (float)TargetArea.Height); }
     };
 }
 
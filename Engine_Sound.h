@@ -1,31 +1,418 @@
 #ifndef __ENGINE_SOUND_H__
 #define __ENGINE_SOUND_H__
 
+#define ENGINE_DEFAULT_SOUND_CHANNEL_COUNT 32
+
+#include "Engine_AudioDevice.h"
 #include "Engine_Define.h"
 
 #include <unordered_set>
+#include <unordered_map>
 #include <string>
+#include <vector>
 #include <functional>
+#include <climits>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_atomic.h>
 #include <SDL2/SDL_mixer.h>
 
 namespace Engine {
+    class SoundBus;
+    class SoundMixer;
+
+    /// @brief The Voice Steal Policy enum, specify which playing voice (channel) will be stolen when a Sound is played while
+    /// all channels are busy (or the Sound reached it maximum instances). Voices with lower priority are always stolen first.
+    enum class VoiceStealPolicy {
+        /// @brief Never steal a playing voice, the Sound will failed to play.
+        None,
+        /// @brief Steal the voice that started playing first.
+        Oldest,
+        /// @brief Steal the voice with the lowest volume (channel volume and chunk volume).
+        Quietest
+    };
+    /// @brief The Sound Conversion Quality enum, specify the resampling quality when a Sound is converted on loading.
+    enum class SoundConversionQuality {
+        /// @brief Fast, low quality resampling.
+        Fast,
+        /// @brief Medium quality resampling.
+        Medium,
+        /// @brief Slow, best quality resampling.
+        Best
+    };
+
+    /// @brief The Sound Load Options struct, specify the format that a Sound is converted to (once) on loading.
+    struct SoundLoadOptions {
+    public:
+        /// @brief The number of channels to keep (1 for mono, 2 for stereo), or 0 (default) for the Audio Device channels.
+        /// @note A Sound that not in the Audio Device channels and frequency can only be played with the Sound Mixer.
+        int Channels = 0;
+        /// @brief The frequency (sample rate) in Hz to keep, or 0 (default) for the Audio Device frequency.
+        int Frequency = 0;
+        /// @brief The resampling quality of the conversion. Only apply for WAV data, other format is decoded to the Audio
+        /// Device format by SDL_mixer first. Default is SoundConversionQuality::Medium.
+        SoundConversionQuality Quality = SoundConversionQuality::Medium;
+    };
+
+    /// @brief The Sound Memory Report struct, contain the PCM memory used by the created Sounds.
+    struct SoundMemoryReport {
+    public:
+        /// @brief The number of created Sounds.
+        size_t SoundCount = 0;
+        /// @brief The number of distinct decoded chunks (Sounds loaded from the same data share a chunk).
+        size_t ChunkCount = 0;
+        /// @brief The total size in bytes of the distinct decoded chunks.
+        size_t TotalBytes = 0;
+        /// @brief The size in bytes that saved by sharing chunks between Sounds.
+        size_t SharedBytes = 0;
+        /// @brief The size in bytes of the largest chunk.
+        size_t LargestChunkBytes = 0;
+    };
+
     /// @brief The Sound class, represent a sound object. This can be use to managing and play sound (usually for sound
     /// effect).
     class Sound {
+        friend class SoundMixer;
     private:
+        struct __voice_info {
+            Sound* sound = nullptr;
+            unsigned long long serial = 0;
+            int priority = 0;
+        };
+        struct __cached_chunk {
+            size_t ref_count = 0;
+            // The content is identified by its size and 128-bit hash (the source is not kept).
+            unsigned long long content_hash = 0, content_hash_high = 0;
+            size_t content_size = 0;
+            unsigned long long options_key = 0;
+            int channels = 0, frequency = 0;
+            std::vector<std::string> paths;
+        };
+
         Mix_Chunk* __data = nullptr;
+        int __channels = 0, __frequency = 0;
+        int __playing_instances = 0;
 
         static bool __is_destroy_all;
         static std::unordered_set<Sound*> __created_sounds;
+
+        // The channel pool state. This is shared with the audio thread (through Mix_ChannelFinished), so it must only be
+        // accessed while holding __voice_lock. Mixer functions must never be called while holding the lock.
+        static SDL_SpinLock __voice_lock;
+        static std::vector<__voice_info> __voices;
+        static std::vector<__voice_info> __voices_snapshot;
+        static std::vector<int> __free_channels;
+        static std::vector<int> __free_channel_index;
+        static unsigned long long __voice_serial;
+        static VoiceStealPolicy __steal_policy;
+
+        // The decoded chunk cache, shared between Sounds loaded from the same file path or the same content.
+        static bool __is_chunk_cache_enabled;
+        static std::unordered_map<Mix_Chunk*, __cached_chunk> __cached_chunks;
+        static std::unordered_map<std::string, Mix_Chunk*> __path_chunks;
+        static std::unordered_multimap<unsigned long long, Mix_Chunk*> __content_chunks;
+
+        /// @brief Compute the 128-bit hash of the given content, as two independent 64-bit hashes (FNV-1a and a
+        /// multiply-rotate hash).
+        /// @param high The output high 64 bits of the hash.
+        /// @return The low 64 bits of the hash (the FNV-1a hash, used as the key of the content cache).
+        static unsigned long long __hash_content(const void* data, size_t size, unsigned long long& high) {
+            const unsigned char* bytes = (const unsigned char*)data;
+            unsigned long long hash = 14695981039346656037ULL;
+            unsigned long long hash_high = 0x9E3779B97F4A7C15ULL ^ (unsigned long long)size;
+            for (size_t i = 0; i < size; i++) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ULL;
+                hash_high = (hash_high ^ bytes[i]) * 0xC2B2AE3D27D4EB4FULL;
+                hash_high = (hash_high << 31) | (hash_high >> 33);
+            }
+            high = hash_high;
+            return hash;
+        }
+        /// @brief Resolve the given load options with the Audio Device format.
+        static SoundLoadOptions __resolve_options(const SoundLoadOptions& options) {
+            SoundLoadOptions result = options;
+            if (result.Channels <= 0) result.Channels = AudioDevice::GetChannels();
+            if (result.Frequency <= 0) result.Frequency = AudioDevice::GetFrequency();
+            return result;
+        }
+        /// @brief Get the key of the given (resolved) load options, used by the chunk cache.
+        static unsigned long long __options_key(const SoundLoadOptions& options) {
+            return (unsigned long long)options.Channels | ((unsigned long long)options.Frequency << 8) |
+                ((unsigned long long)options.Quality << 40);
+        }
+        /// @brief Convert the given PCM data once to the given channels and frequency (in the Audio Device sample format).
+        /// @return The newly allocated chunk, or nullptr on failed.
+        static Mix_Chunk* __convert_chunk(const Uint8* data, Uint32 len, SDL_AudioFormat format, int channels, int frequency,
+            const SoundLoadOptions& options) {
+            static const char* const quality_hints[] = { "fast", "medium", "best" };
+            // The resampler is picked from the hint when the stream is created.
+            const char* prev_hint = SDL_GetHint(SDL_HINT_AUDIO_RESAMPLING_MODE);
+            bool has_prev_hint = prev_hint != nullptr;
+            std::string prev_value = has_prev_hint ? prev_hint : "";
+            SDL_SetHint(SDL_HINT_AUDIO_RESAMPLING_MODE, quality_hints[(int)options.Quality]);
+            SDL_AudioStream* stream = SDL_NewAudioStream(format, (Uint8)channels, frequency,
+                AudioDevice::GetFormat(), (Uint8)options.Channels, options.Frequency);
+            // An unset hint is unset again, so SDL keep using its own default (or the environment variable).
+            if (has_prev_hint) SDL_SetHint(SDL_HINT_AUDIO_RESAMPLING_MODE, prev_value.c_str());
+#if SDL_VERSION_ATLEAST(2, 24, 0)
+            else SDL_ResetHint(SDL_HINT_AUDIO_RESAMPLING_MODE);
+#else
+            else SDL_SetHint(SDL_HINT_AUDIO_RESAMPLING_MODE, nullptr);
+#endif
+            if (!stream) return nullptr;
+
+            Mix_Chunk* chunk = nullptr;
+            if (SDL_AudioStreamPut(stream, data, (int)len) == 0 && SDL_AudioStreamFlush(stream) == 0) {
+                int available = SDL_AudioStreamAvailable(stream);
+                Uint8* buffer = available > 0 ? (Uint8*)SDL_malloc((size_t)available) : nullptr;
+                if (buffer) {
+                    int converted = SDL_AudioStreamGet(stream, buffer, available);
+                    chunk = converted > 0 ? (Mix_Chunk*)SDL_malloc(sizeof(Mix_Chunk)) : nullptr;
+                    if (chunk) {
+                        // Mix_FreeChunk() free the buffer with SDL_free() since the chunk is marked as allocated.
+                        chunk->allocated = 1;
+                        chunk->abuf = buffer;
+                        chunk->alen = (Uint32)converted;
+                        chunk->volume = MIX_MAX_VOLUME;
+                    }
+                    else SDL_free(buffer);
+                }
+            }
+            SDL_FreeAudioStream(stream);
+            return chunk;
+        }
+        /// @brief Decode the given content to the given (resolved) load options.
+        /// @return The decoded chunk, or nullptr on failed.
+        static Mix_Chunk* __decode_chunk(const void* data, size_t size, const SoundLoadOptions& options) {
+            Uint16 device_format = AudioDevice::GetFormat();
+            int device_channels = AudioDevice::GetChannels(), device_frequency = AudioDevice::GetFrequency();
+
+            // WAV data is converted directly from it native format, so the quality option apply.
+            SDL_AudioSpec spec;
+            Uint8* wav_buffer = nullptr;
+            Uint32 wav_length = 0;
+            if (SDL_LoadWAV_RW(SDL_RWFromConstMem(data, (int)size), 1, &spec, &wav_buffer, &wav_length)) {
+                bool is_device_format = spec.format == device_format && spec.channels == device_channels &&
+                    spec.freq == device_frequency;
+                bool is_target_format = spec.format == device_format && spec.channels == options.Channels &&
+                    spec.freq == options.Frequency;
+                Mix_Chunk* chunk = nullptr;
+                if (!is_device_format || !is_target_format)
+                    chunk = __convert_chunk(wav_buffer, wav_length, spec.format, spec.channels, spec.freq, options);
+                SDL_FreeWAV(wav_buffer);
+                if (chunk || !is_device_format) return chunk;
+            }
+
+            Mix_Chunk* chunk = Mix_LoadWAV_RW(SDL_RWFromConstMem(data, (int)size), 1);
+            if (!chunk) return nullptr;
+            if (options.Channels == device_channels && options.Frequency == device_frequency) return chunk;
+            Mix_Chunk* converted = __convert_chunk(chunk->abuf, chunk->alen, device_format, device_channels, device_frequency, options);
+            Mix_FreeChunk(chunk);
+            return converted;
+        }
+        /// @brief Create a new Sound that share the given cached chunk.
+        static Sound* __from_cached_chunk(Mix_Chunk* chunk) {
+            __cached_chunk& entry = Sound::__cached_chunks[chunk];
+            entry.ref_count++;
+            return new Sound(chunk, entry.channels, entry.frequency);
+        }
+        /// @brief Decode the given content (with the chunk cache if enabled) and create a new Sound.
+        /// @param file_path The file path of the content, used as the path key of the cache (can be null).
+        static Sound* __from_content(const void* data, size_t size, const char* file_path, const SoundLoadOptions& load_options) {
+            if (!data || size == 0 || size > (size_t)INT_MAX) return nullptr;
+            SoundLoadOptions options = __resolve_options(load_options);
+            if (!Sound::__is_chunk_cache_enabled) {
+                Mix_Chunk* chunk = __decode_chunk(data, size, options);
+                return chunk ? new Sound(chunk, options.Channels, options.Frequency) : nullptr;
+            }
+
+            unsigned long long hash_high = 0;
+            unsigned long long hash = __hash_content(data, size, hash_high), options_key = __options_key(options);
+            std::string path_key = file_path ? (std::string(file_path) + '|' + std::to_string(options_key)) : std::string();
+            auto range = Sound::__content_chunks.equal_range(hash);
+            for (auto it = range.first; it != range.second; ++it) {
+                __cached_chunk& entry = Sound::__cached_chunks[it->second];
+                if (entry.options_key != options_key || entry.content_size != size) continue;
+                if (entry.content_hash_high != hash_high) continue;
+                if (file_path && Sound::__path_chunks.count(path_key) == 0) {
+                    Sound::__path_chunks[path_key] = it->second;
+                    entry.paths.push_back(path_key);
+                }
+                return __from_cached_chunk(it->second);
+            }
+
+            Mix_Chunk* chunk = __decode_chunk(data, size, options);
+            if (!chunk) return nullptr;
+            __cached_chunk& entry = Sound::__cached_chunks[chunk];
+            entry.content_hash = hash;
+            entry.content_hash_high = hash_high;
+            entry.content_size = size;
+            entry.options_key = options_key;
+            entry.channels = options.Channels;
+            entry.frequency = options.Frequency;
+            Sound::__content_chunks.insert(std::make_pair(hash, chunk));
+            if (file_path) {
+                Sound::__path_chunks[path_key] = chunk;
+                entry.paths.push_back(path_key);
+            }
+            return __from_cached_chunk(chunk);
+        }
+        /// @brief Release the given chunk, the chunk is freed if it's not cached or no Sound share it anymore.
+        static void __release_chunk(Mix_Chunk* chunk) {
+            if (!chunk) return;
+            auto entry_it = Sound::__cached_chunks.find(chunk);
+            if (entry_it == Sound::__cached_chunks.end()) { Mix_FreeChunk(chunk); return; }
+            if (--entry_it->second.ref_count > 0) return;
+
+            for (const std::string& path : entry_it->second.paths)
+                Sound::__path_chunks.erase(path);
+            auto range = Sound::__content_chunks.equal_range(entry_it->second.content_hash);
+            for (auto it = range.first; it != range.second; ++it)
+                if (it->second == chunk) { Sound::__content_chunks.erase(it); break; }
+            Sound::__cached_chunks.erase(entry_it);
+            Mix_FreeChunk(chunk);
+        }
+
+        /// @brief Release the given channel back to the free list (__voice_lock must be held).
+        static void __release_channel(int channel) {
+            if (channel < 0 || channel >= (int)__voices.size()) return;
+            if (__free_channel_index[channel] >= 0) return;
+            __voice_info& voice = __voices[channel];
+            if (voice.sound) voice.sound->__playing_instances--;
+            voice = __voice_info();
+            // Capacity is reserved on SetChannelCount(), so this never allocate on the audio thread.
+            __free_channel_index[channel] = (int)__free_channels.size();
+            __free_channels.push_back(channel);
+        }
+        /// @brief Remove the given free channel from the free list and assign it to the given Sound (__voice_lock must be held).
+        /// @return true on success, false if the channel is not free.
+        static bool __reserve_channel(int channel, Sound* sound) {
+            if (channel < 0 || channel >= (int)__voices.size()) return false;
+            int index = __free_channel_index[channel];
+            if (index < 0) return false;
+            int last = __free_channels.back();
+            __free_channels[index] = last;
+            __free_channel_index[last] = index;
+            __free_channels.pop_back();
+            __free_channel_index[channel] = -1;
+
+            __voice_info& voice = __voices[channel];
+            voice.sound = sound;
+            voice.serial = ++__voice_serial;
+            voice.priority = sound->Priority;
+            sound->__playing_instances++;
+            return true;
+        }
+        /// @brief Called by SDL_mixer (usually on the audio thread) when a channel finished playing or halted.
+        static void __on_channel_finished(int channel) {
+            SDL_AtomicLock(&__voice_lock);
+            __release_channel(channel);
+            SDL_AtomicUnlock(&__voice_lock);
+        }
+        /// @brief Select a playing voice to steal with the current policy.
+        /// @param only_sound If not null, only the instances of this Sound are considered.
+        /// @param max_priority The maximum priority of the voice that can be stolen (ignored if only_sound is given).
+        /// @return The channel of the voice to steal, or -1 if there's none.
+        static int __select_steal_channel(Sound* only_sound, int max_priority) {
+            if (__steal_policy == VoiceStealPolicy::None) return -1;
+            SDL_AtomicLock(&__voice_lock);
+            __voices_snapshot.assign(__voices.begin(), __voices.end());
+            SDL_AtomicUnlock(&__voice_lock);
+
+            int result = -1, best_priority = INT_MAX;
+            unsigned long long best_key = ULLONG_MAX;
+            for (int channel = 0; channel < (int)__voices_snapshot.size(); channel++) {
+                const __voice_info& voice = __voices_snapshot[channel];
+                if (!voice.sound) continue;
+                if (only_sound ? (voice.sound != only_sound) : (voice.priority > max_priority)) continue;
+
+                unsigned long long key = voice.serial;
+                if (__steal_policy == VoiceStealPolicy::Quietest)
+                    key = (unsigned long long)Mix_Volume(channel, -1) * (unsigned long long)Mix_VolumeChunk(voice.sound->__data, -1);
+                if (voice.priority < best_priority || (voice.priority == best_priority && key < best_key)) {
+                    result = channel; best_priority = voice.priority; best_key = key;
+                }
+            }
+            return result;
+        }
+        /// @brief Halt the given channel (if playing), then reserve it for the given Sound.
+        /// @return true on success, false otherwise.
+        static bool __take_channel(int channel, Sound* sound) {
+            Mix_HaltChannel(channel);
+            SDL_AtomicLock(&__voice_lock);
+            bool result = __reserve_channel(channel, sound);
+            SDL_AtomicUnlock(&__voice_lock);
+            return result;
+        }
+        /// @brief Acquire a channel from the channel pool to play the given Sound, stealing a voice if needed.
+        /// @return The acquired channel, or -1 if there's none.
+        static int __acquire_channel(Sound* sound) {
+            SDL_AtomicLock(&__voice_lock);
+            bool reached_limit = sound->MaxInstances > 0 && sound->__playing_instances >= sound->MaxInstances;
+            int channel = (!reached_limit && !__free_channels.empty()) ? __free_channels.back() : -1;
+            if (channel >= 0) __reserve_channel(channel, sound);
+            SDL_AtomicUnlock(&__voice_lock);
+            if (channel >= 0) return channel;
+
+            channel = __select_steal_channel(reached_limit ? sound : nullptr, sound->Priority);
+            if (channel < 0) return -1;
+            return __take_channel(channel, sound) ? channel : -1;
+        }
+        /// @brief Play the given Sound on the channel pool (or on the given channel).
+        static int __play(Sound* sound, int channel, int loop_count, int ms, int fade_in_ms) {
+            if (!sound) return -1;
+            if (!sound->__data) return -1;
+            if (!sound->IsDeviceFormat()) return -1;
+
+            bool managed = !__voices.empty();
+            if (managed) {
+                if (channel < 0)
+                    channel = __acquire_channel(sound);
+                else if (!__take_channel(channel, sound))
+                    channel = -1;
+                if (channel < 0) return -1;
+                // The channel is halted (or free) here, so the capture effect is registered before any sample is mixed.
+                if (Sound::__route_channel) Sound::__route_channel(channel, sound);
+            }
+
+            int result = (fade_in_ms < 0) ?
+                Mix_PlayChannelTimed(channel, sound->__data, loop_count, ms) :
+                Mix_FadeInChannelTimed(channel, sound->__data, loop_count, fade_in_ms, ms);
+            if (result < 0 && managed) {
+                SDL_AtomicLock(&__voice_lock);
+                __release_channel(channel);
+                SDL_AtomicUnlock(&__voice_lock);
+            }
+            return result;
+        }
+        // Stop all voices of the Sound Mixer that playing the given Sound, set by SoundMixer::Initialize() (null if the
+        // Sound Mixer is not used, so this header doesn't depend on it).
+        static void (*__release_mixer_voices)(Sound*);
+        // Route the given channel of the channel pool into the Sound Bus of the given Sound, set by SoundMixer::Initialize().
+        static void (*__route_channel)(int, Sound*);
     protected:
-        Sound(Mix_Chunk* chunk) : __data(chunk) { Sound::__created_sounds.insert(this); }
+        Sound(Mix_Chunk* chunk) : Sound(chunk, AudioDevice::GetChannels(), AudioDevice::GetFrequency()) {}
+        Sound(Mix_Chunk* chunk, int channels, int frequency) : __data(chunk), __channels(channels), __frequency(frequency) {
+            Sound::__created_sounds.insert(this);
+        }
     public:
         /// @brief The name of the Sound object. Default is "Sound".
         std::string Name = "Sound";
+        /// @brief The priority of the Sound on the channel pool. A playing voice can only be stolen by a Sound with the
+        /// same or higher priority. Default is 0.
+        int Priority = 0;
+        /// @brief The maximum number of instances of the Sound that can be played at the same time, or 0 (default) for no
+        /// limit. When reached, an instance of the Sound is stolen with the current VoiceStealPolicy.
+        int MaxInstances = 0;
+        /// @brief The Sound Bus that the channels playing the Sound are mixed into, or nullptr (default) for the master bus.
+        /// This is only used while the Sound Mixer is initialized, and is applied when the Sound is played.
+        SoundBus* Bus = nullptr;
 
         virtual ~Sound() {
-            if (__data)
-                Mix_FreeChunk(__data);
+            // Mix_FreeChunk() stop the channels without calling Mix_ChannelFinished, so release them first.
+            HaltAllInstances();
+            if (Sound::__release_mixer_voices) Sound::__release_mixer_voices(this);
+            __release_chunk(__data);
             __data = nullptr;
             if (!Sound::__is_destroy_all)
                 Sound::__created_sounds.erase(this);
@@ -38,18 +425,102 @@ namespace Engine {
         /// @return true if the data is avaliable, false otherwise.
         bool IsAvaliable() const { return (bool)__data; }
 
+        /// @brief Get the number of channels of the Sound data.
+        /// @return The number of channels (1 for mono, 2 for stereo).
+        int GetChannels() const { return __channels; }
+        /// @brief Get the frequency (sample rate) of the Sound data.
+        /// @return The frequency in Hz.
+        int GetFrequency() const { return __frequency; }
+        /// @brief Check if the Sound data is in the Audio Device format. Sound that not in the Audio Device format can only be
+        /// played with the Sound Mixer.
+        /// @return true if the Sound data is in the Audio Device format, false otherwise.
+        bool IsDeviceFormat() const {
+            return __channels == AudioDevice::GetChannels() && __frequency == AudioDevice::GetFrequency();
+        }
+        /// @brief Get the size in bytes of the PCM data of the Sound (the data may be shared with other Sounds).
+        /// @return The size in bytes of the Sound data, or 0 if the data is not avaliable.
+        size_t GetDataSize() const { return __data ? (size_t)__data->alen : 0; }
+        /// @brief Get the duration of the Sound.
+        /// @return The duration in seconds, or 0 if the data is not avaliable.
+        double GetDuration() const {
+            int frame_size = __channels * (SDL_AUDIO_BITSIZE(AudioDevice::GetFormat()) / 8);
+            if (!__data || frame_size <= 0 || __frequency <= 0) return 0;
+            return (double)(__data->alen / frame_size) / (double)__frequency;
+        }
+
+        /// @brief Get the number of instances of the Sound that currently playing on the channel pool.
+        /// @return The number of playing instances of the Sound.
+        int GetPlayingInstances() const {
+            SDL_AtomicLock(&Sound::__voice_lock);
+            int result = __playing_instances;
+            SDL_AtomicUnlock(&Sound::__voice_lock);
+            return result;
+        }
+        /// @brief Halt all instances of the Sound that currently playing on the channel pool.
+        void HaltAllInstances() {
+            if (GetPlayingInstances() <= 0) return;
+            SDL_AtomicLock(&Sound::__voice_lock);
+            Sound::__voices_snapshot.assign(Sound::__voices.begin(), Sound::__voices.end());
+            SDL_AtomicUnlock(&Sound::__voice_lock);
+            for (int channel = 0; channel < (int)Sound::__voices_snapshot.size(); channel++)
+                if (Sound::__voices_snapshot[channel].sound == this)
+                    Mix_HaltChannel(channel);
+        }
+
+        /// @brief Set the number of channels (voices) of the channel pool that the Sounds is played on. This will halt all
+        /// playing channels. This is called with ENGINE_DEFAULT_SOUND_CHANNEL_COUNT on Engine::Initialize().
+        /// @param count The number of channels to set, will be clamped to be at least 0.
+        /// @return The number of allocated channels.
+        static int SetChannelCount(int count) {
+            Mix_ChannelFinished(&Sound::__on_channel_finished);
+            Mix_HaltChannel(-1);
+            count = Mix_AllocateChannels(count < 0 ? 0 : count);
+
+            SDL_AtomicLock(&Sound::__voice_lock);
+            for (Sound* sound : Sound::__created_sounds)
+                if (sound) sound->__playing_instances = 0;
+            Sound::__voices.assign(count, __voice_info());
+            Sound::__voices_snapshot.reserve(count);
+            Sound::__free_channels.clear();
+            Sound::__free_channels.reserve(count);
+            Sound::__free_channel_index.assign(count, -1);
+            // Push in reverse, so the lowest channel is used first.
+            for (int channel = count - 1; channel >= 0; channel--) {
+                Sound::__free_channel_index[channel] = (int)Sound::__free_channels.size();
+                Sound::__free_channels.push_back(channel);
+            }
+            SDL_AtomicUnlock(&Sound::__voice_lock);
+            return count;
+        }
+        /// @brief Get the number of channels (voices) of the channel pool.
+        /// @return The number of channels of the channel pool.
+        static int GetChannelCount() { return (int)Sound::__voices.size(); }
+        /// @brief Get the number of free (not playing) channels of the channel pool.
+        /// @return The number of free channels of the channel pool.
+        static int GetFreeChannelCount() {
+            SDL_AtomicLock(&Sound::__voice_lock);
+            int result = (int)Sound::__free_channels.size();
+            SDL_AtomicUnlock(&Sound::__voice_lock);
+            return result;
+        }
+        /// @brief Get the policy that used to steal a playing voice when there's no free channel.
+        /// @return The current Voice Steal Policy. Default is VoiceStealPolicy::Oldest.
+        static VoiceStealPolicy GetVoiceStealPolicy() { return Sound::__steal_policy; }
+        /// @brief Set the policy that used to steal a playing voice when there's no free channel.
+        /// @param policy The Voice Steal Policy to set.
+        static void SetVoiceStealPolicy(VoiceStealPolicy policy) { Sound::__steal_policy = policy; }
+
 
         /// @brief Play the given sound on a channel.
         /// @param sound The Sound to play.
         /// @param ms The number of milliseconds to play the sound (default is -1 mean play until stopped).
         /// @param loop_count The number of loop to play (default is 0 mean not looping), or -1 to loop (not actually)
         /// infinitely.
-        /// @param channel The channel to play. If -1 (default), will play on the first free channel.
-        /// @return The channel that the sound is play, or -1 on failed.
+        /// @param channel The channel to play. If -1 (default), will play on a free channel of the channel pool (or steal a
+        /// playing voice with the current VoiceStealPolicy).
+        /// @return The channel that the sound is play, or -1 on failed (or the Sound is not in the Audio Device format).
         static int PlaySound(Sound* sound, int ms = -1, int loop_count = 0, int channel = -1) {
-            if (!sound) return -1;
-            if (!sound->__data) return -1;
-            return Mix_PlayChannelTimed(channel, sound->__data, loop_count, ms);
+            return __play(sound, channel, loop_count, ms, -1);
         }
         /// @brief Play the given sound on a channel, with fade in.
         /// @param sound The Sound to play.
@@ -57,12 +528,11 @@ namespace Engine {
         /// @param ms The number of milliseconds to play the sound (default is -1 mean play until stopped).
         /// @param loop_count The number of loop to play (default is 0 mean not looping), or -1 to loop (not actually)
         /// infinitely.
-        /// @param channel The channel to play. If -1 (default), will play on the first free channel.
-        /// @return The channel that the sound is play, or -1 on failed.
+        /// @param channel The channel to play. If -1 (default), will play on a free channel of the channel pool (or steal a
+        /// playing voice with the current VoiceStealPolicy).
+        /// @return The channel that the sound is play, or -1 on failed (or the Sound is not in the Audio Device format).
         static int FadeInSound(Sound* sound, int face_in_ms, int ms = -1, int loop_count = 0, int channel = -1) {
-            if (!sound) return -1;
-            if (!sound->__data) return -1;
-            return Mix_FadeInChannelTimed(channel, sound->__data, loop_count, face_in_ms, ms);
+            return __play(sound, channel, loop_count, ms, face_in_ms < 0 ? 0 : face_in_ms);
         }
 
         /// @brief Halt the given channel after the given amount of time, with fade out.
@@ -93,15 +563,77 @@ namespace Engine {
         /// @param ms The amount of time in milliseconds to set, or -1 to disable.
         static void SetChannelExpire(int channel, int ms) { Mix_ExpireChannel(channel, ms); }
 
-        /// @brief Load a Sound from a file.
+        /// @brief Load a Sound from a file. If the chunk cache is enabled, Sounds loaded from the same file path (or with the
+        /// same content) and the same load options share the same decoded data.
         /// @param file_path The file path of the sound file to load.
+        /// @param options The load options, the Sound is converted once on loading. Default is the Audio Device format.
+        /// @return The newly created Sound, or nullptr on failed.
+        static Sound* FromFile(const char* file_path, const SoundLoadOptions& options = SoundLoadOptions()) {
+            if (!file_path) return nullptr;
+            if (Sound::__is_chunk_cache_enabled) {
+                SoundLoadOptions resolved = __resolve_options(options);
+                auto it = Sound::__path_chunks.find(std::string(file_path) + '|' + std::to_string(__options_key(resolved)));
+                if (it != Sound::__path_chunks.end())
+                    return __from_cached_chunk(it->second);
+            }
+
+            size_t size = 0;
+            void* data = SDL_LoadFile(file_path, &size);
+            if (!data) return nullptr;
+            Sound* result = __from_content(data, size, file_path, options);
+            SDL_free(data);
+            return result;
+        }
+        /// @brief Load a Sound from an encoded sound file in memory, the memory is read in place (not copied). If the chunk
+        /// cache is enabled, Sounds loaded with the same content and the same load options share the same decoded data.
+        /// @param data The memory that contain the sound file. This is only read while loading, so can be freed after.
+        /// @param size The size of the memory in bytes.
+        /// @param options The load options, the Sound is converted once on loading. Default is the Audio Device format.
+        /// @return The newly created Sound, or nullptr on failed.
+        static Sound* FromMemory(const void* data, size_t size, const SoundLoadOptions& options = SoundLoadOptions()) {
+            return __from_content(data, size, nullptr, options);
+        }
+        /// @brief Load a Sound from the given SDL_RWops. The Sound loaded with this is never cached.
+        /// @param rw The SDL_RWops to load.
+        /// @param free_rw If true, the SDL_RWops will be closed after loading (even on failed). Default is false.
         /// @return The newly created Sound, or nullptr on failed.
-        static Sound* FromFile(const char* file_path) { return FromMixChunk(Mix_LoadWAV(file_path)); }
-        /// @brief Create a new Sound from the given Mix_Chunk.
+        static Sound* FromRWops(SDL_RWops* rw, bool free_rw = false) {
+            if (!rw) return nullptr;
+            return FromMixChunk(Mix_LoadWAV_RW(rw, free_rw ? 1 : 0));
+        }
+        /// @brief Create a new Sound from the given Mix_Chunk. The Sound will take the ownership of the Mix_Chunk.
         /// @param chunk The Mix_Chunk to create.
         /// @return The newly created Sound, or nullptr if the given Mix_Chunk is null.
         static Sound* FromMixChunk(Mix_Chunk* chunk) { return chunk ? new Sound(chunk) : nullptr; }
 
+        /// @brief Check if the chunk cache is enabled.
+        /// @return true if the chunk cache is enabled (default), false otherwise.
+        static bool IsChunkCacheEnabled() { return Sound::__is_chunk_cache_enabled; }
+        /// @brief Enable or disable the chunk cache for the next loaded Sounds. The already cached chunks are kept until the
+        /// Sounds that share them are destroyed.
+        /// @param enabled true to enable the chunk cache, false to disable.
+        static void SetChunkCacheEnabled(bool enabled) { Sound::__is_chunk_cache_enabled = enabled; }
+        /// @brief Get the number of decoded chunks that currently in the chunk cache.
+        /// @return The number of cached chunks.
+        static size_t GetCachedChunkCount() { return Sound::__cached_chunks.size(); }
+        /// @brief Get the report of the PCM memory used by all created Sounds.
+        /// @return The memory report.
+        static SoundMemoryReport GetMemoryReport() {
+            SoundMemoryReport report;
+            std::unordered_set<Mix_Chunk*> chunks;
+            for (Sound* sound : Sound::__created_sounds) {
+                if (!sound) continue;
+                report.SoundCount++;
+                size_t bytes = sound->GetDataSize();
+                if (!sound->__data) continue;
+                if (!chunks.insert(sound->__data).second) { report.SharedBytes += bytes; continue; }
+                report.TotalBytes += bytes;
+                report.LargestChunkBytes = ENGINE_MAX(report.LargestChunkBytes, bytes);
+            }
+            report.ChunkCount = chunks.size();
+            return report;
+        }
+
         /// @brief Execute an action for each created Sound.
         /// @param action The action to execute.
         /// @return The number of Sound that called with the given action.
@@ -214,6 +746,24 @@ namespace Engine {
         /// @param file_path The file path of the sound file to load.
         /// @return The newly created Music, or nullptr on failed.
         static Music* FromFile(const char* file_path) { return FromMixChunk(Mix_LoadMUS(file_path)); }
+        /// @brief Load a Music from an encoded music file in memory. The Music is decoded while playing, so the memory is
+        /// read in place (not copied) and must be kept alive until the Music is destroyed.
+        /// @param data The memory that contain the music file (caller-owned, can be a memory mapped file).
+        /// @param size The size of the memory in bytes.
+        /// @return The newly created Music, or nullptr on failed.
+        static Music* FromMemory(const void* data, size_t size) {
+            if (!data || size == 0 || size > (size_t)INT_MAX) return nullptr;
+            return FromMixChunk(Mix_LoadMUS_RW(SDL_RWFromConstMem(data, (int)size), 1));
+        }
+        /// @brief Load a Music from the given SDL_RWops. The Music is decoded while playing, so the SDL_RWops must be kept
+        /// alive until the Music is destroyed.
+        /// @param rw The SDL_RWops to load.
+        /// @param free_rw If true (default), the SDL_RWops will be closed when the Music is destroyed (or on failed).
+        /// @return The newly created Music, or nullptr on failed.
+        static Music* FromRWops(SDL_RWops* rw, bool free_rw = true) {
+            if (!rw) return nullptr;
+            return FromMixChunk(Mix_LoadMUS_RW(rw, free_rw ? 1 : 0));
+        }
         /// @brief Create a new Music from the given Mix_Music.
         /// @param chunk The Mix_Music to create.
         /// @return The newly created Music, or nullptr if the given Mix_Music is null.
@@ -282,6 +832,19 @@ namespace Engine {
 
 bool Engine::Sound::__is_destroy_all = false;
 std::unordered_set<Engine::Sound*> Engine::Sound::__created_sounds = std::unordered_set<Engine::Sound*>();
+SDL_SpinLock Engine::Sound::__voice_lock = 0;
+std::vector<Engine::Sound::__voice_info> Engine::Sound::__voices = std::vector<Engine::Sound::__voice_info>();
+std::vector<Engine::Sound::__voice_info> Engine::Sound::__voices_snapshot = std::vector<Engine::Sound::__voice_info>();
+std::vector<int> Engine::Sound::__free_channels = std::vector<int>();
+std::vector<int> Engine::Sound::__free_channel_index = std::vector<int>();
+unsigned long long Engine::Sound::__voice_serial = 0;
+Engine::VoiceStealPolicy Engine::Sound::__steal_policy = Engine::VoiceStealPolicy::Oldest;
+bool Engine::Sound::__is_chunk_cache_enabled = true;
+void (*Engine::Sound::__release_mixer_voices)(Engine::Sound*) = nullptr;
+void (*Engine::Sound::__route_channel)(int, Engine::Sound*) = nullptr;
+std::unordered_map<Mix_Chunk*, Engine::Sound::__cached_chunk> Engine::Sound::__cached_chunks = std::unordered_map<Mix_Chunk*, Engine::Sound::__cached_chunk>();
+std::unordered_map<std::string, Mix_Chunk*> Engine::Sound::__path_chunks = std::unordered_map<std::string, Mix_Chunk*>();
+std::unordered_multimap<unsigned long long, Mix_Chunk*> Engine::Sound::__content_chunks = std::unordered_multimap<unsigned long long, Mix_Chunk*>();
 
 bool Engine::Music::__is_destroy_all = false;
 std::unordered_set<Engine::Music*> Engine::Music::__created_musics = std::unordered_set<Engine::Music*>();
@@ -0,0 +1,996 @@
+#ifndef __ENGINE_SOUNDMIXER_H__
+#define __ENGINE_SOUNDMIXER_H__
+
+#define ENGINE_SOUND_MIXER_MAX_VOICES 256
+#define ENGINE_SOUND_MIXER_BLOCK_FRAMES 256
+#define ENGINE_SOUND_MIXER_MAX_BUSES 16
+#define ENGINE_SOUND_MIXER_MAX_SOURCES 8
+#define ENGINE_SOUND_MIXER_MAX_CHANNELS 64
+
+#if defined(__AVX2__)
+#define ENGINE_SOUND_MIXER_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENGINE_SOUND_MIXER_SSE2
+#endif
+
+#include "Engine_AudioDevice.h"
+#include "Engine_GameObject.h"
+#include "Engine_Sound.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <SDL2/SDL_mixer.h>
+
+#if defined(ENGINE_SOUND_MIXER_AVX2)
+#include <immintrin.h>
+#elif defined(ENGINE_SOUND_MIXER_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace Engine {
+    /// @brief The Sound Mixer Source callback type, called on the audio thread to accumulate stereo frames into the mix
+    /// buffer of a Sound Bus. The samples are in the Audio Device sample unit (e.g. -32768 to 32767 for AUDIO_S16SYS).
+    /// @param buffer The interleaved stereo mix buffer to accumulate into.
+    /// @param frames The number of frames to mix.
+    typedef void (*SoundMixerSource)(float* buffer, int frames);
+
+    /// @brief The Sound Bus Parameters struct, contain the parameters of a Sound Bus.
+    struct SoundBusParameters {
+    public:
+        /// @brief The gain of the Sound Bus. Default is 1.
+        float Gain = 1.0f;
+        /// @brief If this true, the Sound Bus output is silent. Default is false.
+        bool Muted = false;
+        /// @brief The cutoff frequency in Hz of the low-pass filter, or 0 (default) to disable the low-pass filter.
+        float LowPassCutoff = 0.0f;
+        /// @brief The wet/dry mix of the reverb, from 0 (default, reverb disabled) to 1 (fully wet).
+        float ReverbMix = 0.0f;
+        /// @brief The room size of the reverb, from 0 to 1 (longer tail). Default is 0.5.
+        float ReverbRoomSize = 0.5f;
+        /// @brief The damping of the reverb, from 0 to 1 (darker tail). Default is 0.5.
+        float ReverbDamping = 0.5f;
+    };
+
+    /// @brief The Sound Bus class, represent a bus (submix) of the Sound Mixer. Voices, sources and the channels of the Sound
+    /// channel pool (see Sound::Bus) are mixed into a Sound Bus, then each Sound Bus apply it low-pass, reverb and gain before
+    /// mixed into it parent bus, and the master bus into the output.
+    /// Sound Buses are created with SoundMixer::CreateBus(), and the parameters are published to the audio thread without
+    /// locking.
+    class SoundBus {
+        friend class SoundMixer;
+    private:
+        struct __parameters {
+            SoundBusParameters user;
+            float gain = 1.0f;
+            float lowpass_alpha = 0.0f;
+            float comb_feedback = 0.0f, comb_damping = 0.0f;
+        };
+        struct __delay_line {
+            std::vector<float> buffer;
+            size_t index = 0;
+            float filter = 0.0f;
+        };
+
+        std::string __name;
+        int __index = 0;
+        SoundBusParameters __params;
+        std::atomic<int> __parent_index{-1};
+
+        // Triple buffered parameter blocks: the main thread write __blocks[__write_block] and swap it with the middle one,
+        // the audio thread swap the middle one with __blocks[__read_block] when it's dirty.
+        __parameters __blocks[3];
+        int __write_block = 0, __read_block = 1;
+        std::atomic<int> __middle_block{2};
+
+        // Audio thread only.
+        float __applied_gain = 0.0f;
+        float __lowpass_state[2] = { 0.0f, 0.0f };
+        __delay_line __combs[2][4], __allpasses[2][2];
+        alignas(32) float __buffer[ENGINE_SOUND_MIXER_BLOCK_FRAMES * 2];
+        // The output of the routed channels captured in the current audio callback, and the number of frames written.
+        std::vector<float> __channel_buffer;
+        int __channel_frames = 0;
+
+        SoundBus(const std::string& name, int index, int parent_index, int frequency) : __name(name), __index(index) {
+            __parent_index.store(parent_index, std::memory_order_relaxed);
+            // Freeverb delay lengths (at 44100 Hz), the right channel is spread by 23 samples.
+            static const int comb_lengths[4] = { 1116, 1188, 1277, 1356 };
+            static const int allpass_lengths[2] = { 556, 441 };
+            double scale = (double)frequency / 44100.0;
+            for (int channel = 0; channel < 2; channel++) {
+                for (int i = 0; i < 4; i++)
+                    __combs[channel][i].buffer.assign((size_t)((comb_lengths[i] + channel * 23) * scale) + 1, 0.0f);
+                for (int i = 0; i < 2; i++)
+                    __allpasses[channel][i].buffer.assign((size_t)((allpass_lengths[i] + channel * 23) * scale) + 1, 0.0f);
+            }
+            __channel_buffer.assign((size_t)AudioDevice::GetBufferSize() * 2, 0.0f);
+            __publish(SoundBusParameters(), frequency);
+            __swap_read_block();
+            // Start at the published gain, so the first block doesn't fade in from silence.
+            __applied_gain = __blocks[__read_block].gain;
+        }
+
+        /// @brief Compute the derived coefficients of the given parameters and publish them to the audio thread (main thread).
+        void __publish(const SoundBusParameters& params, int frequency) {
+            __params = params;
+            __parameters& block = __blocks[__write_block];
+            block.user = params;
+            block.gain = params.Muted ? 0.0f : ENGINE_MAX(0.0f, params.Gain);
+            bool has_lowpass = params.LowPassCutoff > 0.0f && params.LowPassCutoff < frequency * 0.5f;
+            block.lowpass_alpha = has_lowpass ? (float)(1.0 - std::exp(-2.0 * 3.14159265358979323846 * params.LowPassCutoff / frequency)) : 0.0f;
+            block.comb_feedback = 0.7f + 0.28f * ENGINE_FAST_CLAMP(0.0f, 1.0f, params.ReverbRoomSize);
+            block.comb_damping = 0.4f * ENGINE_FAST_CLAMP(0.0f, 1.0f, params.ReverbDamping);
+            block.user.ReverbMix = ENGINE_FAST_CLAMP(0.0f, 1.0f, params.ReverbMix);
+            __write_block = __middle_block.exchange(__write_block | 4, std::memory_order_acq_rel) & 3;
+        }
+        /// @brief Take the latest published parameters if any (audio thread).
+        void __swap_read_block() {
+            if ((__middle_block.load(std::memory_order_relaxed) & 4) == 0) return;
+            __read_block = __middle_block.exchange(__read_block, std::memory_order_acq_rel) & 3;
+        }
+        /// @brief Process a single sample through a comb filter of the reverb.
+        static float __process_comb(__delay_line& line, float input, float feedback, float damping) {
+            float output = line.buffer[line.index];
+            line.filter = output * (1.0f - damping) + line.filter * damping;
+            line.buffer[line.index] = input + line.filter * feedback;
+            if (++line.index >= line.buffer.size()) line.index = 0;
+            return output;
+        }
+        /// @brief Process a single sample through an allpass filter of the reverb.
+        static float __process_allpass(__delay_line& line, float input) {
+            float delayed = line.buffer[line.index];
+            line.buffer[line.index] = input + delayed * 0.5f;
+            if (++line.index >= line.buffer.size()) line.index = 0;
+            return delayed - input;
+        }
+        /// @brief Apply the low-pass filter and the reverb to the buffer of the Sound Bus (audio thread).
+        void __process(int frames) {
+            const __parameters& params = __blocks[__read_block];
+            if (params.lowpass_alpha > 0.0f) {
+                float alpha = params.lowpass_alpha;
+                float left = __lowpass_state[0], right = __lowpass_state[1];
+                for (int i = 0; i < frames; i++) {
+                    left += alpha * (__buffer[i * 2] - left);
+                    right += alpha * (__buffer[i * 2 + 1] - right);
+                    __buffer[i * 2] = left; __buffer[i * 2 + 1] = right;
+                }
+                __lowpass_state[0] = left; __lowpass_state[1] = right;
+            }
+            float wet = params.user.ReverbMix;
+            if (wet > 0.0f) {
+                float dry = 1.0f - wet;
+                for (int i = 0; i < frames; i++) {
+                    float input = (__buffer[i * 2] + __buffer[i * 2 + 1]) * 0.015f;
+                    for (int channel = 0; channel < 2; channel++) {
+                        float output = 0.0f;
+                        for (__delay_line& comb : __combs[channel])
+                            output += __process_comb(comb, input, params.comb_feedback, params.comb_damping);
+                        for (__delay_line& allpass : __allpasses[channel])
+                            output = __process_allpass(allpass, output);
+                        __buffer[i * 2 + channel] = __buffer[i * 2 + channel] * dry + output * wet * 3.0f;
+                    }
+                }
+            }
+        }
+    public:
+        ENGINE_NOT_COPYABLE(SoundBus)
+        ENGINE_NOT_ASSIGNABLE(SoundBus)
+
+        /// @brief Get the name of the Sound Bus.
+        /// @return The name of the Sound Bus.
+        const std::string& GetName() const { return __name; }
+        /// @brief Get the parameters of the Sound Bus (the last set ones).
+        /// @return The parameters of the Sound Bus.
+        SoundBusParameters GetParameters() const { return __params; }
+        /// @brief Set the parameters of the Sound Bus, they are applied on the next audio block.
+        /// @param params The parameters to set.
+        void SetParameters(const SoundBusParameters& params) { __publish(params, AudioDevice::GetFrequency()); }
+
+        /// @brief Set the gain of the Sound Bus.
+        /// @param gain The gain to set, will be clamped to be at least 0.
+        void SetGain(float gain) { SoundBusParameters params = GetParameters(); params.Gain = gain; SetParameters(params); }
+        /// @brief Mute or unmute the Sound Bus.
+        /// @param muted true to mute, false to unmute.
+        void SetMuted(bool muted) { SoundBusParameters params = GetParameters(); params.Muted = muted; SetParameters(params); }
+        /// @brief Set the cutoff frequency of the low-pass filter of the Sound Bus.
+        /// @param cutoff The cutoff frequency in Hz, or 0 to disable the low-pass filter.
+        void SetLowPass(float cutoff) { SoundBusParameters params = GetParameters(); params.LowPassCutoff = cutoff; SetParameters(params); }
+        /// @brief Set the reverb of the Sound Bus.
+        /// @param mix The wet/dry mix, from 0 (reverb disabled) to 1.
+        /// @param room_size The room size, from 0 to 1. Default is 0.5.
+        /// @param damping The damping, from 0 to 1. Default is 0.5.
+        void SetReverb(float mix, float room_size = 0.5f, float damping = 0.5f) {
+            SoundBusParameters params = GetParameters();
+            params.ReverbMix = mix; params.ReverbRoomSize = room_size; params.ReverbDamping = damping;
+            SetParameters(params);
+        }
+    };
+
+    /// @brief The Sound Mixer class, provide an engine-side software mixer with 2D positional audio. The voices of the Sound
+    /// Mixer are mixed (vectorized) on the audio thread as a post mix handler of the Audio Device, on top of the SDL_mixer
+    /// music.
+    /// The Sounds played on the channel pool (Sound::PlaySound() and the like) are captured with a channel effect and mixed
+    /// into the Sound Bus of the Sound, so the buses also group, mute and duck them. Only the first
+    /// ENGINE_SOUND_MIXER_MAX_CHANNELS channels are routed, the other channels, the Sounds played on the channels directly
+    /// with SDL_mixer and the SDL_mixer music bypass the buses. Channel effects registered with Mix_RegisterEffect() after a
+    /// Sound is played run after the capture, so they only receive silence.
+    /// The Sound Mixer require a stereo audio device with AUDIO_S16SYS or AUDIO_F32SYS format.
+    /// @note All the functions of the Sound Mixer must be called on the main thread. The voice parameters are published to the
+    /// audio thread without locking.
+    class SoundMixer final {
+        friend class MusicPlaylist;
+    private:
+        enum class __voice_state : int { Free, Playing, Stopping };
+
+        struct __voice {
+            // Owned by the main thread while the voice is Free, then published to the audio thread on Playing.
+            std::atomic<int> state{(int)__voice_state::Free};
+            const uint8_t* samples = nullptr;
+            uint32_t frame_count = 0;
+            uint32_t position = 0, fraction = 0;
+            int loops_left = 0;
+            // Sound that not in the Audio Device format is resampled (and upmixed) while mixing.
+            bool is_device_format = true;
+            int source_channels = 2;
+            unsigned long long step = 0;
+
+            // Written by the main thread at any time, read by the audio thread.
+            std::atomic<float> target_left{0.0f}, target_right{0.0f};
+            std::atomic<int> bus{0};
+
+            // Audio thread only.
+            float applied_left = 0.0f, applied_right = 0.0f;
+
+            // Main thread only.
+            Sound* sound = nullptr;
+            int generation = 0;
+            float gain = 1.0f, pan = 0.0f;
+            bool positional = false;
+            Point emitter_position = Point::Zero;
+        };
+
+        static bool __is_initialized;
+        static SDL_AudioFormat __format;
+        static int __frame_size;
+        static int __next_voice;
+        static __voice __voices[ENGINE_SOUND_MIXER_MAX_VOICES];
+        static std::atomic<SoundBus*> __buses[ENGINE_SOUND_MIXER_MAX_BUSES];
+        static std::atomic<SoundMixerSource> __sources[ENGINE_SOUND_MIXER_MAX_SOURCES];
+        static std::atomic<int> __source_buses[ENGINE_SOUND_MIXER_MAX_SOURCES];
+        static std::atomic<int> __channel_buses[ENGINE_SOUND_MIXER_MAX_CHANNELS];
+        // The number of frames captured from each channel in the current audio callback (audio thread only).
+        static int __channel_positions[ENGINE_SOUND_MIXER_MAX_CHANNELS];
+
+        static Point __listener_position;
+        static float __min_distance, __max_distance, __pan_distance;
+
+        /// @brief Compute the gains of the given voice from it parameters and publish them to the audio thread.
+        static void __update_voice(__voice& voice) {
+            float gain = voice.gain;
+            float pan = voice.pan;
+            if (voice.positional) {
+                float dx = (float)(voice.emitter_position.X - SoundMixer::__listener_position.X);
+                float dy = (float)(voice.emitter_position.Y - SoundMixer::__listener_position.Y);
+                float distance = std::sqrt(dx * dx + dy * dy);
+                float range = SoundMixer::__max_distance - SoundMixer::__min_distance;
+                float attenuation = (range <= 0.0f) ? (distance <= SoundMixer::__min_distance ? 1.0f : 0.0f) :
+                    1.0f - (distance - SoundMixer::__min_distance) / range;
+                gain *= ENGINE_FAST_CLAMP(0.0f, 1.0f, attenuation);
+                pan = (SoundMixer::__pan_distance > 0.0f) ? dx / SoundMixer::__pan_distance : 0.0f;
+            }
+            pan = ENGINE_FAST_CLAMP(-1.0f, 1.0f, pan);
+
+            // Balance pan law: unity gain on center, the opposite side fade out linearly.
+            voice.target_left.store(gain * ENGINE_MIN(1.0f, 1.0f - pan), std::memory_order_relaxed);
+            voice.target_right.store(gain * ENGINE_MIN(1.0f, 1.0f + pan), std::memory_order_relaxed);
+        }
+        /// @brief Get the voice with the given voice ID.
+        /// @return The voice, or nullptr if the voice ID is invalid or the voice is not playing anymore.
+        static __voice* __get_voice(int voice_id) {
+            if (voice_id < 0) return nullptr;
+            __voice& voice = SoundMixer::__voices[voice_id % ENGINE_SOUND_MIXER_MAX_VOICES];
+            if (voice.generation != voice_id / ENGINE_SOUND_MIXER_MAX_VOICES) return nullptr;
+            if (voice.state.load(std::memory_order_acquire) != (int)__voice_state::Playing) return nullptr;
+            return &voice;
+        }
+        /// @brief Start a new voice for the given Sound.
+        /// @return The voice ID, or -1 on failed.
+        static int __start(Sound* sound, int loop_count, float gain, bool positional, const Point& position, SoundBus* bus) {
+            if (!SoundMixer::__is_initialized) return -1;
+            if (!sound) return -1;
+            if (!sound->__data) return -1;
+            if (sound->GetChannels() <= 0 || sound->GetFrequency() <= 0) return -1;
+            uint32_t source_frame_size = (uint32_t)(sound->GetChannels() * (SDL_AUDIO_BITSIZE(SoundMixer::__format) / 8));
+            uint32_t frame_count = sound->__data->alen / source_frame_size;
+            if (frame_count == 0) return -1;
+
+            for (int n = 0; n < ENGINE_SOUND_MIXER_MAX_VOICES; n++) {
+                int slot = (SoundMixer::__next_voice + n) % ENGINE_SOUND_MIXER_MAX_VOICES;
+                __voice& voice = SoundMixer::__voices[slot];
+                if (voice.state.load(std::memory_order_acquire) != (int)__voice_state::Free) continue;
+
+                voice.samples = sound->__data->abuf;
+                voice.frame_count = frame_count;
+                voice.position = 0; voice.fraction = 0;
+                voice.is_device_format = sound->IsDeviceFormat();
+                voice.source_channels = sound->GetChannels();
+                voice.step = ((unsigned long long)sound->GetFrequency() << 32) / (unsigned long long)AudioDevice::GetFrequency();
+                voice.loops_left = loop_count;
+                voice.applied_left = 0.0f; voice.applied_right = 0.0f;
+                voice.sound = sound;
+                voice.generation = (voice.generation + 1) & 0x7FFFFF;
+                voice.gain = gain < 0.0f ? 0.0f : gain;
+                voice.pan = 0.0f;
+                voice.positional = positional;
+                voice.emitter_position = position;
+                voice.bus.store(bus ? bus->__index : 0, std::memory_order_relaxed);
+                __update_voice(voice);
+                voice.state.store((int)__voice_state::Playing, std::memory_order_release);
+
+                SoundMixer::__next_voice = (slot + 1) % ENGINE_SOUND_MIXER_MAX_VOICES;
+                return voice.generation * ENGINE_SOUND_MIXER_MAX_VOICES + slot;
+            }
+            return -1;
+        }
+
+        /// @brief Route the given channel of the channel pool into the Sound Bus of the given Sound, by (re)registering the
+        /// capture effect on it. Called by Sound before the Sound is played on the channel.
+        static void __route_channel(int channel, Sound* sound) {
+            if (channel < 0 || channel >= ENGINE_SOUND_MIXER_MAX_CHANNELS) return;
+            SoundMixer::__channel_buses[channel].store(sound && sound->Bus ? sound->Bus->__index : 0, std::memory_order_relaxed);
+            // The effects of a channel are removed when it finish playing, unregister first in case the last play failed.
+            Mix_UnregisterEffect(channel, &SoundMixer::__capture_channel);
+            Mix_RegisterEffect(channel, &SoundMixer::__capture_channel, nullptr, nullptr);
+        }
+        /// @brief The channel effect, accumulate the channel output (with the channel and chunk volume) into the channel buffer
+        /// of it Sound Bus and silence it, so SDL_mixer mix nothing for the channel (audio thread).
+        static void __capture_channel(int channel, void* stream, int len, void* udata) {
+            if (channel < 0 || channel >= ENGINE_SOUND_MIXER_MAX_CHANNELS) return;
+            int bus_index = SoundMixer::__channel_buses[channel].load(std::memory_order_relaxed);
+            SoundBus* bus = (bus_index >= 0 && bus_index < ENGINE_SOUND_MIXER_MAX_BUSES) ?
+                SoundMixer::__buses[bus_index].load(std::memory_order_acquire) : nullptr;
+            if (!bus) bus = SoundMixer::__buses[0].load(std::memory_order_acquire);
+            if (!bus) return;
+
+            // The effect is called in order for each part of the channel mixed in this callback (e.g. on loop).
+            int& position = SoundMixer::__channel_positions[channel];
+            int capacity = (int)(bus->__channel_buffer.size() / 2);
+            // Frames that don't fit the channel buffer (never expected) are left to SDL_mixer, bypassing the bus.
+            int frames = ENGINE_MIN(len / SoundMixer::__frame_size, capacity - position);
+            if (frames <= 0) return;
+            Mix_Chunk* chunk = Mix_GetChunk(channel);
+            float gain = (float)Mix_Volume(channel, -1) * (float)(chunk ? Mix_VolumeChunk(chunk, -1) : MIX_MAX_VOLUME) /
+                (float)(MIX_MAX_VOLUME * MIX_MAX_VOLUME);
+            float* target = bus->__channel_buffer.data() + (size_t)position * 2;
+            if (SoundMixer::__format == AUDIO_F32SYS)
+                __mix_f32(target, (const float*)stream, frames, gain, gain, 0.0f, 0.0f);
+            else
+                __mix_s16(target, (const int16_t*)stream, frames, gain, gain, 0.0f, 0.0f);
+            std::memset(stream, 0, (size_t)frames * SoundMixer::__frame_size);
+            position += frames;
+            bus->__channel_frames = ENGINE_MAX(bus->__channel_frames, position);
+        }
+
+        /// @brief Accumulate stereo AUDIO_S16SYS samples into the mix buffer, with gains ramping by the given steps per frame.
+        static void __mix_s16(float* mix, const int16_t* src, int frames, float left, float right, float step_left, float step_right) {
+            int i = 0;
+#if defined(ENGINE_SOUND_MIXER_AVX2)
+            __m256 gain = _mm256_setr_ps(left, right, left + step_left, right + step_right,
+                left + 2 * step_left, right + 2 * step_right, left + 3 * step_left, right + 3 * step_right);
+            __m256 step = _mm256_setr_ps(4 * step_left, 4 * step_right, 4 * step_left, 4 * step_right,
+                4 * step_left, 4 * step_right, 4 * step_left, 4 * step_right);
+            for (; i + 4 <= frames; i += 4) {
+                __m256 s = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(src + i * 2))));
+                _mm256_storeu_ps(mix + i * 2, _mm256_add_ps(_mm256_loadu_ps(mix + i * 2), _mm256_mul_ps(s, gain)));
+                gain = _mm256_add_ps(gain, step);
+            }
+#elif defined(ENGINE_SOUND_MIXER_SSE2)
+            __m128 gain_lo = _mm_setr_ps(left, right, left + step_left, right + step_right);
+            __m128 gain_hi = _mm_setr_ps(left + 2 * step_left, right + 2 * step_right, left + 3 * step_left, right + 3 * step_right);
+            __m128 step = _mm_setr_ps(4 * step_left, 4 * step_right, 4 * step_left, 4 * step_right);
+            for (; i + 4 <= frames; i += 4) {
+                __m128i s = _mm_loadu_si128((const __m128i*)(src + i * 2));
+                __m128 s_lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16));
+                __m128 s_hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16));
+                _mm_storeu_ps(mix + i * 2, _mm_add_ps(_mm_loadu_ps(mix + i * 2), _mm_mul_ps(s_lo, gain_lo)));
+                _mm_storeu_ps(mix + i * 2 + 4, _mm_add_ps(_mm_loadu_ps(mix + i * 2 + 4), _mm_mul_ps(s_hi, gain_hi)));
+                gain_lo = _mm_add_ps(gain_lo, step);
+                gain_hi = _mm_add_ps(gain_hi, step);
+            }
+#endif
+            for (; i < frames; i++) {
+                mix[i * 2] += src[i * 2] * (left + step_left * i);
+                mix[i * 2 + 1] += src[i * 2 + 1] * (right + step_right * i);
+            }
+        }
+        /// @brief Accumulate stereo AUDIO_F32SYS samples into the mix buffer, with gains ramping by the given steps per frame.
+        static void __mix_f32(float* mix, const float* src, int frames, float left, float right, float step_left, float step_right) {
+            int i = 0;
+#if defined(ENGINE_SOUND_MIXER_AVX2)
+            __m256 gain = _mm256_setr_ps(left, right, left + step_left, right + step_right,
+                left + 2 * step_left, right + 2 * step_right, left + 3 * step_left, right + 3 * step_right);
+            __m256 step = _mm256_setr_ps(4 * step_left, 4 * step_right, 4 * step_left, 4 * step_right,
+                4 * step_left, 4 * step_right, 4 * step_left, 4 * step_right);
+            for (; i + 4 <= frames; i += 4) {
+                _mm256_storeu_ps(mix + i * 2, _mm256_add_ps(_mm256_loadu_ps(mix + i * 2), _mm256_mul_ps(_mm256_loadu_ps(src + i * 2), gain)));
+                gain = _mm256_add_ps(gain, step);
+            }
+#elif defined(ENGINE_SOUND_MIXER_SSE2)
+            __m128 gain = _mm_setr_ps(left, right, left + step_left, right + step_right);
+            __m128 step = _mm_setr_ps(2 * step_left, 2 * step_right, 2 * step_left, 2 * step_right);
+            for (; i + 2 <= frames; i += 2) {
+                _mm_storeu_ps(mix + i * 2, _mm_add_ps(_mm_loadu_ps(mix + i * 2), _mm_mul_ps(_mm_loadu_ps(src + i * 2), gain)));
+                gain = _mm_add_ps(gain, step);
+            }
+#endif
+            for (; i < frames; i++) {
+                mix[i * 2] += src[i * 2] * (left + step_left * i);
+                mix[i * 2 + 1] += src[i * 2 + 1] * (right + step_right * i);
+            }
+        }
+        /// @brief Add the mix buffer to the AUDIO_S16SYS stream, with saturation.
+        static void __write_s16(int16_t* stream, const float* mix, int samples) {
+            int i = 0;
+#if defined(ENGINE_SOUND_MIXER_SSE2) || defined(ENGINE_SOUND_MIXER_AVX2)
+            for (; i + 8 <= samples; i += 8) {
+                __m128i s = _mm_loadu_si128((const __m128i*)(stream + i));
+                __m128i lo = _mm_add_epi32(_mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16), _mm_cvtps_epi32(_mm_loadu_ps(mix + i)));
+                __m128i hi = _mm_add_epi32(_mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16), _mm_cvtps_epi32(_mm_loadu_ps(mix + i + 4)));
+                _mm_storeu_si128((__m128i*)(stream + i), _mm_packs_epi32(lo, hi));
+            }
+#endif
+            for (; i < samples; i++) {
+                int value = stream[i] + (int)std::lrint(mix[i]);
+                stream[i] = (int16_t)ENGINE_FAST_CLAMP(-32768, 32767, value);
+            }
+        }
+        /// @brief Add the mix buffer to the AUDIO_F32SYS stream, with clipping.
+        static void __write_f32(float* stream, const float* mix, int samples) {
+            int i = 0;
+#if defined(ENGINE_SOUND_MIXER_SSE2) || defined(ENGINE_SOUND_MIXER_AVX2)
+            __m128 min = _mm_set1_ps(-1.0f), max = _mm_set1_ps(1.0f);
+            for (; i + 4 <= samples; i += 4) {
+                __m128 value = _mm_add_ps(_mm_loadu_ps(stream + i), _mm_loadu_ps(mix + i));
+                _mm_storeu_ps(stream + i, _mm_min_ps(max, _mm_max_ps(min, value)));
+            }
+#endif
+            for (; i < samples; i++) {
+                float value = stream[i] + mix[i];
+                stream[i] = ENGINE_FAST_CLAMP(-1.0f, 1.0f, value);
+            }
+        }
+        /// @brief Read a sample of the given voice as float (in the sample format unit).
+        static float __read_sample(const __voice& voice, uint32_t frame, int channel) {
+            size_t index = (size_t)frame * voice.source_channels + ENGINE_MIN(channel, voice.source_channels - 1);
+            if (SoundMixer::__format == AUDIO_F32SYS)
+                return ((const float*)voice.samples)[index];
+            return (float)((const int16_t*)voice.samples)[index];
+        }
+        /// @brief Mix the given voice that not in the Audio Device format, with linear interpolation (audio thread).
+        /// @return true if the voice still playing, false if the voice is finished.
+        static bool __mix_resampled_voice(__voice& voice, float* mix, int frames, float left, float right, float step_left, float step_right) {
+            for (int i = 0; i < frames; i++) {
+                while (voice.position >= voice.frame_count) {
+                    if (voice.loops_left == 0) return false;
+                    if (voice.loops_left > 0) voice.loops_left--;
+                    voice.position -= voice.frame_count;
+                }
+                uint32_t next = voice.position + 1;
+                if (next >= voice.frame_count) next = (voice.loops_left != 0) ? 0 : voice.position;
+                float t = (float)voice.fraction * (1.0f / 4294967296.0f);
+
+                float l0 = __read_sample(voice, voice.position, 0), l1 = __read_sample(voice, next, 0);
+                float r0 = __read_sample(voice, voice.position, 1), r1 = __read_sample(voice, next, 1);
+                mix[i * 2] += (l0 + (l1 - l0) * t) * (left + step_left * i);
+                mix[i * 2 + 1] += (r0 + (r1 - r0) * t) * (right + step_right * i);
+
+                unsigned long long advanced = (unsigned long long)voice.fraction + voice.step;
+                voice.position += (uint32_t)(advanced >> 32);
+                voice.fraction = (uint32_t)advanced;
+            }
+            return voice.position < voice.frame_count || voice.loops_left != 0;
+        }
+        /// @brief Mix the given voice into the mix buffer (audio thread).
+        /// @return true if the voice still playing, false if the voice is finished.
+        static bool __mix_voice(__voice& voice, float* mix, int frames) {
+            float target_left = voice.target_left.load(std::memory_order_relaxed);
+            float target_right = voice.target_right.load(std::memory_order_relaxed);
+            float left = voice.applied_left, right = voice.applied_right;
+            float step_left = (target_left - left) / frames, step_right = (target_right - right) / frames;
+            voice.applied_left = target_left; voice.applied_right = target_right;
+            if (!voice.is_device_format)
+                return __mix_resampled_voice(voice, mix, frames, left, right, step_left, step_right);
+
+            int done = 0;
+            while (done < frames) {
+                int count = (int)ENGINE_MIN((uint32_t)(frames - done), voice.frame_count - voice.position);
+                const uint8_t* src = voice.samples + (size_t)voice.position * SoundMixer::__frame_size;
+                if (SoundMixer::__format == AUDIO_F32SYS)
+                    __mix_f32(mix + done * 2, (const float*)src, count,
+                        left + step_left * done, right + step_right * done, step_left, step_right);
+                else
+                    __mix_s16(mix + done * 2, (const int16_t*)src, count,
+                        left + step_left * done, right + step_right * done, step_left, step_right);
+                done += count;
+                voice.position += count;
+
+                if (voice.position >= voice.frame_count) {
+                    if (voice.loops_left == 0) return false;
+                    if (voice.loops_left > 0) voice.loops_left--;
+                    voice.position = 0;
+                }
+            }
+            return true;
+        }
+        /// @brief The post mix callback, mix the captured channels and all playing voices into their buses, then process the
+        /// buses (children first) into the master bus, on top of the SDL_mixer output (audio thread).
+        static void __post_mix(Uint8* stream, int len) {
+            alignas(32) float mix[ENGINE_SOUND_MIXER_BLOCK_FRAMES * 2];
+            int frames = len / SoundMixer::__frame_size;
+
+            SoundBus* buses[ENGINE_SOUND_MIXER_MAX_BUSES];
+            for (int i = 0; i < ENGINE_SOUND_MIXER_MAX_BUSES; i++) {
+                buses[i] = SoundMixer::__buses[i].load(std::memory_order_acquire);
+                if (buses[i]) buses[i]->__swap_read_block();
+            }
+            SoundBus* master = buses[0];
+            if (!master) return;
+
+            for (int offset = 0; offset < frames; offset += ENGINE_SOUND_MIXER_BLOCK_FRAMES) {
+                int block = ENGINE_MIN(ENGINE_SOUND_MIXER_BLOCK_FRAMES, frames - offset);
+                for (SoundBus* bus : buses) {
+                    if (!bus) continue;
+                    std::memset(bus->__buffer, 0, sizeof(float) * block * 2);
+                    int captured = ENGINE_MIN(block, bus->__channel_frames - offset);
+                    if (captured > 0)
+                        __mix_f32(bus->__buffer, bus->__channel_buffer.data() + (size_t)offset * 2, captured, 1.0f, 1.0f, 0.0f, 0.0f);
+                }
+
+                for (__voice& voice : SoundMixer::__voices) {
+                    int state = voice.state.load(std::memory_order_acquire);
+                    if (state == (int)__voice_state::Stopping) {
+                        voice.state.compare_exchange_strong(state, (int)__voice_state::Free, std::memory_order_acq_rel);
+                        continue;
+                    }
+                    if (state != (int)__voice_state::Playing) continue;
+                    int bus_index = voice.bus.load(std::memory_order_relaxed);
+                    SoundBus* bus = (bus_index >= 0 && bus_index < ENGINE_SOUND_MIXER_MAX_BUSES && buses[bus_index]) ? buses[bus_index] : master;
+                    if (!__mix_voice(voice, bus->__buffer, block))
+                        voice.state.compare_exchange_strong(state, (int)__voice_state::Free, std::memory_order_acq_rel);
+                }
+                for (int i = 0; i < ENGINE_SOUND_MIXER_MAX_SOURCES; i++) {
+                    SoundMixerSource source = SoundMixer::__sources[i].load(std::memory_order_acquire);
+                    if (!source) continue;
+                    int bus_index = SoundMixer::__source_buses[i].load(std::memory_order_relaxed);
+                    SoundBus* bus = (bus_index >= 0 && bus_index < ENGINE_SOUND_MIXER_MAX_BUSES && buses[bus_index]) ? buses[bus_index] : master;
+                    source(bus->__buffer, block);
+                }
+
+                // A child bus always have higher index than it parent, so processing in reverse order is topological.
+                for (int i = ENGINE_SOUND_MIXER_MAX_BUSES - 1; i >= 0; i--) {
+                    SoundBus* bus = buses[i];
+                    if (!bus) continue;
+                    bus->__process(block);
+
+                    float* target = mix;
+                    if (i == 0) std::memset(mix, 0, sizeof(float) * block * 2);
+                    else {
+                        int parent_index = bus->__parent_index.load(std::memory_order_relaxed);
+                        SoundBus* parent = (parent_index >= 0 && parent_index < i && buses[parent_index]) ? buses[parent_index] : master;
+                        target = parent->__buffer;
+                    }
+                    float gain = bus->__blocks[bus->__read_block].gain, applied = bus->__applied_gain;
+                    float step = (gain - applied) / block;
+                    bus->__applied_gain = gain;
+                    __mix_f32(target, bus->__buffer, block, applied, applied, step, step);
+                }
+
+                Uint8* target = stream + (size_t)offset * SoundMixer::__frame_size;
+                if (SoundMixer::__format == AUDIO_F32SYS)
+                    __write_f32((float*)target, mix, block * 2);
+                else
+                    __write_s16((int16_t*)target, mix, block * 2);
+            }
+
+            // The channels are captured again from the start of the next audio callback.
+            for (SoundBus* bus : buses) {
+                if (!bus || bus->__channel_frames <= 0) continue;
+                std::memset(bus->__channel_buffer.data(), 0, sizeof(float) * bus->__channel_frames * 2);
+                bus->__channel_frames = 0;
+            }
+            std::memset(SoundMixer::__channel_positions, 0, sizeof(SoundMixer::__channel_positions));
+        }
+    public:
+        /// @brief Initialize the Sound Mixer. This is called on Engine::Initialize().
+        /// @return true on success, false on failed (the audio device is not opened, or not a stereo AUDIO_S16SYS or
+        /// AUDIO_F32SYS device).
+        static bool Initialize() {
+            if (SoundMixer::__is_initialized) return true;
+            if (!AudioDevice::IsOpened()) return false;
+            int channels = AudioDevice::GetChannels();
+            Uint16 format = AudioDevice::GetFormat();
+            if (channels != 2) return false;
+            if (format != AUDIO_S16SYS && format != AUDIO_F32SYS) return false;
+
+            SoundMixer::__format = format;
+            SoundMixer::__frame_size = channels * (SDL_AUDIO_BITSIZE(format) / 8);
+            for (__voice& voice : SoundMixer::__voices)
+                voice.state.store((int)__voice_state::Free, std::memory_order_release);
+            SoundMixer::__buses[0].store(new SoundBus("Master", 0, -1, AudioDevice::GetFrequency()), std::memory_order_release);
+            if (!AudioDevice::AddPostMixHandler(&SoundMixer::__post_mix)) {
+                delete SoundMixer::__buses[0].exchange(nullptr);
+                return false;
+            }
+            Sound::__release_mixer_voices = &SoundMixer::StopSound;
+            Sound::__route_channel = &SoundMixer::__route_channel;
+            SoundMixer::__is_initialized = true;
+            return true;
+        }
+        /// @brief Deinitialize the Sound Mixer, all playing voices will be stopped. This is called on Engine::Deinitialize().
+        static void Deinitialize() {
+            if (!SoundMixer::__is_initialized) return;
+            // The routed channels play directly again, Mix_UnregisterEffect() lock the audio device so no capture is running.
+            Sound::__route_channel = nullptr;
+            int channel_count = ENGINE_MIN(Mix_AllocateChannels(-1), ENGINE_SOUND_MIXER_MAX_CHANNELS);
+            for (int channel = 0; channel < channel_count; channel++)
+                Mix_UnregisterEffect(channel, &SoundMixer::__capture_channel);
+            // Removing the post mix handler also wait for the running one to finish.
+            AudioDevice::RemovePostMixHandler(&SoundMixer::__post_mix);
+            Sound::__release_mixer_voices = nullptr;
+            for (__voice& voice : SoundMixer::__voices) {
+                voice.state.store((int)__voice_state::Free, std::memory_order_release);
+                voice.sound = nullptr;
+            }
+            for (std::atomic<SoundBus*>& bus : SoundMixer::__buses)
+                delete bus.exchange(nullptr);
+            for (std::atomic<SoundMixerSource>& source : SoundMixer::__sources)
+                source.store(nullptr, std::memory_order_release);
+            SoundMixer::__is_initialized = false;
+        }
+        /// @brief Check if the Sound Mixer is initialized.
+        /// @return true if the Sound Mixer is initialized, false otherwise.
+        static bool IsInitialized() { return SoundMixer::__is_initialized; }
+
+        /// @brief Play the given Sound on a voice of the Sound Mixer.
+        /// @param sound The Sound to play.
+        /// @param loop_count The number of loop to play (default is 0 mean not looping), or -1 to loop infinitely.
+        /// @param gain The gain of the voice. Default is 1.
+        /// @param bus The Sound Bus that the voice is mixed into, or nullptr (default) for the master bus.
+        /// @return The voice ID, or -1 on failed (or there's no free voice).
+        static int Play(Sound* sound, int loop_count = 0, float gain = 1.0f, SoundBus* bus = nullptr) {
+            return __start(sound, loop_count, gain, false, Point::Zero, bus);
+        }
+        /// @brief Play the given Sound on a voice of the Sound Mixer at the given position. The gain and pan of the voice are
+        /// computed from the distance to the listener position.
+        /// @param sound The Sound to play.
+        /// @param position The position of the emitter, in the same space with the listener position.
+        /// @param loop_count The number of loop to play (default is 0 mean not looping), or -1 to loop infinitely.
+        /// @param gain The gain of the voice (before distance attenuation). Default is 1.
+        /// @param bus The Sound Bus that the voice is mixed into, or nullptr (default) for the master bus.
+        /// @return The voice ID, or -1 on failed (or there's no free voice).
+        static int PlayAt(Sound* sound, const Point& position, int loop_count = 0, float gain = 1.0f, SoundBus* bus = nullptr) {
+            return __start(sound, loop_count, gain, true, position, bus);
+        }
+
+        /// @brief Stop the given voice.
+        /// @param voice_id The voice ID to stop.
+        static void Stop(int voice_id) {
+            __voice* voice = __get_voice(voice_id);
+            if (!voice) return;
+            int state = (int)__voice_state::Playing;
+            voice->state.compare_exchange_strong(state, (int)__voice_state::Stopping, std::memory_order_acq_rel);
+        }
+        /// @brief Stop all voices that playing the given Sound, and wait until the audio thread release the Sound data. This
+        /// is called when a Sound is destroyed.
+        /// @param sound The Sound to stop.
+        static void StopSound(Sound* sound) {
+            if (!sound) return;
+            bool has_voice = false;
+            for (__voice& voice : SoundMixer::__voices) {
+                if (voice.sound != sound) continue;
+                int state = (int)__voice_state::Playing;
+                voice.state.compare_exchange_strong(state, (int)__voice_state::Stopping, std::memory_order_acq_rel);
+                if (voice.state.load(std::memory_order_acquire) == (int)__voice_state::Stopping) has_voice = true;
+            }
+            if (!has_voice) return;
+
+            // A voice marked as Stopping is never read by the audio thread after the running callback finished.
+            AudioDevice::WaitForAudioCallback();
+            for (__voice& voice : SoundMixer::__voices) {
+                if (voice.sound != sound) continue;
+                int state = (int)__voice_state::Stopping;
+                voice.state.compare_exchange_strong(state, (int)__voice_state::Free, std::memory_order_acq_rel);
+                voice.sound = nullptr;
+            }
+        }
+        /// @brief Stop all voices of the Sound Mixer.
+        static void StopAll() {
+            for (__voice& voice : SoundMixer::__voices) {
+                int state = (int)__voice_state::Playing;
+                voice.state.compare_exchange_strong(state, (int)__voice_state::Stopping, std::memory_order_acq_rel);
+            }
+        }
+        /// @brief Check if the given voice is playing.
+        /// @param voice_id The voice ID to check.
+        /// @return true if the voice is playing, false otherwise.
+        static bool IsPlaying(int voice_id) { return (bool)__get_voice(voice_id); }
+        /// @brief Get the number of playing voices of the Sound Mixer.
+        /// @return The number of playing voices.
+        static int GetPlayingVoiceCount() {
+            int count = 0;
+            for (__voice& voice : SoundMixer::__voices)
+                if (voice.state.load(std::memory_order_relaxed) == (int)__voice_state::Playing) count++;
+            return count;
+        }
+
+        /// @brief Set the gain of the given voice.
+        /// @param voice_id The voice ID to set.
+        /// @param gain The gain to set, will be clamped to be at least 0.
+        static void SetVoiceGain(int voice_id, float gain) {
+            __voice* voice = __get_voice(voice_id);
+            if (!voice) return;
+            voice->gain = gain < 0.0f ? 0.0f : gain;
+            __update_voice(*voice);
+        }
+        /// @brief Set the stereo pan of the given voice. This is ignored for positional voice (played with PlayAt()).
+        /// @param voice_id The voice ID to set.
+        /// @param pan The pan to set, from -1 (left) to 1 (right). 0 is center.
+        static void SetVoicePan(int voice_id, float pan) {
+            __voice* voice = __get_voice(voice_id);
+            if (!voice) return;
+            voice->pan = ENGINE_FAST_CLAMP(-1.0f, 1.0f, pan);
+            __update_voice(*voice);
+        }
+        /// @brief Set the emitter position of the given voice, the voice will become positional.
+        /// @param voice_id The voice ID to set.
+        /// @param position The position of the emitter, in the same space with the listener position.
+        static void SetVoicePosition(int voice_id, const Point& position) {
+            __voice* voice = __get_voice(voice_id);
+            if (!voice) return;
+            voice->positional = true;
+            voice->emitter_position = position;
+            __update_voice(*voice);
+        }
+
+        /// @brief Set the Sound Bus that the given voice is mixed into.
+        /// @param voice_id The voice ID to set.
+        /// @param bus The Sound Bus to set, or nullptr for the master bus.
+        static void SetVoiceBus(int voice_id, SoundBus* bus) {
+            __voice* voice = __get_voice(voice_id);
+            if (!voice) return;
+            voice->bus.store(bus ? bus->__index : 0, std::memory_order_relaxed);
+        }
+
+        /// @brief Get the master bus of the Sound Mixer, all other Sound Buses are mixed into it.
+        /// @return The master bus, or nullptr if the Sound Mixer is not initialized.
+        static SoundBus* GetMasterBus() { return SoundMixer::__buses[0].load(std::memory_order_relaxed); }
+        /// @brief Create a new Sound Bus.
+        /// @param name The name of the Sound Bus.
+        /// @param parent The parent bus that the Sound Bus is mixed into, or nullptr (default) for the master bus.
+        /// @return The newly created Sound Bus, or nullptr on failed (the Sound Mixer is not initialized, or there's already
+        /// ENGINE_SOUND_MIXER_MAX_BUSES buses).
+        static SoundBus* CreateBus(const std::string& name, SoundBus* parent = nullptr) {
+            if (!SoundMixer::__is_initialized) return nullptr;
+            int parent_index = parent ? parent->__index : 0;
+            // A child bus must have higher index than it parent, see __post_mix().
+            for (int i = parent_index + 1; i < ENGINE_SOUND_MIXER_MAX_BUSES; i++) {
+                if (SoundMixer::__buses[i].load(std::memory_order_relaxed)) continue;
+                SoundBus* bus = new SoundBus(name, i, parent_index, AudioDevice::GetFrequency());
+                SoundMixer::__buses[i].store(bus, std::memory_order_release);
+                return bus;
+            }
+            return nullptr;
+        }
+        /// @brief Destroy the given Sound Bus. The child buses, the voices and the playing channels of the Sound Bus are moved
+        /// to it parent bus. The master bus can't be destroyed.
+        /// @note The Sounds with the Sound Bus as Bus must be changed before they are played again.
+        /// @param bus The Sound Bus to destroy.
+        static void DestroyBus(SoundBus* bus) {
+            if (!bus || bus->__index == 0) return;
+            if (SoundMixer::__buses[bus->__index].load(std::memory_order_relaxed) != bus) return;
+            int parent_index = bus->__parent_index.load(std::memory_order_relaxed);
+            for (std::atomic<SoundBus*>& slot : SoundMixer::__buses) {
+                SoundBus* child = slot.load(std::memory_order_relaxed);
+                if (child && child->__parent_index.load(std::memory_order_relaxed) == bus->__index)
+                    child->__parent_index.store(parent_index, std::memory_order_relaxed);
+            }
+            for (__voice& voice : SoundMixer::__voices)
+                if (voice.bus.load(std::memory_order_relaxed) == bus->__index)
+                    voice.bus.store(parent_index, std::memory_order_relaxed);
+            for (std::atomic<int>& source_bus : SoundMixer::__source_buses)
+                if (source_bus.load(std::memory_order_relaxed) == bus->__index)
+                    source_bus.store(parent_index, std::memory_order_relaxed);
+            for (std::atomic<int>& channel_bus : SoundMixer::__channel_buses)
+                if (channel_bus.load(std::memory_order_relaxed) == bus->__index)
+                    channel_bus.store(parent_index, std::memory_order_relaxed);
+
+            SoundMixer::__buses[bus->__index].store(nullptr, std::memory_order_release);
+            AudioDevice::WaitForAudioCallback();
+            delete bus;
+        }
+        /// @brief Find the first Sound Bus with the given name.
+        /// @param name The name to find.
+        /// @return The first Sound Bus with the given name, or nullptr if not found.
+        static SoundBus* FindBus(const std::string& name) {
+            for (std::atomic<SoundBus*>& slot : SoundMixer::__buses) {
+                SoundBus* bus = slot.load(std::memory_order_relaxed);
+                if (bus && bus->GetName() == name) return bus;
+            }
+            return nullptr;
+        }
+
+        /// @brief Add a source callback to the Sound Mixer, called on the audio thread every mix block to accumulate frames
+        /// into the given Sound Bus.
+        /// @param source The source callback to add.
+        /// @param bus The Sound Bus that the source is mixed into, or nullptr (default) for the master bus.
+        /// @return true on success, false on failed (the Sound Mixer is not initialized, the source is already added, or
+        /// there's already ENGINE_SOUND_MIXER_MAX_SOURCES sources).
+        static bool AddSource(SoundMixerSource source, SoundBus* bus = nullptr) {
+            if (!SoundMixer::__is_initialized || !source) return false;
+            for (std::atomic<SoundMixerSource>& slot : SoundMixer::__sources)
+                if (slot.load(std::memory_order_relaxed) == source) return false;
+            for (int i = 0; i < ENGINE_SOUND_MIXER_MAX_SOURCES; i++) {
+                if (SoundMixer::__sources[i].load(std::memory_order_relaxed)) continue;
+                SoundMixer::__source_buses[i].store(bus ? bus->__index : 0, std::memory_order_relaxed);
+                SoundMixer::__sources[i].store(source, std::memory_order_release);
+                return true;
+            }
+            return false;
+        }
+        /// @brief Remove the given source callback from the Sound Mixer, and wait until the running audio callback finished,
+        /// so the source is never called after this return.
+        /// @param source The source callback to remove.
+        static void RemoveSource(SoundMixerSource source) {
+            if (!source) return;
+            bool is_removed = false;
+            for (std::atomic<SoundMixerSource>& slot : SoundMixer::__sources) {
+                if (slot.load(std::memory_order_relaxed) != source) continue;
+                slot.store(nullptr, std::memory_order_release);
+                is_removed = true;
+            }
+            if (is_removed) AudioDevice::WaitForAudioCallback();
+        }
+        /// @brief Set the Sound Bus that the given source callback is mixed into.
+        /// @param source The source callback to set.
+        /// @param bus The Sound Bus to set, or nullptr for the master bus.
+        static void SetSourceBus(SoundMixerSource source, SoundBus* bus) {
+            for (int i = 0; i < ENGINE_SOUND_MIXER_MAX_SOURCES; i++)
+                if (SoundMixer::__sources[i].load(std::memory_order_relaxed) == source)
+                    SoundMixer::__source_buses[i].store(bus ? bus->__index : 0, std::memory_order_relaxed);
+        }
+
+        /// @brief Get the master gain of the Sound Mixer, this is the gain of the master bus.
+        /// @return The master gain of the Sound Mixer, or 1 if the Sound Mixer is not initialized.
+        static float GetMasterGain() {
+            SoundBus* master = GetMasterBus();
+            return master ? master->GetParameters().Gain : 1.0f;
+        }
+        /// @brief Set the master gain of the Sound Mixer, this is the same as setting the gain of the master bus.
+        /// @param gain The master gain to set, will be clamped to be at least 0.
+        static void SetMasterGain(float gain) {
+            SoundBus* master = GetMasterBus();
+            if (master) master->SetGain(gain < 0.0f ? 0.0f : gain);
+        }
+        /// @brief Get the listener position of the Sound Mixer.
+        /// @return The listener position. Default is Point::Zero.
+        static Point GetListenerPosition() { return SoundMixer::__listener_position; }
+        /// @brief Set the listener position of the Sound Mixer, the positional voices will be updated.
+        /// @param position The listener position to set.
+        static void SetListenerPosition(const Point& position) {
+            SoundMixer::__listener_position = position;
+            UpdateAllVoices();
+        }
+        /// @brief Set the distance attenuation range of the positional voices. The voices are played at full gain when closer
+        /// than the minimum distance, and fade out linearly to silent at the maximum distance.
+        /// @param min_distance The minimum distance in pixels. Default is 100.
+        /// @param max_distance The maximum distance in pixels. Default is 1000.
+        static void SetAttenuationDistance(float min_distance, float max_distance) {
+            SoundMixer::__min_distance = min_distance < 0.0f ? 0.0f : min_distance;
+            SoundMixer::__max_distance = ENGINE_MAX(SoundMixer::__min_distance, max_distance);
+            UpdateAllVoices();
+        }
+        /// @brief Get the minimum distance of the distance attenuation range.
+        /// @return The minimum distance in pixels.
+        static float GetMinimumDistance() { return SoundMixer::__min_distance; }
+        /// @brief Get the maximum distance of the distance attenuation range.
+        /// @return The maximum distance in pixels.
+        static float GetMaximumDistance() { return SoundMixer::__max_distance; }
+        /// @brief Set the horizontal distance from the listener that a positional voice is fully panned to one side.
+        /// @param distance The distance in pixels to set, or 0 to disable panning. Default is 500.
+        static void SetPanDistance(float distance) {
+            SoundMixer::__pan_distance = distance < 0.0f ? 0.0f : distance;
+            UpdateAllVoices();
+        }
+        /// @brief Get the horizontal distance from the listener that a positional voice is fully panned to one side.
+        /// @return The distance in pixels.
+        static float GetPanDistance() { return SoundMixer::__pan_distance; }
+        /// @brief Recompute and publish the gains of all playing voices.
+        static void UpdateAllVoices() {
+            for (__voice& voice : SoundMixer::__voices)
+                if (voice.state.load(std::memory_order_acquire) == (int)__voice_state::Playing)
+                    __update_voice(voice);
+        }
+    };
+
+    /// @brief The Sound Emitter Script class, provide a Game Script that play Sounds on the Sound Mixer at the position of
+    /// the target Game Object. The voices follow the Game Object on update, and are stopped when the script is removed.
+    class SoundEmitterScript : public GameScript {
+    private:
+        GameObject* __target = nullptr;
+        std::vector<int> __voices;
+    public:
+        /// @brief If this true (default), will stop all voices of the script when the script is removed from the Game Object.
+        bool StopOnRemove = true;
+        /// @brief The Sound Bus that the voices of the script are mixed into, or nullptr (default) for the master bus.
+        SoundBus* Bus = nullptr;
+
+        SoundEmitterScript() = default;
+        virtual ~SoundEmitterScript() {}
+
+        ENGINE_NOT_COPYABLE(SoundEmitterScript)
+        ENGINE_NOT_ASSIGNABLE(SoundEmitterScript)
+
+        /// @brief Play the given Sound at the position of the target Game Object.
+        /// @param sound The Sound to play.
+        /// @param loop_count The number of loop to play (default is 0 mean not looping), or -1 to loop infinitely.
+        /// @param gain The gain of the voice (before distance attenuation). Default is 1.
+        /// @return The voice ID, or -1 on failed.
+        int Play(Sound* sound, int loop_count = 0, float gain = 1.0f) {
+            if (!__target) return -1;
+            int voice_id = SoundMixer::PlayAt(sound, __target->Position, loop_count, gain, Bus);
+            if (voice_id >= 0) __voices.push_back(voice_id);
+            return voice_id;
+        }
+        /// @brief Stop all voices that played by the script.
+        void StopAll() {
+            for (int voice_id : __voices)
+                SoundMixer::Stop(voice_id);
+            __voices.clear();
+        }
+        /// @brief Get the number of playing voices of the script.
+        /// @return The number of playing voices.
+        size_t GetPlayingVoiceCount() const {
+            size_t count = 0;
+            for (int voice_id : __voices)
+                if (SoundMixer::IsPlaying(voice_id)) count++;
+            return count;
+        }
+
+        void OnStart(GameObject* Target) override { __target = Target; }
+        void OnStop(GameObject* Target) override {
+            if (StopOnRemove) StopAll();
+            __target = nullptr;
+        }
+        void OnLateUpdate(GameObject* Target) override {
+            size_t count = 0;
+            for (int voice_id : __voices) {
+                if (!SoundMixer::IsPlaying(voice_id)) continue;
+                SoundMixer::SetVoicePosition(voice_id, Target->Position);
+                __voices[count++] = voice_id;
+            }
+            __voices.resize(count);
+        }
+    };
+}
+
+bool Engine::SoundMixer::__is_initialized = false;
+SDL_AudioFormat Engine::SoundMixer::__format = AUDIO_S16SYS;
+int Engine::SoundMixer::__frame_size = 4;
+int Engine::SoundMixer::__next_voice = 0;
+Engine::SoundMixer::__voice Engine::SoundMixer::__voices[ENGINE_SOUND_MIXER_MAX_VOICES];
+std::atomic<Engine::SoundBus*> Engine::SoundMixer::__buses[ENGINE_SOUND_MIXER_MAX_BUSES] = {};
+std::atomic<Engine::SoundMixerSource> Engine::SoundMixer::__sources[ENGINE_SOUND_MIXER_MAX_SOURCES] = {};
+std::atomic<int> Engine::SoundMixer::__source_buses[ENGINE_SOUND_MIXER_MAX_SOURCES] = {};
+std::atomic<int> Engine::SoundMixer::__channel_buses[ENGINE_SOUND_MIXER_MAX_CHANNELS] = {};
+int Engine::SoundMixer::__channel_positions[ENGINE_SOUND_MIXER_MAX_CHANNELS] = {};
+
+Engine::Point Engine::SoundMixer::__listener_position = Engine::Point::Zero;
+float Engine::SoundMixer::__min_distance = 100.0f;
+float Engine::SoundMixer::__max_distance = 1000.0f;
+float Engine::SoundMixer::__pan_distance = 500.0f;
+
+#endif // __ENGINE_SOUNDMIXER_H__
\ No newline at end of file
@@ -0,0 +1,290 @@
+#ifndef __ENGINE_TILEMAP_H__
+#define __ENGINE_TILEMAP_H__
+
+#include "Engine_Define.h"
+#include "Engine_GameObject.h"
+#include "Engine_Imaging.h"
+#include "Engine_Math.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// @brief The width and height of a tilemap chunk, in tiles.
+#define ENGINE_TILEMAP_CHUNK_SIZE 32
+
+namespace Engine {
+    /// @brief The Tilemap Game Object class, render a grid of tiles from a tileset texture as one Game Object. The tiles
+    /// are stored in chunks of ENGINE_TILEMAP_CHUNK_SIZE x ENGINE_TILEMAP_CHUNK_SIZE tiles, the chunks without any tile
+    /// are not allocated. The geometry of each chunk is cached and only rebuilt when its tiles change, and only the
+    /// visible chunks are drawn, in one geometry batch (or as prerendered textures with Prerender).
+    class TilemapGameObject : public GameObject {
+    private:
+        struct __chunk {
+            uint16_t tiles[ENGINE_TILEMAP_CHUNK_SIZE * ENGINE_TILEMAP_CHUNK_SIZE] = {};
+            uint32_t tile_count = 0;
+            // The quads of the tiles, relative to the top-left of the chunk.
+            std::vector<SDL_Vertex> vertices;
+            Texture* texture = nullptr;
+            uint64_t last_used_frame = 0;
+            bool is_cached = false, is_geometry_dirty = true, is_texture_dirty = true;
+
+            ~__chunk() { if (texture) delete texture; }
+        };
+
+        int __width = 0, __height = 0, __chunk_columns = 0, __chunk_rows = 0;
+        std::vector<std::unique_ptr<__chunk>> __chunks;
+        std::vector<uint32_t> __cached_chunks;
+        std::vector<SDL_Vertex> __batch_vertices;
+        std::vector<int> __batch_indices;
+        uint64_t __frame = 0;
+        Texture* __last_tileset = nullptr;
+        Engine::Size __last_tile_size = Engine::Size::Zero;
+
+        __chunk* __get_chunk(int x, int y) const {
+            return __chunks[(size_t)(y / ENGINE_TILEMAP_CHUNK_SIZE) * __chunk_columns + x / ENGINE_TILEMAP_CHUNK_SIZE].get();
+        }
+        void __invalidate_all() {
+            for (auto& chunk : __chunks)
+                if (chunk) chunk->is_geometry_dirty = chunk->is_texture_dirty = true;
+        }
+        /// @brief Make sure the index buffer has the indices for the given number of quads.
+        void __reserve_indices(size_t quads) {
+            size_t old_quads = __batch_indices.size() / 6;
+            if (old_quads >= quads) return;
+            __batch_indices.resize(quads * 6);
+            for (size_t i = old_quads; i < quads; i++) {
+                int base = (int)(i * 4);
+                int* index = &__batch_indices[i * 6];
+                index[0] = base; index[1] = base + 1; index[2] = base + 2;
+                index[3] = base + 2; index[4] = base + 1; index[5] = base + 3;
+            }
+        }
+        /// @brief Rebuild the quads of the given chunk from its tiles.
+        void __build_geometry(__chunk& chunk) {
+            chunk.vertices.clear();
+            chunk.is_geometry_dirty = false;
+            if (!Tileset || TileSize.IsEmptyArea()) return;
+            Engine::Size tileset_size = Tileset->GetSize();
+            const int tile_width = abs(TileSize.Width), tile_height = abs(TileSize.Height);
+            const int columns = tileset_size.Width / tile_width;
+            const int tileset_count = columns * (tileset_size.Height / tile_height);
+            if (tileset_count <= 0) return;
+            const float inverse_width = 1.0f / tileset_size.Width, inverse_height = 1.0f / tileset_size.Height;
+
+            chunk.vertices.reserve((size_t)chunk.tile_count * 4);
+            const SDL_Color white = { 255, 255, 255, 255 };
+            for (int y = 0; y < ENGINE_TILEMAP_CHUNK_SIZE; y++) {
+                for (int x = 0; x < ENGINE_TILEMAP_CHUNK_SIZE; x++) {
+                    int tile = (int)chunk.tiles[y * ENGINE_TILEMAP_CHUNK_SIZE + x] - 1;
+                    if (tile < 0 || tile >= tileset_count) continue;
+                    float left = (float)(x * tile_width), top = (float)(y * tile_height);
+                    float u0 = (float)((tile % columns) * tile_width) * inverse_width;
+                    float v0 = (float)((tile / columns) * tile_height) * inverse_height;
+                    float u1 = u0 + tile_width * inverse_width, v1 = v0 + tile_height * inverse_height;
+                    chunk.vertices.push_back(SDL_Vertex{ SDL_FPoint{ left, top }, white, SDL_FPoint{ u0, v0 } });
+                    chunk.vertices.push_back(SDL_Vertex{ SDL_FPoint{ left + tile_width, top }, white, SDL_FPoint{ u1, v0 } });
+                    chunk.vertices.push_back(SDL_Vertex{ SDL_FPoint{ left, top + tile_height }, white, SDL_FPoint{ u0, v1 } });
+                    chunk.vertices.push_back(SDL_Vertex{ SDL_FPoint{ left + tile_width, top + tile_height }, white, SDL_FPoint{ u1, v1 } });
+                }
+            }
+        }
+        /// @brief Draw the geometry of the given chunk to its texture.
+        void __bake(__chunk& chunk) {
+            chunk.is_texture_dirty = false;
+            if (!chunk.texture) {
+                chunk.texture = Texture::Create(TileSize.Absolute().Width * ENGINE_TILEMAP_CHUNK_SIZE,
+                    TileSize.Absolute().Height * ENGINE_TILEMAP_CHUNK_SIZE);
+                if (!chunk.texture) return;
+                chunk.texture->SetBlendMode(DrawBlendMode::AlphaBlend);
+            }
+            // Restore the target of the caller after, it may be drawing the tilemap to a texture.
+            SDL_Texture* previous_target = Renderer::GetSDLTarget();
+            if (!Renderer::SetTarget(chunk.texture)) return;
+            Color draw_color = Renderer::GetDrawColor();
+            Renderer::SetDrawColor(0, 0, 0, 0);
+            Renderer::Clear();
+            Renderer::SetDrawColor(draw_color);
+            __reserve_indices(chunk.vertices.size() / 4);
+            Renderer::DrawGeometry(Tileset, chunk.vertices.data(), (int)chunk.vertices.size(),
+                __batch_indices.data(), (int)(chunk.vertices.size() / 4 * 6));
+            Renderer::SetSDLTarget(previous_target);
+        }
+        /// @brief Release the cache of the least recently used chunks, until there's at most MaxCachedChunks cached.
+        void __trim_cache() {
+            if (__cached_chunks.size() <= MaxCachedChunks) return;
+            std::sort(__cached_chunks.begin(), __cached_chunks.end(), [this](uint32_t a, uint32_t b) {
+                return __chunks[a]->last_used_frame > __chunks[b]->last_used_frame;
+            });
+            while (__cached_chunks.size() > MaxCachedChunks) {
+                __chunk& chunk = *__chunks[__cached_chunks.back()];
+                if (chunk.last_used_frame == __frame) break;
+                std::vector<SDL_Vertex>().swap(chunk.vertices);
+                if (chunk.texture) { delete chunk.texture; chunk.texture = nullptr; }
+                chunk.is_cached = false;
+                chunk.is_geometry_dirty = chunk.is_texture_dirty = true;
+                __cached_chunks.pop_back();
+            }
+        }
+    protected:
+        void OnRender(RenderEventArgs* args) override {
+            GameObject::OnRender(args);
+            if (!Tileset || TileSize.IsEmptyArea() || __chunks.empty()) return;
+            if (Tileset != __last_tileset || TileSize != __last_tile_size) {
+                __invalidate_all();
+                for (uint32_t index : __cached_chunks)
+                    if (__chunks[index]->texture) { delete __chunks[index]->texture; __chunks[index]->texture = nullptr; }
+                __last_tileset = Tileset; __last_tile_size = TileSize;
+            }
+            __frame++;
+
+            // Find the visible chunks from the drawing area in the local space.
+            Mat3x2f transform = args->Transform;
+            Mat3x2f inverse;
+            if (!transform.Invert(inverse)) return;
+            Engine::Size output_size = Renderer::GetOutputSize();
+            RectF visible = inverse.TransformBounds(RectF(0.0f, 0.0f, (float)output_size.Width, (float)output_size.Height));
+            const float chunk_width = (float)(abs(TileSize.Width) * ENGINE_TILEMAP_CHUNK_SIZE);
+            const float chunk_height = (float)(abs(TileSize.Height) * ENGINE_TILEMAP_CHUNK_SIZE);
+            int first_column = ENGINE_MAX(0, (int)floorf(visible.Left() / chunk_width));
+            int first_row = ENGINE_MAX(0, (int)floorf(visible.Top() / chunk_height));
+            int last_column = ENGINE_MIN(__chunk_columns - 1, (int)floorf(visible.Right() / chunk_width));
+            int last_row = ENGINE_MIN(__chunk_rows - 1, (int)floorf(visible.Bottom() / chunk_height));
+
+            // Snap a translation to whole pixels, so there's no seam between the tiles.
+            if (transform.IsTranslation()) { transform.M31 = floorf(transform.M31 + 0.5f); transform.M32 = floorf(transform.M32 + 0.5f); }
+
+            __batch_vertices.clear();
+            for (int row = first_row; row <= last_row; row++) {
+                for (int column = first_column; column <= last_column; column++) {
+                    uint32_t index = (uint32_t)(row * __chunk_columns + column);
+                    __chunk* chunk = __chunks[index].get();
+                    if (!chunk || !chunk->tile_count) continue;
+                    chunk->last_used_frame = __frame;
+                    if (!chunk->is_cached) { chunk->is_cached = true; __cached_chunks.push_back(index); }
+                    if (chunk->is_geometry_dirty) { __build_geometry(*chunk); chunk->is_texture_dirty = true; }
+                    if (chunk->vertices.empty()) continue;
+
+                    const float offset_x = column * chunk_width, offset_y = row * chunk_height;
+                    if (Prerender) {
+                        if (chunk->is_texture_dirty) __bake(*chunk);
+                        if (chunk->texture)
+                            Renderer::DrawTexture(transform, RectF(offset_x, offset_y, chunk_width, chunk_height), chunk->texture);
+                        continue;
+                    }
+                    size_t start = __batch_vertices.size();
+                    __batch_vertices.insert(__batch_vertices.end(), chunk->vertices.begin(), chunk->vertices.end());
+                    for (size_t i = start; i < __batch_vertices.size(); i++) {
+                        SDL_FPoint& position = __batch_vertices[i].position;
+                        float x = position.x + offset_x, y = position.y + offset_y;
+                        position.x = x * transform.M11 + y * transform.M21 + transform.M31;
+                        position.y = x * transform.M12 + y * transform.M22 + transform.M32;
+                    }
+                }
+            }
+            if (!__batch_vertices.empty()) {
+                __reserve_indices(__batch_vertices.size() / 4);
+                Renderer::DrawGeometry(Tileset, __batch_vertices.data(), (int)__batch_vertices.size(),
+                    __batch_indices.data(), (int)(__batch_vertices.size() / 4 * 6));
+            }
+            __trim_cache();
+        }
+    public:
+        /// @brief The tileset texture, the tiles are numbered from 1 (the top-left tile) left to right then top to bottom.
+        /// Default is nullptr mean nothing is drawn.
+        Texture* Tileset = nullptr;
+        /// @brief The size of a tile, in the tileset and on the map. Default is (16, 16).
+        Engine::Size TileSize = Engine::Size(16, 16);
+        /// @brief If this true, the chunks are drawn to textures once and the textures are drawn instead, which is faster
+        /// for dense maps that rarely change but use more memory. Default is false.
+        bool Prerender = false;
+        /// @brief The maximum number of chunks that keep their geometry (and texture) cached while not visible, the least
+        /// recently drawn are released first. Default is 256.
+        size_t MaxCachedChunks = 256;
+
+        /// @brief Create a new Tilemap Game Object.
+        /// @param Width The width of the map in tiles. Default is 0.
+        /// @param Height The height of the map in tiles. Default is 0.
+        TilemapGameObject(int Width = 0, int Height = 0) {
+            RenderBackground = false;
+            SetMapSize(Width, Height);
+        }
+        virtual ~TilemapGameObject() {}
+
+        ENGINE_NOT_COPYABLE(TilemapGameObject);
+        ENGINE_NOT_ASSIGNABLE(TilemapGameObject);
+
+        /// @brief Get the size of the map in tiles.
+        /// @return The size of the map.
+        Engine::Size GetMapSize() const { return Engine::Size(__width, __height); }
+        /// @brief Set the size of the map in tiles, all tiles are cleared. The Size of the Game Object is set to the size of
+        /// the map in pixels.
+        /// @param Width The width of the map in tiles.
+        /// @param Height The height of the map in tiles.
+        void SetMapSize(int Width, int Height) {
+            __width = ENGINE_MAX(0, Width); __height = ENGINE_MAX(0, Height);
+            __chunk_columns = (__width + ENGINE_TILEMAP_CHUNK_SIZE - 1) / ENGINE_TILEMAP_CHUNK_SIZE;
+            __chunk_rows = (__height + ENGINE_TILEMAP_CHUNK_SIZE - 1) / ENGINE_TILEMAP_CHUNK_SIZE;
+            __chunks.clear();
+            __chunks.resize((size_t)__chunk_columns * __chunk_rows);
+            __cached_chunks.clear();
+            Size = Engine::Size(__width * TileSize.Width, __height * TileSize.Height);
+        }
+
+        /// @brief Get the tile at the given position.
+        /// @param X The column of the tile.
+        /// @param Y The row of the tile.
+        /// @return The tile number (1 is the first tile of the tileset), or 0 if empty or out of range.
+        int GetTile(int X, int Y) const {
+            if (X < 0 || X >= __width || Y < 0 || Y >= __height) return 0;
+            const __chunk* chunk = __get_chunk(X, Y);
+            return chunk ? chunk->tiles[(Y % ENGINE_TILEMAP_CHUNK_SIZE) * ENGINE_TILEMAP_CHUNK_SIZE + X % ENGINE_TILEMAP_CHUNK_SIZE] : 0;
+        }
+        /// @brief Set the tile at the given position.
+        /// @param X The column of the tile, will not set if out of range.
+        /// @param Y The row of the tile, will not set if out of range.
+        /// @param Tile The tile number (1 is the first tile of the tileset), or 0 to clear the tile.
+        void SetTile(int X, int Y, int Tile) {
+            if (X < 0 || X >= __width || Y < 0 || Y >= __height) return;
+            Tile = ENGINE_FAST_CLAMP(0, 65535, Tile);
+            std::unique_ptr<__chunk>& chunk = __chunks[(size_t)(Y / ENGINE_TILEMAP_CHUNK_SIZE) * __chunk_columns + X / ENGINE_TILEMAP_CHUNK_SIZE];
+            if (!chunk) {
+                if (!Tile) return;
+                chunk.reset(new __chunk());
+            }
+            uint16_t& tile = chunk->tiles[(Y % ENGINE_TILEMAP_CHUNK_SIZE) * ENGINE_TILEMAP_CHUNK_SIZE + X % ENGINE_TILEMAP_CHUNK_SIZE];
+            if (tile == (uint16_t)Tile) return;
+            chunk->tile_count += (Tile != 0) - (tile != 0);
+            tile = (uint16_t)Tile;
+            chunk->is_geometry_dirty = chunk->is_texture_dirty = true;
+        }
+        /// @brief Set all tiles in the given area.
+        /// @param Area The area in tiles, clipped to the map.
+        /// @param Tile The tile number, or 0 to clear the tiles.
+        void Fill(const Rectangle& Area, int Tile) {
+            int left = ENGINE_MAX(0, ENGINE_MIN(Area.X, Area.X + Area.Width));
+            int top = ENGINE_MAX(0, ENGINE_MIN(Area.Y, Area.Y + Area.Height));
+            int right = ENGINE_MIN(__width, ENGINE_MAX(Area.X, Area.X + Area.Width));
+            int bottom = ENGINE_MIN(__height, ENGINE_MAX(Area.Y, Area.Y + Area.Height));
+            for (int y = top; y < bottom; y++)
+                for (int x = left; x < right; x++) SetTile(x, y, Tile);
+        }
+        /// @brief Clear all tiles of the map.
+        void Clear() {
+            for (auto& chunk : __chunks) chunk.reset();
+            __cached_chunks.clear();
+        }
+        /// @brief Get the tile position at the given position in the local space (relative to the top-left corner of the
+        /// Game Object).
+        /// @param LocalPosition The position in the local space.
+        /// @return The column and row of the tile (may be out of range).
+        Point GetTilePosition(const Vec2f& LocalPosition) const {
+            if (TileSize.IsEmptyArea()) return Point::Zero;
+            return Point((int)floorf(LocalPosition.X / abs(TileSize.Width)), (int)floorf(LocalPosition.Y / abs(TileSize.Height)));
+        }
+    };
+}
+
+#endif // __ENGINE_TILEMAP_H__
\ No newline at end of file
@@ -0,0 +1,280 @@
+#ifndef __ENGINE_TIMER_H__
+#define __ENGINE_TIMER_H__
+
+#include "Engine_Define.h"
+
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+
+// The number of ticks per second of the time-based timers (the resolution of the timing wheel).
+#define ENGINE_TIMER_TICKS_PER_SECOND 1000
+// The number of levels of the timing wheel, each level have 256 slots.
+#define ENGINE_TIMER_LEVEL_COUNT 4
+
+namespace Engine {
+    /// @brief The ID of a timer created by the Timer class, 0 mean invalid.
+    typedef uint64_t TimerID;
+
+    /// @brief The Timer class, provide a central service for one-shot, repeating and frame-based timers. The timers are
+    /// kept in hierarchical timing wheels (one counted in ticks of time, one counted in frames), so scheduling and
+    /// cancelling are O(1) and only the expired timers do work on each frame. All timers are updated by
+    /// Application::Start() before the Update event, and their callbacks are called on the main thread.
+    /// @note A timer callback that capture a raw pointer should be cancelled (Cancel()) before the pointer is destroyed.
+    class Timer final {
+    private:
+        struct __node {
+            std::function<void()> callback = nullptr;
+            double deadline = 0, interval = 0;
+            uint64_t expire = 0, period = 0;
+            int32_t previous = -1, next = -1;
+            int32_t slot = -1;
+            uint32_t generation = 0;
+            uint8_t wheel = 0;
+            bool is_active = false;
+        };
+        struct __wheel {
+            uint64_t current = 0;
+            size_t count = 0;
+            int32_t heads[ENGINE_TIMER_LEVEL_COUNT * 256];
+
+            __wheel() { for (int32_t& head : heads) head = -1; }
+        };
+        struct __expired {
+            uint32_t index, generation;
+        };
+
+        // A deque so the nodes stay in place while a callback schedule new timers.
+        static std::deque<__node> __nodes;
+        static std::vector<uint32_t> __free_nodes;
+        static std::vector<__expired> __expired_nodes;
+        static __wheel __wheels[2];
+        static double __time;
+        static uint64_t __frame;
+
+        static __node* __get_node(TimerID id) {
+            uint32_t index = (uint32_t)(id & 0xFFFFFFFF);
+            if (index == 0 || index > Timer::__nodes.size()) return nullptr;
+            __node& res = Timer::__nodes[index - 1];
+            if (!res.is_active || res.generation != (uint32_t)(id >> 32)) return nullptr;
+            return &res;
+        }
+        /// @brief Link the given node to the slot of its expire tick. Only the cascaded nodes can expire on the current
+        /// tick (its slot is not called yet), the others expire on the next tick at least.
+        static void __link(uint32_t index, bool is_cascade = false) {
+            __node& node = Timer::__nodes[index];
+            __wheel& wheel = Timer::__wheels[node.wheel];
+            if (node.expire < wheel.current + (is_cascade ? 0 : 1)) node.expire = wheel.current + (is_cascade ? 0 : 1);
+            uint64_t delta = node.expire - wheel.current;
+            // Further than the wheels can hold, park in the last level and check again when cascaded.
+            const uint64_t range = (uint64_t)1 << (8 * ENGINE_TIMER_LEVEL_COUNT);
+            uint64_t expire = delta < range ? node.expire : wheel.current + range - 1;
+            int level = 0;
+            while (level < ENGINE_TIMER_LEVEL_COUNT - 1 && (delta >> (8 * (level + 1))) != 0) level++;
+            int32_t slot = level * 256 + (int32_t)((expire >> (8 * level)) & 255);
+
+            node.slot = slot;
+            node.previous = -1;
+            node.next = wheel.heads[slot];
+            if (node.next >= 0) Timer::__nodes[node.next].previous = (int32_t)index;
+            wheel.heads[slot] = (int32_t)index;
+            wheel.count++;
+        }
+        static void __unlink(uint32_t index) {
+            __node& node = Timer::__nodes[index];
+            if (node.slot < 0) return;
+            __wheel& wheel = Timer::__wheels[node.wheel];
+            if (node.previous >= 0) Timer::__nodes[node.previous].next = node.next;
+            else wheel.heads[node.slot] = node.next;
+            if (node.next >= 0) Timer::__nodes[node.next].previous = node.previous;
+            node.slot = -1; node.previous = node.next = -1;
+            wheel.count--;
+        }
+        static void __free(uint32_t index) {
+            __unlink(index);
+            __node& node = Timer::__nodes[index];
+            node.is_active = false;
+            node.generation++;
+            node.callback = nullptr;
+            Timer::__free_nodes.push_back(index);
+        }
+        static TimerID __create(uint8_t wheel, double deadline, double interval, uint64_t expire, uint64_t period,
+                                const std::function<void()>& callback) {
+            if (!callback) return 0;
+            uint32_t index;
+            if (!Timer::__free_nodes.empty()) { index = Timer::__free_nodes.back(); Timer::__free_nodes.pop_back(); }
+            else { index = (uint32_t)Timer::__nodes.size(); Timer::__nodes.emplace_back(); }
+
+            __node& node = Timer::__nodes[index];
+            node.callback = callback;
+            node.wheel = wheel;
+            node.deadline = deadline; node.interval = interval;
+            node.expire = expire; node.period = period;
+            node.is_active = true;
+            __link(index);
+            return ((TimerID)node.generation << 32) | (TimerID)(index + 1);
+        }
+        static TimerID __create_timed(double delay, double interval, const std::function<void()>& callback) {
+            double deadline = Timer::__time + ENGINE_MAX(0.0, delay);
+            return __create(0, deadline, interval, (uint64_t)std::floor(deadline * ENGINE_TIMER_TICKS_PER_SECOND), 0, callback);
+        }
+        /// @brief Advance the given wheel to the given tick, and call the expired timers.
+        static void __advance(uint8_t wheel_index, uint64_t target) {
+            __wheel& wheel = Timer::__wheels[wheel_index];
+            while (wheel.current < target) {
+                if (wheel.count == 0) { wheel.current = target; break; }
+                wheel.current++;
+                // Move the timers of the next slot of the upper levels down, when the lower level wrap around.
+                for (int level = 1; level < ENGINE_TIMER_LEVEL_COUNT; level++) {
+                    if ((wheel.current >> (8 * (level - 1))) & 255) break;
+                    int32_t slot = level * 256 + (int32_t)((wheel.current >> (8 * level)) & 255);
+                    int32_t index = wheel.heads[slot];
+                    while (index >= 0) {
+                        int32_t next = Timer::__nodes[index].next;
+                        __unlink((uint32_t)index);
+                        __link((uint32_t)index, true);
+                        index = next;
+                    }
+                }
+
+                int32_t slot = (int32_t)(wheel.current & 255);
+                Timer::__expired_nodes.clear();
+                for (int32_t index = wheel.heads[slot]; index >= 0; ) {
+                    int32_t next = Timer::__nodes[index].next;
+                    __unlink((uint32_t)index);
+                    Timer::__expired_nodes.push_back(__expired{ (uint32_t)index, Timer::__nodes[index].generation });
+                    index = next;
+                }
+                for (size_t i = 0; i < Timer::__expired_nodes.size(); i++) {
+                    __expired expired = Timer::__expired_nodes[i];
+                    __node& node = Timer::__nodes[expired.index];
+                    // Cancelled (or cancelled and reused) by a callback before.
+                    if (!node.is_active || node.generation != expired.generation || node.slot >= 0) continue;
+                    // Parked too far, or rounded down into this tick.
+                    if (node.expire > wheel.current || (node.wheel == 0 && node.deadline > Timer::__time)) {
+                        __link(expired.index);
+                        continue;
+                    }
+                    std::function<void()> callback = std::move(node.callback);
+                    if (node.period > 0 || node.interval > 0) {
+                        if (node.wheel == 0) {
+                            // Skip the intervals missed by a long frame, instead of calling many times at once.
+                            node.deadline += node.interval;
+                            if (node.deadline <= Timer::__time)
+                                node.deadline += node.interval * (std::floor((Timer::__time - node.deadline) / node.interval) + 1);
+                            node.expire = (uint64_t)std::floor(node.deadline * ENGINE_TIMER_TICKS_PER_SECOND);
+                        }
+                        else node.expire = wheel.current + node.period;
+                        __link(expired.index);
+                        callback();
+                        // Give the callback back, unless the timer is cancelled by it.
+                        __node& repeated = Timer::__nodes[expired.index];
+                        if (repeated.is_active && repeated.generation == expired.generation)
+                            repeated.callback = std::move(callback);
+                    }
+                    else {
+                        __free(expired.index);
+                        callback();
+                    }
+                }
+            }
+        }
+    public:
+        /// @brief Call the given callback once after the given time.
+        /// @param Delay The time to wait in seconds, will clamped to be non-negative.
+        /// @param Callback The callback to call.
+        /// @return The ID of the timer, or 0 on failed (the callback is empty).
+        static TimerID After(double Delay, const std::function<void()>& Callback) {
+            return __create_timed(Delay, 0, Callback);
+        }
+        /// @brief Call the given callback repeatedly, on every given interval of time. It's called at most once per frame,
+        /// the intervals missed by a long frame are skipped.
+        /// @param Interval The interval in seconds, will clamped to be at least one tick (1 / ENGINE_TIMER_TICKS_PER_SECOND).
+        /// @param Callback The callback to call.
+        /// @param Delay The time to wait before the first call in seconds, or negative (default) to wait one interval.
+        /// @return The ID of the timer, or 0 on failed (the callback is empty).
+        static TimerID Every(double Interval, const std::function<void()>& Callback, double Delay = -1) {
+            Interval = ENGINE_MAX(1.0 / ENGINE_TIMER_TICKS_PER_SECOND, Interval);
+            return __create_timed(Delay < 0 ? Interval : Delay, Interval, Callback);
+        }
+        /// @brief Call the given callback once after the given number of frames.
+        /// @param Frames The number of frames to wait, will clamped to be at least 1 (the next frame).
+        /// @param Callback The callback to call.
+        /// @return The ID of the timer, or 0 on failed (the callback is empty).
+        static TimerID AfterFrames(uint64_t Frames, const std::function<void()>& Callback) {
+            return __create(1, 0, 0, Timer::__frame + ENGINE_MAX((uint64_t)1, Frames), 0, Callback);
+        }
+        /// @brief Call the given callback repeatedly, on every given number of frames.
+        /// @param Frames The number of frames between the calls, will clamped to be at least 1 (every frame).
+        /// @param Callback The callback to call.
+        /// @return The ID of the timer, or 0 on failed (the callback is empty).
+        static TimerID EveryFrames(uint64_t Frames, const std::function<void()>& Callback) {
+            Frames = ENGINE_MAX((uint64_t)1, Frames);
+            return __create(1, 0, 0, Timer::__frame + Frames, Frames, Callback);
+        }
+
+        /// @brief Cancel the given timer, its callback will not be called again.
+        /// @param ID The ID of the timer.
+        /// @return true if the timer is cancelled, false if not found (already expired or cancelled).
+        static bool Cancel(TimerID ID) {
+            if (!__get_node(ID)) return false;
+            __free((uint32_t)(ID & 0xFFFFFFFF) - 1);
+            return true;
+        }
+        /// @brief Check if the given timer is scheduled (not expired or cancelled).
+        /// @param ID The ID of the timer.
+        /// @return true if the timer is scheduled, false otherwise.
+        static bool IsScheduled(TimerID ID) { return __get_node(ID) != nullptr; }
+        /// @brief Get the time left before the next call of the given time-based timer.
+        /// @param ID The ID of the timer.
+        /// @return The time left in seconds, or -1 if the timer is not found or frame-based.
+        static double GetRemainingTime(TimerID ID) {
+            __node* node = __get_node(ID);
+            if (!node || node->wheel != 0) return -1;
+            return ENGINE_MAX(0.0, node->deadline - Timer::__time);
+        }
+        /// @brief Get the number of frames left before the next call of the given frame-based timer.
+        /// @param ID The ID of the timer.
+        /// @return The number of frames left, or -1 if the timer is not found or time-based.
+        static int64_t GetRemainingFrames(TimerID ID) {
+            __node* node = __get_node(ID);
+            if (!node || node->wheel != 1) return -1;
+            return (int64_t)(node->expire - Timer::__wheels[1].current);
+        }
+        /// @brief Get the number of scheduled timers.
+        /// @return The number of scheduled timers.
+        static size_t GetCount() { return Timer::__nodes.size() - Timer::__free_nodes.size(); }
+        /// @brief Get the time of the Timer clock, the sum of all delta times given to Update().
+        /// @return The time in seconds.
+        static double GetTime() { return Timer::__time; }
+        /// @brief Get the number of frames updated by the Timer.
+        /// @return The number of frames.
+        static uint64_t GetFrame() { return Timer::__frame; }
+
+        /// @brief Advance the Timer clock by the given time and one frame, and call the expired timers. This is called by
+        /// Application::Start() on every frame.
+        /// @param DeltaTime The time since the last update in seconds.
+        static void Update(double DeltaTime) {
+            Timer::__time += ENGINE_MAX(0.0, DeltaTime);
+            Timer::__frame++;
+            __advance(0, (uint64_t)std::floor(Timer::__time * ENGINE_TIMER_TICKS_PER_SECOND));
+            __advance(1, Timer::__frame);
+        }
+        /// @brief Cancel all timers. This will be called on Engine::Deinitialize()
+        static void CancelAll() {
+            for (uint32_t i = 0; i < (uint32_t)Timer::__nodes.size(); i++)
+                if (Timer::__nodes[i].is_active) __free(i);
+        }
+    };
+}
+
+std::deque<Engine::Timer::__node> Engine::Timer::__nodes = std::deque<Engine::Timer::__node>();
+std::vector<uint32_t> Engine::Timer::__free_nodes = std::vector<uint32_t>();
+std::vector<Engine::Timer::__expired> Engine::Timer::__expired_nodes = std::vector<Engine::Timer::__expired>();
+Engine::Timer::__wheel Engine::Timer::__wheels[2] = {};
+double Engine::Timer::__time = 0;
+uint64_t Engine::Timer::__frame = 0;
+
+#endif // __ENGINE_TIMER_H__
\ No newline at end of file
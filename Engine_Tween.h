@@ -0,0 +1,349 @@
+#ifndef __ENGINE_TWEEN_H__
+#define __ENGINE_TWEEN_H__
+
+#include "Engine_GameObject.h"
+#include "Engine_Math.h"
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// The number of Interpolation Function groups of the Tween engine.
+#define ENGINE_TWEEN_GROUP_COUNT ENGINE_INTERPOLATION_FUNCTION_COUNT
+
+namespace Engine {
+    /// @brief The ID of a tween created by the Tween class, 0 mean invalid.
+    typedef uint64_t TweenID;
+
+    /// @brief The Tween class, provide a central engine to animate the Position, Size and colors of many Game Objects at
+    /// once. The tweens are stored in SoA arrays grouped by Interpolation Function, and all of them are advanced in one pass
+    /// per frame (the per-tween work is a few tight loops over plain float arrays, the easing curve is resolved once per
+    /// group). Completed tweens are recycled, the arrays are never shrunk. All tweens are updated by Application::Start()
+    /// after the Update event, before updating the Game Scene.
+    /// @note The tween keep a raw pointer to its target, so cancel the tweens of a Game Object (CancelTweensOf()) before
+    /// destroying it.
+    class Tween final {
+    private:
+        enum class __kind : uint8_t { Position, Size, Color };
+
+        // Each tween animate up to 4 channels (X and Y, Width and Height, or Red, Green, Blue and Alpha).
+        struct __group {
+            std::vector<float> time, delay, inverse_duration, progress;
+            std::vector<float> start[4], delta[4], value[4];
+            std::vector<void*> target;
+            std::vector<GameObject*> owner;
+            std::vector<__kind> kind;
+            std::vector<uint32_t> slot;
+
+            size_t size() const { return time.size(); }
+        };
+        struct __slot {
+            uint32_t generation = 0;
+            int group = -1;
+            uint32_t index = 0;
+            std::function<void()> complete_action = nullptr;
+        };
+
+        static __group __groups[ENGINE_TWEEN_GROUP_COUNT];
+        static std::vector<__slot> __slots;
+        static std::vector<uint32_t> __free_slots;
+        static std::vector<TweenID> __completed;
+
+        static __slot* __get_slot(TweenID id) {
+            uint32_t slot = (uint32_t)(id & 0xFFFFFFFF);
+            if (slot == 0 || slot > Tween::__slots.size()) return nullptr;
+            __slot& res = Tween::__slots[slot - 1];
+            if (res.group < 0 || res.generation != (uint32_t)(id >> 32)) return nullptr;
+            return &res;
+        }
+        static TweenID __create(__kind kind, void* target, GameObject* owner, const float* start, const float* end,
+                                double duration, InterpolationFunction function, double delay) {
+            if (!target) return 0;
+            int group_index = (int)function;
+            if (group_index < 0 || group_index >= ENGINE_TWEEN_GROUP_COUNT) group_index = (int)InterpolationFunction::Linear;
+
+            uint32_t slot;
+            if (!Tween::__free_slots.empty()) { slot = Tween::__free_slots.back(); Tween::__free_slots.pop_back(); }
+            else { slot = (uint32_t)Tween::__slots.size(); Tween::__slots.emplace_back(); }
+
+            __group& group = Tween::__groups[group_index];
+            Tween::__slots[slot].group = group_index;
+            Tween::__slots[slot].index = (uint32_t)group.size();
+
+            group.time.push_back(0.0f);
+            group.delay.push_back((float)ENGINE_MAX(0.0, delay));
+            group.inverse_duration.push_back((float)(1.0 / ENGINE_MAX(0.001, duration)));
+            group.progress.push_back(0.0f);
+            for (int c = 0; c < 4; c++) {
+                group.start[c].push_back(start[c]);
+                group.delta[c].push_back(end[c] - start[c]);
+                group.value[c].push_back(start[c]);
+            }
+            group.target.push_back(target);
+            group.owner.push_back(owner);
+            group.kind.push_back(kind);
+            group.slot.push_back(slot);
+
+            return ((TweenID)Tween::__slots[slot].generation << 32) | (TweenID)(slot + 1);
+        }
+        /// @brief Remove the tween at the given index of the given group (swap with the last), and recycle its slot.
+        static void __remove(int group_index, uint32_t index) {
+            __group& group = Tween::__groups[group_index];
+            uint32_t last = (uint32_t)group.size() - 1;
+            uint32_t slot = group.slot[index];
+            if (index != last) {
+                group.time[index] = group.time[last];
+                group.delay[index] = group.delay[last];
+                group.inverse_duration[index] = group.inverse_duration[last];
+                group.progress[index] = group.progress[last];
+                for (int c = 0; c < 4; c++) {
+                    group.start[c][index] = group.start[c][last];
+                    group.delta[c][index] = group.delta[c][last];
+                    group.value[c][index] = group.value[c][last];
+                }
+                group.target[index] = group.target[last];
+                group.owner[index] = group.owner[last];
+                group.kind[index] = group.kind[last];
+                group.slot[index] = group.slot[last];
+                Tween::__slots[group.slot[index]].index = index;
+            }
+            group.time.pop_back(); group.delay.pop_back(); group.inverse_duration.pop_back(); group.progress.pop_back();
+            for (int c = 0; c < 4; c++) { group.start[c].pop_back(); group.delta[c].pop_back(); group.value[c].pop_back(); }
+            group.target.pop_back(); group.owner.pop_back(); group.kind.pop_back(); group.slot.pop_back();
+
+            __slot& removed = Tween::__slots[slot];
+            removed.group = -1;
+            removed.generation++;
+            removed.complete_action = nullptr;
+            Tween::__free_slots.push_back(slot);
+        }
+        /// @brief Write the current values of the tween at the given index of the given group to its target.
+        static void __write(const __group& group, size_t i) {
+            switch (group.kind[i])
+            {
+            case __kind::Position: {
+                // Written through the owner, so the fraction goes to the PositionOffset for smooth movement.
+                group.owner[i]->SetPrecisePosition(Vec2f(group.value[0][i], group.value[1][i]));
+                break;
+            }
+            case __kind::Size: {
+                Engine::Size* size = (Engine::Size*)group.target[i];
+                size->Width = (int)std::floor(group.value[0][i] + 0.5f);
+                size->Height = (int)std::floor(group.value[1][i] + 0.5f);
+                break;
+            }
+            case __kind::Color: {
+                Engine::Color* color = (Engine::Color*)group.target[i];
+                color->Red = (uint8_t)ENGINE_FAST_CLAMP(0.0f, 255.0f, group.value[0][i] + 0.5f);
+                color->Green = (uint8_t)ENGINE_FAST_CLAMP(0.0f, 255.0f, group.value[1][i] + 0.5f);
+                color->Blue = (uint8_t)ENGINE_FAST_CLAMP(0.0f, 255.0f, group.value[2][i] + 0.5f);
+                color->Alpha = (uint8_t)ENGINE_FAST_CLAMP(0.0f, 255.0f, group.value[3][i] + 0.5f);
+                break;
+            }
+            }
+        }
+    public:
+        /// @brief Animate the Position of the given Game Object from its current Position to the given position.
+        /// @param Target The target Game Object.
+        /// @param End The end position.
+        /// @param Duration The duration in seconds, will clamped to be at least 0.001.
+        /// @param Function The Interpolation Function. Default is Linear.
+        /// @param Delay The time in seconds to wait before animating. Default is 0.
+        /// @return The ID of the created tween, or 0 on failed (the target is null).
+        static TweenID MoveTo(GameObject* Target, const Point& End, double Duration,
+                              InterpolationFunction Function = InterpolationFunction::Linear, double Delay = 0) {
+            if (!Target) return 0;
+            return Move(Target, Target->Position, End, Duration, Function, Delay);
+        }
+        /// @brief Animate the Position of the given Game Object from the given start position to the given end position.
+        /// @param Target The target Game Object.
+        /// @param Start The start position.
+        /// @param End The end position.
+        /// @param Duration The duration in seconds, will clamped to be at least 0.001.
+        /// @param Function The Interpolation Function. Default is Linear.
+        /// @param Delay The time in seconds to wait before animating. Default is 0.
+        /// @return The ID of the created tween, or 0 on failed (the target is null).
+        static TweenID Move(GameObject* Target, const Point& Start, const Point& End, double Duration,
+                            InterpolationFunction Function = InterpolationFunction::Linear, double Delay = 0) {
+            if (!Target) return 0;
+            float start[4] = { (float)Start.X, (float)Start.Y, 0.0f, 0.0f };
+            float end[4] = { (float)End.X, (float)End.Y, 0.0f, 0.0f };
+            return __create(__kind::Position, &Target->Position, Target, start, end, Duration, Function, Delay);
+        }
+        /// @brief Animate the Size of the given Game Object from its current Size to the given size.
+        /// @param Target The target Game Object.
+        /// @param End The end size.
+        /// @param Duration The duration in seconds, will clamped to be at least 0.001.
+        /// @param Function The Interpolation Function. Default is Linear.
+        /// @param Delay The time in seconds to wait before animating. Default is 0.
+        /// @return The ID of the created tween, or 0 on failed (the target is null).
+        static TweenID ResizeTo(GameObject* Target, const Engine::Size& End, double Duration,
+                                InterpolationFunction Function = InterpolationFunction::Linear, double Delay = 0) {
+            if (!Target) return 0;
+            return Resize(Target, Target->Size, End, Duration, Function, Delay);
+        }
+        /// @brief Animate the Size of the given Game Object from the given start size to the given end size.
+        /// @param Target The target Game Object.
+        /// @param Start The start size.
+        /// @param End The end size.
+        /// @param Duration The duration in seconds, will clamped to be at least 0.001.
+        /// @param Function The Interpolation Function. Default is Linear.
+        /// @param Delay The time in seconds to wait before animating. Default is 0.
+        /// @return The ID of the created tween, or 0 on failed (the target is null).
+        static TweenID Resize(GameObject* Target, const Engine::Size& Start, const Engine::Size& End, double Duration,
+                              InterpolationFunction Function = InterpolationFunction::Linear, double Delay = 0) {
+            if (!Target) return 0;
+            float start[4] = { (float)Start.Width, (float)Start.Height, 0.0f, 0.0f };
+            float end[4] = { (float)End.Width, (float)End.Height, 0.0f, 0.0f };
+            return __create(__kind::Size, &Target->Size, Target, start, end, Duration, Function, Delay);
+        }
+        /// @brief Animate the BackgroundColor of the given Game Object from its current color to the given color.
+        /// @param Target The target Game Object.
+        /// @param End The end color.
+        /// @param Duration The duration in seconds, will clamped to be at least 0.001.
+        /// @param Function The Interpolation Function. Default is Linear.
+        /// @param Delay The time in seconds to wait before animating. Default is 0.
+        /// @return The ID of the created tween, or 0 on failed (the target is null).
+        static TweenID BackgroundColorTo(GameObject* Target, const Engine::Color& End, double Duration,
+                                         InterpolationFunction Function = InterpolationFunction::Linear, double Delay = 0) {
+            if (!Target) return 0;
+            return ColorTo(&Target->BackgroundColor, End, Duration, Function, Delay, Target);
+        }
+        /// @brief Animate the given color (e.g. the ForegroundColor of a Label Game Object) from its current value to the
+        /// given color.
+        /// @param Target The target color.
+        /// @param End The end color.
+        /// @param Duration The duration in seconds, will clamped to be at least 0.001.
+        /// @param Function The Interpolation Function. Default is Linear.
+        /// @param Delay The time in seconds to wait before animating. Default is 0.
+        /// @param Owner The Game Object that own the color, used by CancelTweensOf(). Default is nullptr.
+        /// @return The ID of the created tween, or 0 on failed (the target is null).
+        static TweenID ColorTo(Engine::Color* Target, const Engine::Color& End, double Duration,
+                               InterpolationFunction Function = InterpolationFunction::Linear, double Delay = 0,
+                               GameObject* Owner = nullptr) {
+            if (!Target) return 0;
+            float start[4] = { (float)Target->Red, (float)Target->Green, (float)Target->Blue, (float)Target->Alpha };
+            float end[4] = { (float)End.Red, (float)End.Green, (float)End.Blue, (float)End.Alpha };
+            return __create(__kind::Color, Target, Owner, start, end, Duration, Function, Delay);
+        }
+
+        /// @brief Set the action to execute when the given tween is completed (not when it's cancelled). The action may
+        /// create new tweens.
+        /// @param ID The ID of the tween.
+        /// @param Action The action to set.
+        /// @return true on success, false if the tween isn't active.
+        static bool SetCompleteAction(TweenID ID, const std::function<void()>& Action) {
+            __slot* slot = __get_slot(ID);
+            if (!slot) return false;
+            slot->complete_action = Action;
+            return true;
+        }
+        /// @brief Check if the given tween is active (not completed or cancelled).
+        /// @param ID The ID of the tween.
+        /// @return true if the tween is active, false otherwise.
+        static bool IsActive(TweenID ID) { return __get_slot(ID) != nullptr; }
+        /// @brief Cancel the given tween, the target is left at its current value.
+        /// @param ID The ID of the tween.
+        /// @return true on success, false if the tween isn't active.
+        static bool Cancel(TweenID ID) {
+            __slot* slot = __get_slot(ID);
+            if (!slot) return false;
+            __remove(slot->group, slot->index);
+            return true;
+        }
+        /// @brief Cancel all tweens of the given Game Object (include its BackgroundColor and the colors created with it
+        /// as the owner). This is a linear scan over all tweens.
+        /// @param Target The Game Object.
+        /// @return The number of tweens cancelled.
+        static size_t CancelTweensOf(GameObject* Target) {
+            if (!Target) return 0;
+            size_t count = 0;
+            for (int g = 0; g < ENGINE_TWEEN_GROUP_COUNT; g++) {
+                __group& group = Tween::__groups[g];
+                for (size_t i = group.size(); i-- > 0;)
+                    if (group.owner[i] == Target) { __remove(g, (uint32_t)i); count++; }
+            }
+            return count;
+        }
+        /// @brief Cancel all tweens. This is called on Engine::Deinitialize().
+        static void CancelAll() {
+            for (int g = 0; g < ENGINE_TWEEN_GROUP_COUNT; g++)
+                while (Tween::__groups[g].size() > 0)
+                    __remove(g, (uint32_t)Tween::__groups[g].size() - 1);
+        }
+        /// @brief Get the number of active tweens.
+        /// @return The number of active tweens.
+        static size_t GetActiveCount() {
+            size_t count = 0;
+            for (int g = 0; g < ENGINE_TWEEN_GROUP_COUNT; g++) count += Tween::__groups[g].size();
+            return count;
+        }
+        /// @brief Reserve the storage for the given number of tweens per Interpolation Function, so creating them doesn't
+        /// allocate.
+        /// @param Count The number of tweens to reserve.
+        static void Reserve(size_t Count) {
+            for (__group& group : Tween::__groups) {
+                group.time.reserve(Count); group.delay.reserve(Count); group.inverse_duration.reserve(Count);
+                group.progress.reserve(Count);
+                for (int c = 0; c < 4; c++) { group.start[c].reserve(Count); group.delta[c].reserve(Count); group.value[c].reserve(Count); }
+                group.target.reserve(Count); group.owner.reserve(Count); group.kind.reserve(Count); group.slot.reserve(Count);
+            }
+            Tween::__slots.reserve(Count * ENGINE_TWEEN_GROUP_COUNT);
+        }
+
+        /// @brief Advance all tweens by the given time, write the values to their targets, and complete the finished ones.
+        /// This is called by Application::Start() on each frame.
+        /// @param DeltaTime The time in seconds to advance.
+        static void UpdateAll(double DeltaTime) {
+            float dt = (float)DeltaTime;
+            for (int g = 0; g < ENGINE_TWEEN_GROUP_COUNT; g++) {
+                __group& group = Tween::__groups[g];
+                size_t count = group.size();
+                if (count == 0) continue;
+
+                float* time = group.time.data();
+                const float* delay = group.delay.data();
+                const float* inverse_duration = group.inverse_duration.data();
+                float* p = group.progress.data();
+                for (size_t i = 0; i < count; i++) {
+                    time[i] += dt;
+                    float x = (time[i] - delay[i]) * inverse_duration[i];
+                    p[i] = ENGINE_FAST_CLAMP(0.0f, 1.0f, x);
+                }
+                Easing::Evaluate((InterpolationFunction)g, p, count);
+                for (int c = 0; c < 4; c++) {
+                    const float* start = group.start[c].data();
+                    const float* delta = group.delta[c].data();
+                    float* value = group.value[c].data();
+                    for (size_t i = 0; i < count; i++) value[i] = start[i] + delta[i] * p[i];
+                }
+
+                for (size_t i = 0; i < count; i++) {
+                    if (time[i] < delay[i]) continue;
+                    __write(group, i);
+                    if ((time[i] - delay[i]) * inverse_duration[i] >= 1.0f)
+                        Tween::__completed.push_back(((TweenID)Tween::__slots[group.slot[i]].generation << 32) | (TweenID)(group.slot[i] + 1));
+                }
+            }
+
+            // Complete after the pass, so the complete actions can create new tweens safely. An action may cancel a
+            // completed tween later in the list (and its slot may be reused), so each one is checked again.
+            for (size_t i = 0; i < Tween::__completed.size(); i++) {
+                __slot* completed = __get_slot(Tween::__completed[i]);
+                if (!completed) continue;
+                std::function<void()> action = std::move(completed->complete_action);
+                __remove(completed->group, completed->index);
+                if (action) action();
+            }
+            Tween::__completed.clear();
+        }
+    };
+}
+
+Engine::Tween::__group Engine::Tween::__groups[ENGINE_TWEEN_GROUP_COUNT];
+std::vector<Engine::Tween::__slot> Engine::Tween::__slots = std::vector<Engine::Tween::__slot>();
+std::vector<uint32_t> Engine::Tween::__free_slots = std::vector<uint32_t>();
+std::vector<Engine::TweenID> Engine::Tween::__completed = std::vector<Engine::TweenID>();
+
+#endif // __ENGINE_TWEEN_H__
\ No newline at end of file
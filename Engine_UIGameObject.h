@@ -3,6 +3,14 @@
 
 #include "Engine_GameObject.h"
 #include "Engine_Font.h"
+#include "Engine_Input.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace Engine {
     /// @brief The Label Game Object, provide a game object that can be treated as an label.
@@ -11,9 +19,9 @@ namespace Engine {
         void OnRender(Engine::RenderEventArgs* args) override {
             if (!Text.empty() && Font) {
                 if (Multiline)
-                    Font->RenderMultiline(Text, args->TargetArea.TopLeft(), ForegroundColor);
+                    Font->RenderMultiline(Text, args->Transform, Point::Zero, ForegroundColor);
                 else
-                    Font->RenderSingleLine(Text, args->TargetArea.TopLeft(), ForegroundColor);
+                    Font->RenderSingleLine(Text, args->Transform, Point::Zero, ForegroundColor);
             }
         }
     public:
@@ -49,9 +57,10 @@ namespace Engine {
         }
         void OnRender(Engine::RenderEventArgs* args) override {
             GameObject::OnRender(args);
-            if (__text_texture) {
+            if (__text_texture && __text_texture->IsAvaliable()) {
+                Engine::Size tex_size = __text_texture->GetSize();
                 __text_texture->SetColorMod(ForegroundColor);
-                Renderer::DrawTextureUnscaled(args->TargetArea, __text_texture);
+                Renderer::DrawTexture(args->Transform, RectF(0.0f, 0.0f, (float)tex_size.Width, (float)tex_size.Height), __text_texture);
                 __text_texture->SetColorMod(KnownColor::White);
             }
         }
@@ -105,12 +114,12 @@ namespace Engine {
             if (Checked) {
                 if (!CheckedTexture) return;
                 if (!CheckedTexture->IsAvaliable()) return;
-                Renderer::DrawTexture(args->TargetArea, CheckedTexture);
+                Renderer::DrawTexture(args->Transform, args->GetLocalArea(), CheckedTexture);
             }
             else {
                 if (!UncheckedTexture) return;
                 if (!UncheckedTexture->IsAvaliable()) return;
-                Renderer::DrawTexture(args->TargetArea, UncheckedTexture);
+                Renderer::DrawTexture(args->Transform, args->GetLocalArea(), UncheckedTexture);
             }
         }
         
@@ -168,16 +177,16 @@ namespace Engine {
                 if (__clicked && ClickedTexture) {
                     if (ClickedTexture->IsAvaliable()) {
                         Renderer::SetDrawColor(BackgroundColor);
-                        Renderer::FillRectangle(args->TargetArea);
-                        Renderer::DrawTexture(args->TargetArea, ClickedTexture);
+                        Renderer::FillRectangle(args->Transform, args->GetLocalArea());
+                        Renderer::DrawTexture(args->Transform, args->GetLocalArea(), ClickedTexture);
                         return;
                     }
                 }
                 if (__hovered && HoveredTexture) {
                     if (HoveredTexture->IsAvaliable()) {
                         Renderer::SetDrawColor(BackgroundColor);
-                        Renderer::FillRectangle(args->TargetArea);
-                        Renderer::DrawTexture(args->TargetArea, HoveredTexture);
+                        Renderer::FillRectangle(args->Transform, args->GetLocalArea());
+                        Renderer::DrawTexture(args->Transform, args->GetLocalArea(), HoveredTexture);
                         return;
                     }
                 }
@@ -216,6 +225,577 @@ namespace Engine {
         /// @brief The Mouse Enter Event, occurred when the mouse enter the button area.
         GameObjectMouseMotionEventCaller MouseEnterEvent;
     };
+    /// @brief The Text Box Game Object, provide a game object that can be treated as an editable text box. The text is stored
+    /// in a gap buffer and laid out per line with cached character offsets, an edit only relayout the lines it touches, so
+    /// editing or appending to a large text (e.g. a log) doesn't relayout the whole text. Only the visible lines are rendered.
+    /// The text is treated as UTF-8, it's laid out and rendered by code point (see Font::GetGlyphTexture()), and the cursor
+    /// and the selection never split a multibyte character. The text is input with the SDL text input
+    /// (Keys::StartTextInput()) while the Text Box is focused, include the IME composition.
+    class TextBoxGameObject : public GameObject {
+    private:
+        struct __line {
+            // The index in the text of the first character of the line.
+            size_t start = 0;
+            // The x offset of each byte of the line, the first is always 0 and the last is the line width. A multibyte
+            // character advance on it first byte, so the offset of it continuation bytes is the one of the next character.
+            std::vector<int> offsets = std::vector<int>(1, 0);
+
+            size_t length() const { return offsets.size() - 1; }
+        };
+
+        std::vector<char> __buffer = std::vector<char>(64);
+        size_t __gap_start = 0, __gap_end = 64;
+        std::vector<__line> __lines = std::vector<__line>(1);
+
+        Engine::Font* __layout_font = nullptr;
+        int __layout_spacing = 0;
+        int __char_widths[128];
+        std::unordered_map<uint32_t, int> __glyph_widths;
+        int __char_height = 0;
+
+        size_t __cursor = 0, __anchor = 0;
+        int __preferred_x = -1;
+        std::string __composition = "";
+        bool __is_focused = false, __is_selecting = false, __is_scroll_to_cursor = false;
+        Point __scroll = Point::Zero;
+        Rectangle __input_area = Rectangle(0, 0, 0, 0);
+        double __blink_start = 0.0;
+
+        static bool __is_continuation(char c) { return ((unsigned char)c & 0xC0) == 0x80; }
+        /// @brief Decode the UTF-8 character that start at the given index, reading the bytes with the given function. An
+        /// invalid sequence is decoded as U+FFFD.
+        template <typename Reader>
+        static uint32_t __decode(const Reader& read, size_t index, size_t length) {
+            unsigned char lead = (unsigned char)read(index);
+            if (lead < 0x80) return lead;
+            if (lead < 0xC0 || lead >= 0xF8) return 0xFFFD;
+            int count = lead >= 0xF0 ? 3 : (lead >= 0xE0 ? 2 : 1);
+            uint32_t code_point = lead & (0x3F >> count);
+            for (int n = 1; n <= count; n++) {
+                if (index + n >= length || !__is_continuation(read(index + n))) return 0xFFFD;
+                code_point = (code_point << 6) | ((unsigned char)read(index + n) & 0x3F);
+            }
+            return code_point;
+        }
+
+        size_t __length() const { return __buffer.size() - (__gap_end - __gap_start); }
+        char __at(size_t index) const { return index < __gap_start ? __buffer[index] : __buffer[index + (__gap_end - __gap_start)]; }
+        std::string __substring(size_t start, size_t end) const {
+            std::string res;
+            res.reserve(end - start);
+            for (size_t i = start; i < end && i < __gap_start; i++) res.push_back(__buffer[i]);
+            for (size_t i = ENGINE_MAX(start, __gap_start); i < end; i++) res.push_back(__buffer[i + (__gap_end - __gap_start)]);
+            return res;
+        }
+
+        /// @brief Move the gap of the buffer to the given index of the text.
+        void __move_gap(size_t index) {
+            if (index < __gap_start) {
+                size_t count = __gap_start - index;
+                std::memmove(__buffer.data() + __gap_end - count, __buffer.data() + index, count);
+                __gap_start -= count; __gap_end -= count;
+            }
+            else if (index > __gap_start) {
+                size_t count = index - __gap_start;
+                std::memmove(__buffer.data() + __gap_start, __buffer.data() + __gap_end, count);
+                __gap_start += count; __gap_end += count;
+            }
+        }
+        /// @brief Make sure the gap can hold at least the given number of characters, grow the buffer geometrically.
+        void __ensure_gap(size_t count) {
+            if (__gap_end - __gap_start >= count) return;
+            size_t length = __length();
+            size_t capacity = ENGINE_MAX(__buffer.size() * 2, length + count + 64);
+            std::vector<char> buffer(capacity);
+            size_t tail = __buffer.size() - __gap_end;
+            std::memcpy(buffer.data(), __buffer.data(), __gap_start);
+            std::memcpy(buffer.data() + capacity - tail, __buffer.data() + __gap_end, tail);
+            __buffer.swap(buffer);
+            __gap_end = capacity - tail;
+        }
+
+        /// @brief Get the advance in pixels of the given code point, the width is measured once per code point and cached.
+        int __advance(uint32_t code_point) {
+            int& width = code_point < 0x80 ? __char_widths[code_point] : __glyph_widths.emplace(code_point, -1).first->second;
+            if (width < 0) {
+                Engine::Size size = __layout_font ? __layout_font->GetGlyphTextureSize(code_point) : Engine::Size::Zero;
+                width = size.Width;
+                __char_height = ENGINE_MAX(__char_height, size.Height);
+            }
+            return width + __layout_spacing;
+        }
+        int __line_height() const {
+            int height = ENGINE_MAX(__char_height, __layout_font ? __layout_font->GetLineMinimumHeight() : 0);
+            return height > 0 ? height : 1;
+        }
+        /// @brief Relayout the lines from first to last (inclusive, in the old text) after the text in them changed by the
+        /// given number of characters, the lines after are only shifted.
+        void __relayout(size_t first, size_t last, long long delta) {
+            size_t region_start = __lines[first].start;
+            size_t region_end = (size_t)((long long)(__lines[last].start + __lines[last].length()) + delta);
+
+            std::vector<__line> new_lines(1);
+            new_lines.back().start = region_start;
+            size_t length = __length();
+            for (size_t i = region_start; i < region_end; i++) {
+                char c = __at(i);
+                if (c == '\n') {
+                    new_lines.emplace_back();
+                    new_lines.back().start = i + 1;
+                    continue;
+                }
+                std::vector<int>& offsets = new_lines.back().offsets;
+                int advance = __is_continuation(c) ? 0 : __advance(__decode([this](size_t n) { return __at(n); }, i, length));
+                offsets.push_back(offsets.back() + advance);
+            }
+
+            if (delta != 0)
+                for (size_t i = last + 1; i < __lines.size(); i++)
+                    __lines[i].start = (size_t)((long long)__lines[i].start + delta);
+            size_t old_count = last - first + 1;
+            if (new_lines.size() == old_count)
+                std::move(new_lines.begin(), new_lines.end(), __lines.begin() + first);
+            else {
+                __lines.erase(__lines.begin() + first, __lines.begin() + last + 1);
+                __lines.insert(__lines.begin() + first, std::make_move_iterator(new_lines.begin()), std::make_move_iterator(new_lines.end()));
+            }
+        }
+        /// @brief Relayout the whole text if the Font (or it letter spacing) changed since the last layout.
+        void __check_layout() {
+            int spacing = Font ? Font->GetLetterSpacing() : 0;
+            if (Font == __layout_font && spacing == __layout_spacing) return;
+            __layout_font = Font;
+            __layout_spacing = spacing;
+            std::fill(__char_widths, __char_widths + 128, -1);
+            __glyph_widths.clear();
+            __char_height = 0;
+            __lines.assign(1, __line());
+            __relayout(0, 0, (long long)__length());
+        }
+
+        /// @brief Replace the text from start to end with the given text, and relayout the touched lines.
+        void __replace(size_t start, size_t end, const std::string& text) {
+            __check_layout();
+            size_t first = __line_of(start), last = __line_of(end);
+            __move_gap(end);
+            __gap_start = start;
+            __ensure_gap(text.size());
+            std::memcpy(__buffer.data() + __gap_start, text.data(), text.size());
+            __gap_start += text.size();
+            __relayout(first, last, (long long)text.size() - (long long)(end - start));
+        }
+        /// @brief Filter the given text before inserting it.
+        std::string __filter(const std::string& text) const {
+            std::string res;
+            res.reserve(text.size());
+            for (char c : text) {
+                if (c == '\r') continue;
+                if (c == '\n' && !Multiline) continue;
+                res.push_back(c);
+            }
+            return res;
+        }
+        /// @brief Replace the selection with the given text, and move the cursor after it.
+        void __input(const std::string& text) {
+            if (ReadOnly) return;
+            std::string filtered = __filter(text);
+            size_t start = GetSelectionStart(), end = GetSelectionEnd();
+            if (filtered.empty() && start == end) return;
+            __replace(start, end, filtered);
+            __set_cursor(start + filtered.size(), false);
+            RaiseTextChangedEvent();
+        }
+
+        size_t __line_of(size_t index) const {
+            auto it = std::upper_bound(__lines.begin(), __lines.end(), index, [](size_t value, const __line& line) {
+                return value < line.start;
+            });
+            return (size_t)(it - __lines.begin()) - 1;
+        }
+        size_t __next(size_t index) const {
+            size_t length = __length();
+            if (index >= length) return length;
+            index++;
+            while (index < length && __is_continuation(__at(index))) index++;
+            return index;
+        }
+        size_t __previous(size_t index) const {
+            if (index == 0) return 0;
+            index--;
+            while (index > 0 && __is_continuation(__at(index))) index--;
+            return index;
+        }
+        /// @brief Get the index of the character boundary nearest to the given x in the given line.
+        size_t __index_at(size_t line_index, int x) const {
+            const __line& line = __lines[line_index];
+            size_t k = (size_t)(std::lower_bound(line.offsets.begin(), line.offsets.end(), x) - line.offsets.begin());
+            if (k > line.length()) k = line.length();
+            if (k > 0 && x - line.offsets[k - 1] < line.offsets[k] - x) k--;
+            // A continuation byte has the offset of the next character, the line end is always a boundary (and may be the end
+            // of the buffer).
+            while (k < line.length() && __is_continuation(__at(line.start + k))) k++;
+            return line.start + k;
+        }
+        /// @brief Get the index of the character boundary nearest to the given position (relative to the Text Box).
+        size_t __index_at(const Point& position) {
+            __check_layout();
+            int y = position.Y + __scroll.Y;
+            long long line_index = y < 0 ? 0 : y / __line_height();
+            if ((size_t)line_index >= __lines.size()) line_index = (long long)__lines.size() - 1;
+            return __index_at((size_t)line_index, position.X + __scroll.X);
+        }
+        /// @brief Get the position of the given index relative to the text origin.
+        Point __position_of(size_t index) const {
+            size_t line_index = __line_of(index);
+            const __line& line = __lines[line_index];
+            return Point(line.offsets[index - line.start], (int)line_index * __line_height());
+        }
+
+        void __set_cursor(size_t index, bool extend) {
+            __cursor = ENGINE_MIN(index, __length());
+            if (!extend) __anchor = __cursor;
+            __preferred_x = -1;
+            __blink_start = Input::GetTime();
+            __is_scroll_to_cursor = true;
+        }
+        /// @brief Move the cursor up or down by the given number of lines, keeping the x it started from.
+        void __move_lines(long long count, bool extend) {
+            __check_layout();
+            int x = __preferred_x >= 0 ? __preferred_x : __position_of(__cursor).X;
+            long long line_index = (long long)__line_of(__cursor) + count;
+            line_index = ENGINE_FAST_CLAMP(0LL, (long long)__lines.size() - 1, line_index);
+            __set_cursor(__index_at((size_t)line_index, x), extend);
+            __preferred_x = x;
+        }
+        void __set_focus(bool focus) {
+            if (__is_focused == focus) return;
+            __is_focused = focus;
+            if (focus) { Keys::StartTextInput(); __input_area = Rectangle(0, 0, 0, 0); __blink_start = Input::GetTime(); }
+            else { Keys::StopTextInput(); __composition.clear(); __is_selecting = false; }
+        }
+        void __clamp_scroll() {
+            int max_y = (int)__lines.size() * __line_height() - Size.Absolute().Height;
+            __scroll.Y = ENGINE_FAST_CLAMP(0, ENGINE_MAX(0, max_y), __scroll.Y);
+            __scroll.X = ENGINE_MAX(0, __scroll.X);
+        }
+        void __scroll_to_cursor() {
+            Point cursor = __position_of(__cursor);
+            Engine::Size size = Size.Absolute();
+            int height = __line_height();
+            if (cursor.X < __scroll.X) __scroll.X = cursor.X;
+            else if (cursor.X >= __scroll.X + size.Width) __scroll.X = cursor.X - size.Width + 1;
+            if (cursor.Y < __scroll.Y) __scroll.Y = cursor.Y;
+            else if (cursor.Y + height > __scroll.Y + size.Height) __scroll.Y = cursor.Y + height - size.Height;
+            __clamp_scroll();
+        }
+        /// @brief Draw the given UTF-8 text with the layout Font by code point, starting at the given position (in the space
+        /// of the given transform).
+        void __draw_run(const Mat3x2f& transform, const std::string& text, Point position, int right) {
+            int height = __line_height();
+            for (size_t i = 0; i < text.size(); i++) {
+                if (position.X > right) break;
+                if (__is_continuation(text[i])) continue;
+                uint32_t code_point = __decode([&text](size_t n) { return text[n]; }, i, text.size());
+                Texture* c_texture = __layout_font->GetGlyphTexture(code_point);
+                if (c_texture && c_texture->IsAvaliable()) {
+                    Engine::Size c_size = c_texture->GetSize();
+                    Color curr_mod = c_texture->GetColorMod();
+                    c_texture->SetColorMod(ForegroundColor);
+                    Renderer::DrawTexture(transform, RectF((float)position.X, (float)(position.Y + (height - c_size.Height)),
+                        (float)c_size.Width, (float)c_size.Height), c_texture);
+                    c_texture->SetColorMod(curr_mod);
+                }
+                position.X += __advance(code_point);
+            }
+        }
+    protected:
+        void OnRender(Engine::RenderEventArgs* args) override {
+            GameObject::OnRender(args);
+            __check_layout();
+            if (__is_scroll_to_cursor) { __scroll_to_cursor(); __is_scroll_to_cursor = false; }
+            if (!__layout_font) return;
+
+            // Draw in the local space (where (0, 0) is the top-left corner of the text box), so the text follow the
+            // sub-pixel position, rotation and scale of the Game Object.
+            const Mat3x2f& transform = args->Transform;
+            const Rectangle& area = args->TargetArea;
+            int height = __line_height();
+            int right = area.Width;
+            Point origin = Point::Zero - __scroll;
+
+            size_t first = (size_t)(__scroll.Y / height);
+            size_t last = ENGINE_MIN(__lines.size(), (size_t)((__scroll.Y + area.Height + height - 1) / height));
+            size_t selection_start = GetSelectionStart(), selection_end = GetSelectionEnd();
+
+            for (size_t l = first; l < last; l++) {
+                const __line& line = __lines[l];
+                int y = origin.Y + (int)l * height;
+                size_t line_end = line.start + line.length();
+
+                if (selection_start < selection_end && selection_start <= line_end && selection_end >= line.start) {
+                    size_t from = ENGINE_MAX(selection_start, line.start), to = ENGINE_MIN(selection_end, line_end);
+                    int x1 = line.offsets[from - line.start], x2 = line.offsets[to - line.start];
+                    // Show the selected newline as a space.
+                    if (selection_end > line_end) x2 += __advance(' ');
+                    Renderer::SetDrawColor(SelectionColor);
+                    Renderer::FillRectangle(transform, RectF((float)(origin.X + x1), (float)y, (float)(x2 - x1), (float)height));
+                }
+
+                // Skip the characters on the left of the visible area.
+                size_t k = (size_t)(std::upper_bound(line.offsets.begin(), line.offsets.end(), __scroll.X) - line.offsets.begin());
+                k = k > 0 ? k - 1 : 0;
+                int x = origin.X + line.offsets[k];
+                std::string run;
+                // Keep the whole last character, the offset of it continuation bytes is already past it.
+                for (size_t i = k; i < line.length() && (origin.X + line.offsets[i] <= right || __is_continuation(__at(line.start + i))); i++)
+                    run.push_back(__at(line.start + i));
+                __draw_run(transform, run, Point(x, y), right);
+            }
+
+            if (!__is_focused) return;
+            Point cursor = origin + __position_of(__cursor);
+            if (!__composition.empty()) {
+                int width = 0;
+                for (size_t i = 0; i < __composition.size(); i++)
+                    if (!__is_continuation(__composition[i]))
+                        width += __advance(__decode([this](size_t n) { return __composition[n]; }, i, __composition.size()));
+                Renderer::SetDrawColor(BackgroundColor);
+                Renderer::FillRectangle(transform, RectF((float)cursor.X, (float)cursor.Y, (float)width, (float)height));
+                __draw_run(transform, __composition, cursor, right);
+                Renderer::SetDrawColor(ForegroundColor);
+                Renderer::FillRectangle(transform, RectF((float)cursor.X, (float)(cursor.Y + height - 1), (float)width, 1.0f));
+            }
+            else if (std::fmod(Input::GetTime() - __blink_start, 1.0) < 0.5) {
+                Renderer::SetDrawColor(ForegroundColor);
+                Renderer::FillRectangle(transform, RectF((float)cursor.X, (float)cursor.Y, 1.0f, (float)height));
+            }
+
+            // The text input area is on the window, so take the bounds of the transformed cursor.
+            Rectangle input_area = transform.TransformBounds(RectF((float)cursor.X, (float)cursor.Y, 1.0f, (float)height)).ToRectangle();
+            if (input_area.X != __input_area.X || input_area.Y != __input_area.Y || input_area.Height != __input_area.Height) {
+                Keys::SetTextInputArea(input_area);
+                __input_area = input_area;
+            }
+        }
+
+        void OnMouseDown(Engine::MouseButtonEventArgs* args) override {
+            if (args->Button != MouseButton::Left) return;
+            __set_focus(true);
+            bool extend = (Input::GetSnapshot().Modifiers & (uint16_t)KeyModifier::Shift) != 0;
+            __set_cursor(__index_at(args->LocalPosition), extend);
+            __is_selecting = true;
+        }
+        void OnGlobalMouseDown(Engine::MouseButtonEventArgs* args) override {
+            if (!Rectangle(Point::Zero, Size.Absolute()).IsContain(args->LocalPosition)) __set_focus(false);
+            GameObject::OnGlobalMouseDown(args);
+        }
+        void OnGlobalMouseUp(Engine::MouseButtonEventArgs* args) override {
+            __is_selecting = false;
+            GameObject::OnGlobalMouseUp(args);
+        }
+        void OnGlobalMouseMoved(Engine::MouseMotionEventArgs* args) override {
+            if (__is_selecting) __set_cursor(__index_at(args->LocalPosition), true);
+            GameObject::OnGlobalMouseMoved(args);
+        }
+        void OnMouseScroll(Engine::MouseWheelEventArgs* args) override {
+            if (!__is_focused) return;
+            __check_layout();
+            __scroll.X += args->DeltaX * __line_height();
+            __scroll.Y -= args->DeltaY * __line_height() * 3;
+            __clamp_scroll();
+        }
+
+        void OnTextInput(Engine::TextInputEventArgs* args) override {
+            if (!__is_focused) return;
+            __composition.clear();
+            __input(args->Text);
+        }
+        void OnTextEditing(Engine::TextEditingEventArgs* args) override {
+            if (!__is_focused || ReadOnly) return;
+            __composition = args->Text;
+            __blink_start = Input::GetTime();
+        }
+        void OnKeyDown(Engine::KeyEventArgs* args) override {
+            // While composing, the keys are handled by the IME.
+            if (!__is_focused || !__composition.empty()) return;
+            bool shift = ((int)args->Modifiers & (int)KeyModifier::Shift) != 0;
+            bool ctrl = ((int)args->Modifiers & (int)KeyModifier::Ctrl) != 0;
+            size_t selection_start = GetSelectionStart(), selection_end = GetSelectionEnd();
+
+            switch (args->Scancode) {
+            case Engine::Scancode::Left:
+                if (selection_start != selection_end && !shift) __set_cursor(selection_start, false);
+                else __set_cursor(__previous(__cursor), shift);
+                return;
+            case Engine::Scancode::Right:
+                if (selection_start != selection_end && !shift) __set_cursor(selection_end, false);
+                else __set_cursor(__next(__cursor), shift);
+                return;
+            case Engine::Scancode::Up: __move_lines(-1, shift); return;
+            case Engine::Scancode::Down: __move_lines(1, shift); return;
+            case Engine::Scancode::PageUp: __move_lines(-ENGINE_MAX(1, Size.Absolute().Height / __line_height()), shift); return;
+            case Engine::Scancode::PageDown: __move_lines(ENGINE_MAX(1, Size.Absolute().Height / __line_height()), shift); return;
+            case Engine::Scancode::Home:
+                __check_layout();
+                __set_cursor(ctrl ? 0 : __lines[__line_of(__cursor)].start, shift);
+                return;
+            case Engine::Scancode::End: {
+                __check_layout();
+                const __line& line = __lines[__line_of(__cursor)];
+                __set_cursor(ctrl ? __length() : line.start + line.length(), shift);
+                return;
+            }
+            case Engine::Scancode::Backspace:
+                if (ReadOnly) return;
+                if (selection_start == selection_end) __anchor = __previous(__cursor);
+                __input("");
+                return;
+            case Engine::Scancode::Delete:
+                if (ReadOnly) return;
+                if (selection_start == selection_end) __anchor = __next(__cursor);
+                __input("");
+                return;
+            case Engine::Scancode::Return:
+            case Engine::Scancode::Keypad_Enter:
+                if (Multiline) __input("\n");
+                return;
+            default: break;
+            }
+
+            if (!ctrl) return;
+            switch (args->KeyCode) {
+            case Engine::KeyCode::A: SelectAll(); return;
+            case Engine::KeyCode::C:
+                if (selection_start != selection_end) SDL_SetClipboardText(GetSelectedText().c_str());
+                return;
+            case Engine::KeyCode::X:
+                if (selection_start == selection_end) return;
+                SDL_SetClipboardText(GetSelectedText().c_str());
+                __input("");
+                return;
+            case Engine::KeyCode::V: {
+                char* clipboard = SDL_GetClipboardText();
+                if (!clipboard) return;
+                __input(clipboard);
+                SDL_free(clipboard);
+                return;
+            }
+            default: return;
+            }
+        }
+
+        /// @brief Occurred when the text of the Text Box is changed by the user.
+        virtual void OnTextChanged() {}
+    public:
+        /// @brief The Font use to render the Text Box text. Default is nullptr mean there hasn't use a font.
+        Engine::Font* Font = nullptr;
+        /// @brief The foreground color (the mod color of the text, and the color of the cursor) of the Text Box.
+        /// Default is Color::Empty.
+        Color ForegroundColor = Color::Empty;
+        /// @brief The color of the selection highlight. Default is (51, 153, 255, 128).
+        Color SelectionColor = Color(51, 153, 255, 128);
+        /// @brief If this true, the text can't be edited by the user (but still can be selected and copied). Default is false.
+        bool ReadOnly = false;
+        /// @brief If this true, the Text Box accept newline (by the Return key and from the input text). Default is false.
+        bool Multiline = false;
+
+        /// @brief The Text Changed Event, occurred when the text of the Text Box is changed by the user.
+        GameObjectEventCaller TextChangedEvent;
+
+        TextBoxGameObject() { std::fill(__char_widths, __char_widths + 128, -1); }
+        virtual ~TextBoxGameObject() {
+            if (__is_focused) Keys::StopTextInput();
+        }
+
+        ENGINE_NOT_COPYABLE(TextBoxGameObject)
+        ENGINE_NOT_ASSIGNABLE(TextBoxGameObject)
+
+        /// @brief Get the text of the Text Box.
+        /// @return The text of the Text Box.
+        std::string GetText() const { return __substring(0, __length()); }
+        /// @brief Get the length of the text of the Text Box, in bytes.
+        /// @return The length of the text.
+        size_t GetTextLength() const { return __length(); }
+        /// @brief Get the number of lines of the text of the Text Box.
+        /// @return The number of lines (at least 1).
+        size_t GetLineCount() const { return __lines.size(); }
+        /// @brief Set the text of the Text Box, the cursor is moved to the end of the text. This won't raise the Text Changed
+        /// event.
+        /// @param Text The text to set.
+        void SetText(const std::string& Text) {
+            __composition.clear();
+            __replace(0, __length(), __filter(Text));
+            __set_cursor(__length(), false);
+        }
+        /// @brief Append the given text to the end of the text of the Text Box, only the last line is relayout. If the cursor
+        /// is at the end of the text, it's moved to the new end. This won't raise the Text Changed event.
+        /// @param Text The text to append.
+        void AppendText(const std::string& Text) {
+            size_t length = __length();
+            bool follow = __cursor == length && __anchor == length;
+            __replace(length, length, __filter(Text));
+            if (follow) __set_cursor(__length(), false);
+        }
+        /// @brief Insert the given text at the given index of the text of the Text Box. This won't raise the Text Changed event.
+        /// @param Index The index to insert at, clamped to the length of the text.
+        /// @param Text The text to insert.
+        void InsertText(size_t Index, const std::string& Text) {
+            Index = ENGINE_MIN(Index, __length());
+            std::string filtered = __filter(Text);
+            __replace(Index, Index, filtered);
+            if (__cursor >= Index) __cursor += filtered.size();
+            if (__anchor >= Index) __anchor += filtered.size();
+        }
+        /// @brief Remove the text from the given start index to the given end index. This won't raise the Text Changed event.
+        /// @param Start The start index (inclusive).
+        /// @param End The end index (exclusive), clamped to the length of the text.
+        void RemoveText(size_t Start, size_t End) {
+            End = ENGINE_MIN(End, __length());
+            if (Start >= End) return;
+            __replace(Start, End, "");
+            size_t count = End - Start;
+            __cursor = __cursor >= End ? __cursor - count : ENGINE_MIN(__cursor, Start);
+            __anchor = __anchor >= End ? __anchor - count : ENGINE_MIN(__anchor, Start);
+        }
+
+        /// @brief Get the index of the cursor in the text.
+        /// @return The index of the cursor.
+        size_t GetCursor() const { return __cursor; }
+        /// @brief Set the index of the cursor in the text, this will clear the selection.
+        /// @param Index The index to set, clamped to the length of the text.
+        void SetCursor(size_t Index) { __set_cursor(Index, false); }
+        /// @brief Select the text from the given start index to the given end index, the cursor is placed at the end index.
+        /// @param Start The start index of the selection.
+        /// @param End The end index of the selection.
+        void Select(size_t Start, size_t End) {
+            __anchor = ENGINE_MIN(Start, __length());
+            __set_cursor(End, true);
+        }
+        /// @brief Select all text of the Text Box.
+        void SelectAll() { Select(0, __length()); }
+        /// @brief Get the start index of the selection.
+        /// @return The start index of the selection (equal to the end index if there's no selection).
+        size_t GetSelectionStart() const { return ENGINE_MIN(__cursor, __anchor); }
+        /// @brief Get the end index of the selection.
+        /// @return The end index of the selection (equal to the start index if there's no selection).
+        size_t GetSelectionEnd() const { return ENGINE_MAX(__cursor, __anchor); }
+        /// @brief Get the selected text of the Text Box.
+        /// @return The selected text, or an empty string if there's no selection.
+        std::string GetSelectedText() const { return __substring(GetSelectionStart(), GetSelectionEnd()); }
+        /// @brief Scroll the Text Box to make the cursor visible on the next render.
+        void ScrollToCursor() { __is_scroll_to_cursor = true; }
+
+        /// @brief Check if the Text Box is focused (accepting the text input).
+        /// @return true if the Text Box is focused, false otherwise.
+        bool IsFocused() const { return __is_focused; }
+        /// @brief Focus the Text Box, this will start the text input.
+        void Focus() { __set_focus(true); }
+        /// @brief Unfocus the Text Box, this will stop the text input.
+        void Unfocus() { __set_focus(false); }
+
+        /// @brief Raise the Text Changed event to the Text Box.
+        void RaiseTextChangedEvent() { OnTextChanged(); TextChangedEvent.Call(this); }
+    };
 }
 
 #endif // __ENGINE_UIGAMEOBJECT_H__
\ No newline at end of file
@@ -56,6 +56,10 @@ namespace Engine {
         static GlobalEventCaller<KeyEventArgs> KeyDownEvent;
         /// @brief The Key Up Event, occurred when a key is being released while the Window has keyboard input focus.
         static GlobalEventCaller<KeyEventArgs> KeyUpEvent;
+        /// @brief The Text Input Event, occurred when a text is committed while accepting text input (Keys::StartTextInput()).
+        static GlobalEventCaller<TextInputEventArgs> TextInputEvent;
+        /// @brief The Text Editing Event, occurred when the IME composition is changed while accepting text input.
+        static GlobalEventCaller<TextEditingEventArgs> TextEditingEvent;
         /// @brief The Mouse Down Event, occurred when a mouse button is being pressed while the Window has mouse input focus.
         static GlobalEventCaller<MouseButtonEventArgs> MouseDownEvent;
         /// @brief The Mouse Up Event, occurred when a mouse button is being released while the Window has mouse input focus.
@@ -275,6 +279,10 @@ Engine::GlobalEventCaller<Engine::SizeEventArgs> Engine::Window::ResizedEvent =
 Engine::GlobalEventCaller<Engine::KeyEventArgs> Engine::Window::KeyDownEvent = Engine::GlobalEventCaller<Engine::KeyEventArgs>();
 /// @brief The Key Up Event, occurred when a key is being released while the Window has keyboard input focus.
 Engine::GlobalEventCaller<Engine::KeyEventArgs> Engine::Window::KeyUpEvent = Engine::GlobalEventCaller<Engine::KeyEventArgs>();
+/// @brief The Text Input Event, occurred when a text is committed while accepting text input (Keys::StartTextInput()).
+Engine::GlobalEventCaller<Engine::TextInputEventArgs> Engine::Window::TextInputEvent = Engine::GlobalEventCaller<Engine::TextInputEventArgs>();
+/// @brief The Text Editing Event, occurred when the IME composition is changed while accepting text input.
+Engine::GlobalEventCaller<Engine::TextEditingEventArgs> Engine::Window::TextEditingEvent = Engine::GlobalEventCaller<Engine::TextEditingEventArgs>();
 /// @brief The Mouse Down Event, occurred when a mouse button is being pressed while the Window has mouse input focus.
 Engine::GlobalEventCaller<Engine::MouseButtonEventArgs> Engine::Window::MouseDownEvent = Engine::GlobalEventCaller<Engine::MouseButtonEventArgs>();
 /// @brief The Mouse Up Event, occurred when a mouse button is being released while the Window has mouse input focus.